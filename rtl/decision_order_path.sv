@@ -0,0 +1,112 @@
+`timescale 1ns / 1ps
+
+// =============================================================================
+// Decision → Order Path — pipelined engine + order message generator
+// =============================================================================
+//
+// market_input/start in, 64-bit order message stream out.  Lets the harness
+// measure decision-to-wire latency (start → last beat) instead of only the
+// classifier's share:
+//
+//   start ──(MAX_DEPTH + 2)──▶ action_valid ──(+1)──▶ beat 0 ──(+1)──▶ beat 1
+//
+// i.e. MAX_DEPTH + 4 cycles from start to m_tlast with an idle, ready
+// output.  action/action_valid/payload are brought out for observability.
+// =============================================================================
+
+module decision_order_path #(
+    parameter MAX_NODES  = 64,
+    parameter MAX_DEPTH  = 6,
+    parameter ADDR_WIDTH = $clog2(MAX_NODES),
+    parameter TREE_INIT_FILE = "",
+    parameter PAYLOAD_ENTRIES = 64,
+    parameter PAYLOAD_ADDR_WIDTH = $clog2(PAYLOAD_ENTRIES),
+    parameter PAYLOAD_INIT_FILE = "",
+    parameter FIFO_DEPTH = 8
+)(
+    input  logic         clk,
+    input  logic         rst,
+    input  logic  [7:0]  market_input,
+    input  logic         start,
+
+    // Instrument context
+    input  logic [15:0]  instrument_id,
+    input  logic [31:0]  ref_price,
+
+    // Order message stream
+    output logic [63:0]  m_tdata,
+    output logic         m_tvalid,
+    output logic         m_tlast,
+    input  logic         m_tready,
+
+    // Observability / statistics
+    output logic  [1:0]  action,
+    output logic         action_valid,
+    output logic [31:0]  payload,
+    output logic [31:0]  msg_count,
+    output logic [31:0]  dropped,
+
+    // Software write interface (tree + order templates)
+    input  logic                          sw_we,
+    input  logic [ADDR_WIDTH-1:0]         sw_addr,
+    input  logic                          sw_data_is_leaf,
+    input  logic [7:0]                    sw_data_threshold,
+    input  logic                          sw_data_less_than,
+    input  logic [ADDR_WIDTH-1:0]         sw_data_left_idx,
+    input  logic [ADDR_WIDTH-1:0]         sw_data_right_idx,
+    input  logic [1:0]                    sw_data_action,
+    input  logic                          sw_payload_we,
+    input  logic [PAYLOAD_ADDR_WIDTH-1:0] sw_payload_addr,
+    input  logic [31:0]                   sw_payload_data
+);
+
+decision_tree_pipelined #(
+    .MAX_NODES          (MAX_NODES),
+    .MAX_DEPTH          (MAX_DEPTH),
+    .ADDR_WIDTH         (ADDR_WIDTH),
+    .TREE_INIT_FILE     (TREE_INIT_FILE),
+    .PAYLOAD_ENTRIES    (PAYLOAD_ENTRIES),
+    .PAYLOAD_ADDR_WIDTH (PAYLOAD_ADDR_WIDTH),
+    .PAYLOAD_WIDTH      (32),
+    .PAYLOAD_INIT_FILE  (PAYLOAD_INIT_FILE)
+) u_engine (
+    .clk              (clk),
+    .rst              (rst),
+    .market_input     (market_input),
+    .start            (start),
+    .action           (action),
+    .action_valid     (action_valid),
+    .payload          (payload),
+    .sw_we            (sw_we),
+    .sw_addr          (sw_addr),
+    .sw_data_is_leaf  (sw_data_is_leaf),
+    .sw_data_threshold(sw_data_threshold),
+    .sw_data_less_than(sw_data_less_than),
+    .sw_data_left_idx (sw_data_left_idx),
+    .sw_data_right_idx(sw_data_right_idx),
+    .sw_data_action   (sw_data_action),
+    .sw_payload_we    (sw_payload_we),
+    .sw_payload_addr  (sw_payload_addr),
+    .sw_payload_data  (sw_payload_data)
+);
+
+order_msg_gen #(
+    .FIFO_DEPTH    (FIFO_DEPTH),
+    .PAYLOAD_WIDTH (32)
+) u_msg (
+    .clk           (clk),
+    .rst           (rst),
+    .action        (action),
+    .action_valid  (action_valid),
+    .payload       (payload),
+    .instrument_id (instrument_id),
+    .ref_price     (ref_price),
+    .m_tdata       (m_tdata),
+    .m_tvalid      (m_tvalid),
+    .m_tlast       (m_tlast),
+    .m_tready      (m_tready),
+    .msg_count     (msg_count),
+    .dropped       (dropped)
+);
+
+endmodule
@@ -29,6 +29,21 @@
 //       Wastes area and dynamic power; does not affect latency.
 //     - Throughput is limited: only one traversal can be in flight at a time.
 //
+//   Optional inline leaves (INLINE_LEAVES=1):
+//     Child pointers grow by one bit.  A pointer with the top bit set is a
+//     leaf carrying its action in bits [1:0], so the walk terminates on the
+//     pointer itself — no leaf node is stored and the tree_mem read drops
+//     out of the leaf-detect path.  Trees are converted on the loader side
+//     (inline_leaves() in sim/tree_model.h).  Latency stays depth cycles.
+//
+//   Hop watchdog (MAX_DEPTH):
+//     A malformed tree can point back into itself, and the walk would then
+//     follow path[] forever.  A hop counter aborts any walk that has not
+//     reached a leaf after MAX_DEPTH hops: it returns action NONE with
+//     action_valid and action_error, and bumps error_count.  Worst-case
+//     latency is therefore MAX_DEPTH cycles whatever image is loaded.  The
+//     default (MAX_NODES) never trips on an acyclic tree.
+//
 //   Bugs fixed (vs original):
 //     - path[] is now only captured on start, not every cycle. Prevents
 //       mid-traversal corruption if market_input changes.
@@ -41,7 +56,12 @@
 
 module decision_tree #(
     parameter MAX_NODES = 64,
-    parameter ADDR_WIDTH = $clog2(MAX_NODES)
+    parameter ADDR_WIDTH = $clog2(MAX_NODES),
+    parameter TREE_INIT_FILE = "",           // optional $readmemh image (see tools/tree2mem.cpp)
+    parameter INLINE_LEAVES = 0,             // 1 = child pointers may carry a leaf action
+    parameter CHILD_WIDTH = ADDR_WIDTH + INLINE_LEAVES,
+    parameter MAX_DEPTH = MAX_NODES,         // hop limit; deeper walks abort with action_error
+    parameter ERROR_COUNT_WIDTH = 16         // saturating aborted-walk counter
 )(
     input  logic         clk,
     input  logic         rst,
@@ -49,6 +69,8 @@ module decision_tree #(
     input  logic         start,         // pulse high for 1 cycle to begin traversal
     output logic  [1:0]  action,        // 00=NONE, 01=BUY, 10=SELL, 11=CANCEL
     output logic         action_valid,  // high for 1 cycle when action is ready
+    output logic         action_error,  // with action_valid: walk aborted after MAX_DEPTH hops
+    output logic [ERROR_COUNT_WIDTH-1:0] error_count,  // aborted walks since reset
 
     // Interface for software to write tree nodes one at a time.
     // Assert sw_we for one cycle with address and field values to program a node.
@@ -57,8 +79,8 @@ module decision_tree #(
     input  logic                  sw_data_is_leaf,
     input  logic [7:0]            sw_data_threshold,
     input  logic                  sw_data_less_than,
-    input  logic [ADDR_WIDTH-1:0] sw_data_left_idx,
-    input  logic [ADDR_WIDTH-1:0] sw_data_right_idx,
+    input  logic [CHILD_WIDTH-1:0] sw_data_left_idx,
+    input  logic [CHILD_WIDTH-1:0] sw_data_right_idx,
     input  logic [1:0]            sw_data_action
 );
 
@@ -70,13 +92,15 @@ module decision_tree #(
 //   = 24 bits per node
 // Internal nodes use threshold/less_than/left_idx/right_idx.
 // Leaf nodes only use is_leaf and action; other fields are don't-cares.
+// With INLINE_LEAVES=1 each child index is 7 bits: {inline_leaf, index}, and
+// an inline leaf carries its action in the low 2 bits (26 bits per node).
 typedef struct packed {
-    logic                  is_leaf;
-    logic [7:0]            threshold;
-    logic                  less_than;
-    logic [ADDR_WIDTH-1:0] left_idx;
-    logic [ADDR_WIDTH-1:0] right_idx;
-    logic [1:0]            action;
+    logic                   is_leaf;
+    logic [7:0]             threshold;
+    logic                   less_than;
+    logic [CHILD_WIDTH-1:0] left_idx;
+    logic [CHILD_WIDTH-1:0] right_idx;
+    logic [1:0]             action;
 } node_t;
 
 // -------------------------------------------------------------------------
@@ -93,19 +117,28 @@ logic cond;                                         // threshold comparison resu
 node_t node;                                        // current node being evaluated (combinational)
 node_t current_node;                                // combinational read of tree_mem at path_index
 logic path_valid = 0;                               // 1 = FSM is actively traversing
-logic [ADDR_WIDTH-1:0] path [0:MAX_NODES-1];        // registered "next pointer" table (frozen after start):
-                                                    //   path[j] = child index to visit from node j
-logic [ADDR_WIDTH-1:0] path_index;                  // = path[current_path_index], the next node to visit
+logic [CHILD_WIDTH-1:0] path [0:MAX_NODES-1];       // registered "next pointer" table (frozen after start):
+                                                    //   path[j] = child pointer to follow from node j
+logic [CHILD_WIDTH-1:0] path_index;                 // = path[current_path_index], the next node to visit
+logic                  path_is_leaf;                // path_index is an inline leaf (INLINE_LEAVES=1 only)
 logic [ADDR_WIDTH-1:0] current_path_index = 0;      // the node whose "next pointer" we are following
-logic [ADDR_WIDTH-1:0] computed_path [0:MAX_NODES-1]; // combinational version of path[] (before register)
+logic [CHILD_WIDTH-1:0] computed_path [0:MAX_NODES-1]; // combinational version of path[] (before register)
+localparam HOP_WIDTH = $clog2(MAX_DEPTH + 1);
+logic [HOP_WIDTH-1:0]  hop_count;                   // hops made by the current walk (watchdog)
 
-// Simulation-only: zero-initialise all nodes.
+// Zero-initialise all nodes, then optionally preload a model image.
+// With TREE_INIT_FILE set, the image is baked into the bitstream (LUTRAM
+// INIT) / elaborated into the model, so the tree is live on the first cycle
+// after reset without a sw_we programming sequence.  sw_we still overwrites
+// nodes at runtime.
 // NOTE: $dumpfile/$dumpvars removed — they conflict with the C++ Verilator
 // trace (VerilatedVcdC). VCD dumping is controlled from the C++ test harness.
 initial begin
     for (i = 0; i < MAX_NODES; i++) begin
         tree_mem[i] = '0;
     end
+    if (TREE_INIT_FILE != "")
+        $readmemh(TREE_INIT_FILE, tree_mem);
 end
 
 // -------------------------------------------------------------------------
@@ -133,6 +166,9 @@ end
 // i.e., "from node current_path_index, go to node path_index next."
 assign path_index = path[current_path_index];
 
+// Inline leaf: the pointer itself says "leaf" — no tree_mem read needed.
+assign path_is_leaf = (INLINE_LEAVES != 0) && path_index[CHILD_WIDTH-1];
+
 // -------------------------------------------------------------------------
 // Phase 1 — Parallel pre-computation (combinational)
 // -------------------------------------------------------------------------
@@ -178,7 +214,7 @@ end
 //   // In the FSM: node_reg <= tree_mem[path_index];
 //   //             if (node_reg.is_leaf) ...
 //
-assign current_node = tree_mem[path_index];
+assign current_node = tree_mem[path_index[ADDR_WIDTH-1:0]];
 
 // -------------------------------------------------------------------------
 // Phase 2 — Traversal FSM (sequential, one hop per clock cycle)
@@ -203,38 +239,68 @@ assign current_node = tree_mem[path_index];
 //   Only one traversal can be active at a time.  A new start pulse must
 //   wait until the current traversal finishes (action_valid goes high).
 //
+// Watchdog:
+//   hop_count counts the non-leaf hops.  The pointer checked on the cycle
+//   with hop_count = MAX_DEPTH - 1 is the walk's last chance: if it is not
+//   a leaf, the walk ends there with action_error, in the same cycle a
+//   leaf at depth MAX_DEPTH would have been reported.
+//
 always_ff @(posedge clk or posedge rst) begin
     if (rst) begin
         action <= 0;
         action_valid <= 0;
+        action_error <= 0;
+        error_count <= 0;
         path_valid <= 0;
         current_path_index <= 0;
+        hop_count <= 0;
     end 
     else begin
         if (start) begin
             // Arm the FSM: begin traversal from root (index 0)
             path_valid <= 1;
             action_valid <= 0;
+            action_error <= 0;
             current_path_index <= 0;
+            hop_count <= 0;
         end 
         else if (path_valid) begin
             // Check if the node at the current path pointer is a leaf.
             // current_node is a combinational read — no register delay.
-            if (current_node.is_leaf) begin
+            if (path_is_leaf) begin
+                // Inline leaf pointer — action rides in the pointer itself
+                path_valid <= 0;
+                action_valid <= 1;
+                action <= path_index[1:0];
+            end else if (current_node.is_leaf) begin
                 path_valid <= 0;
                 action_valid <= 1;
                 action <= current_node.action;
+            end else if (hop_count == HOP_WIDTH'(MAX_DEPTH - 1)) begin
+                // Hop limit reached without a leaf — abort with an error
+                path_valid <= 0;
+                action_valid <= 1;
+                action_error <= 1;
+                action <= 2'b00;
+                if (error_count != '1)
+                    error_count <= error_count + 1'b1;
             end else begin
                 // Not a leaf — advance to the next node in the chain.
                 // This is the linked-list step: current = next[current]
-                current_path_index <= path_index;
+                current_path_index <= path_index[ADDR_WIDTH-1:0];
+                hop_count <= hop_count + 1'b1;
             end
         end 
         else begin
             // IDLE: clear action_valid after one cycle
             action_valid <= 0;
+            action_error <= 0;
         end
     end
 end
 
+`ifdef FORMAL
+`include "decision_tree_props.svh"
+`endif
+
 endmodule
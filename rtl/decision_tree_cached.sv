@@ -0,0 +1,206 @@
+`timescale 1ns / 1ps
+
+// =============================================================================
+// Cached Decision Tree — result cache in front of the pipelined engine
+// =============================================================================
+//
+// In a quiet market the same market_input repeats constantly, yet every query
+// pays the full MAX_DEPTH + 2 cycles in decision_tree_pipelined.  This wrapper
+// looks each query up in a small CAM (result_cache.sv) first:
+//
+//   hit   → the cached action is registered and returned the next cycle
+//           (latency 1).
+//   miss  → the query goes down the pipeline (latency MAX_DEPTH + 2) and its
+//           action is written into the cache when it comes out.
+//
+// Results therefore come back OUT OF ORDER: each one is tagged with the input
+// it answers (result_input) and whether it was a hit (result_hit).
+//
+// Output collision: a hit issued in the same cycle that an earlier miss
+// leaves the pipeline would need the output port twice.  The wrapper tracks
+// in-flight misses in a shift register and sends such a hit down the pipeline
+// as a miss instead, so start is never back-pressured.
+//
+// Coherence: any sw_we write clears the cache, and misses already in flight
+// when the write happens are not allowed to refill it (their result may come
+// from the old tree).  The cache clears at the write's clock edge, so a query
+// started in the write cycle is never served from it: it goes down the
+// pipeline, whose first node read comes after the write, and may refill.
+//
+// cache_en=0 bypasses the cache (every query is a miss) for A/B comparison.
+// hit_count / miss_count count issued queries; latency_sum accumulates the
+// latency of every returned result, so mean latency = latency_sum / results.
+// =============================================================================
+
+module decision_tree_cached #(
+    parameter MAX_NODES  = 64,
+    parameter MAX_DEPTH  = 6,
+    parameter ADDR_WIDTH = $clog2(MAX_NODES),
+    parameter TREE_INIT_FILE = "",
+    parameter INLINE_LEAVES = 0,
+    parameter CHILD_WIDTH = ADDR_WIDTH + INLINE_LEAVES,
+    parameter CACHE_ENTRIES = 8
+)(
+    input  logic         clk,
+    input  logic         rst,
+    input  logic  [7:0]  market_input,
+    input  logic         start,
+    input  logic         cache_en,
+    output logic  [1:0]  action,
+    output logic         action_valid,
+    output logic  [7:0]  result_input,  // query this result answers
+    output logic         result_hit,    // 1 = served from the cache
+
+    // Statistics
+    output logic [31:0]  hit_count,
+    output logic [31:0]  miss_count,
+    output logic [31:0]  latency_sum,
+
+    // Software write interface (same as the pipelined engine)
+    input  logic                   sw_we,
+    input  logic [ADDR_WIDTH-1:0]  sw_addr,
+    input  logic                   sw_data_is_leaf,
+    input  logic [7:0]             sw_data_threshold,
+    input  logic                   sw_data_less_than,
+    input  logic [CHILD_WIDTH-1:0] sw_data_left_idx,
+    input  logic [CHILD_WIDTH-1:0] sw_data_right_idx,
+    input  logic [1:0]             sw_data_action
+);
+
+localparam LATENCY   = MAX_DEPTH + 2;            // pipelined engine, start → valid
+localparam KEY_WIDTH = 8;                        // cache key = market_input
+
+// -------------------------------------------------------------------------
+// Cache lookup and hit/miss decision
+// -------------------------------------------------------------------------
+logic       lookup_hit;
+logic [1:0] lookup_data;
+
+logic [LATENCY-1:0] miss_busy;                   // bit j: miss issued j+1 cycles ago
+logic [LATENCY-1:0] miss_fill_ok;                // ... and no sw_we since
+logic [KEY_WIDTH-1:0] miss_key [0:LATENCY-1];
+
+logic collide;                                   // a miss leaves the pipeline next cycle
+logic use_hit;
+logic miss_start;
+
+assign collide    = miss_busy[LATENCY-2];
+assign use_hit    = start && cache_en && lookup_hit && !collide && !sw_we;
+assign miss_start = start && !use_hit;
+
+// Miss completing now: fill the cache with its action
+logic       pipe_action_valid;
+logic [1:0] pipe_action;
+logic       fill_en;
+
+assign fill_en = pipe_action_valid && miss_fill_ok[LATENCY-1];
+
+result_cache #(
+    .ENTRIES    (CACHE_ENTRIES),
+    .KEY_WIDTH  (KEY_WIDTH),
+    .DATA_WIDTH (2)
+) u_cache (
+    .clk         (clk),
+    .rst         (rst),
+    .lookup_key  (market_input),
+    .lookup_hit  (lookup_hit),
+    .lookup_data (lookup_data),
+    .fill_en     (fill_en),
+    .fill_key    (miss_key[LATENCY-1]),
+    .fill_data   (pipe_action),
+    .invalidate  (sw_we)
+);
+
+// -------------------------------------------------------------------------
+// Engine — only misses are started
+// -------------------------------------------------------------------------
+decision_tree_pipelined #(
+    .MAX_NODES      (MAX_NODES),
+    .MAX_DEPTH      (MAX_DEPTH),
+    .ADDR_WIDTH     (ADDR_WIDTH),
+    .TREE_INIT_FILE (TREE_INIT_FILE),
+    .INLINE_LEAVES  (INLINE_LEAVES),
+    .CHILD_WIDTH    (CHILD_WIDTH)
+) u_engine (
+    .clk              (clk),
+    .rst              (rst),
+    .market_input     (market_input),
+    .start            (miss_start),
+    .action           (pipe_action),
+    .action_valid     (pipe_action_valid),
+    .sw_we            (sw_we),
+    .sw_addr          (sw_addr),
+    .sw_data_is_leaf  (sw_data_is_leaf),
+    .sw_data_threshold(sw_data_threshold),
+    .sw_data_less_than(sw_data_less_than),
+    .sw_data_left_idx (sw_data_left_idx),
+    .sw_data_right_idx(sw_data_right_idx),
+    .sw_data_action   (sw_data_action),
+    .payload          (),                    // order templates unused here
+    .sw_payload_we    (1'b0),
+    .sw_payload_addr  ('0),
+    .sw_payload_data  ('0)
+);
+
+// -------------------------------------------------------------------------
+// In-flight miss tracking (key rides alongside the engine pipeline)
+// -------------------------------------------------------------------------
+always_ff @(posedge clk or posedge rst) begin
+    if (rst) begin
+        miss_busy    <= '0;
+        miss_fill_ok <= '0;
+        for (int k = 0; k < LATENCY; k++)
+            miss_key[k] <= '0;
+    end else begin
+        miss_busy    <= {miss_busy[LATENCY-2:0], miss_start};
+        miss_fill_ok <= sw_we ? LATENCY'(miss_start) : {miss_fill_ok[LATENCY-2:0], miss_start};
+        miss_key[0]  <= market_input;
+        for (int k = 1; k < LATENCY; k++)
+            miss_key[k] <= miss_key[k-1];
+    end
+end
+
+// -------------------------------------------------------------------------
+// Hit path: one register stage
+// -------------------------------------------------------------------------
+logic                 hit_valid;
+logic [1:0]           hit_action;
+logic [KEY_WIDTH-1:0] hit_key;
+
+always_ff @(posedge clk or posedge rst) begin
+    if (rst) begin
+        hit_valid  <= 1'b0;
+        hit_action <= '0;
+        hit_key    <= '0;
+    end else begin
+        hit_valid  <= use_hit;
+        hit_action <= lookup_data;
+        hit_key    <= market_input;
+    end
+end
+
+// -------------------------------------------------------------------------
+// Output merge — collide guarantees at most one source per cycle
+// -------------------------------------------------------------------------
+assign action_valid = hit_valid | pipe_action_valid;
+assign action       = hit_valid ? hit_action : pipe_action;
+assign result_input = hit_valid ? hit_key    : miss_key[LATENCY-1];
+assign result_hit   = hit_valid;
+
+// -------------------------------------------------------------------------
+// Statistics
+// -------------------------------------------------------------------------
+always_ff @(posedge clk or posedge rst) begin
+    if (rst) begin
+        hit_count   <= '0;
+        miss_count  <= '0;
+        latency_sum <= '0;
+    end else begin
+        if (use_hit)    hit_count  <= hit_count + 1;
+        if (miss_start) miss_count <= miss_count + 1;
+        if (action_valid)
+            latency_sum <= latency_sum + (hit_valid ? 32'd1 : 32'(LATENCY));
+    end
+end
+
+endmodule
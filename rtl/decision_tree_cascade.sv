@@ -0,0 +1,227 @@
+`timescale 1ns / 1ps
+
+// =============================================================================
+// Cascaded Decision Tree — a shallow gate tree in front of the deep pipeline
+// =============================================================================
+//
+// Most ticks classify as NONE, and a shallow tree can say so with
+// confidence.  Every query first walks a small FSM engine (decision_tree.sv,
+// GATE_NODES nodes):
+//
+//   gate leaf NONE/BUY/SELL → confident, returned directly (short path)
+//   gate leaf ESCALATE (2'b11) → query is started in the deep pipelined
+//                                engine, whose answer is returned instead
+//
+// Short-path queries never touch the deep pipeline, which idles (no stage
+// toggles) while the market is quiet.  Because the gate spends one leaf
+// code on ESCALATE, it cannot return CANCEL itself.  The deep tree can.
+//
+// Latency (cycles from accepted start to action_valid):
+//   short path:  gate depth + 1 (one more if it collides with a deep result)
+//   deep path:   gate depth + 1 + MAX_DEPTH + 2
+// Both are bounded by the tree depths, independent of the traffic.
+//
+// Results come back OUT OF ORDER between the two paths (in order within
+// each), tagged with result_input and action_deep.  When a short-path and
+// a deep result finish in the same cycle, the deep result goes first and the
+// short one waits one cycle in a skid register.  Gate results are at least
+// two cycles apart, so one skid entry is enough.
+//
+// A gate walk aborted by its hop watchdog (malformed gate image) comes back
+// as a short-path NONE.
+//
+// Flow control: ready follows the gate FSM (one query per gate depth + 1
+// cycles).  A start while ready is low is ignored.
+//
+// Software writes: sw_sel=0 programs the deep tree, sw_sel=1 the gate.
+// =============================================================================
+
+module decision_tree_cascade #(
+    parameter MAX_NODES  = 64,                   // deep tree
+    parameter MAX_DEPTH  = 6,
+    parameter ADDR_WIDTH = $clog2(MAX_NODES),
+    parameter TREE_INIT_FILE = "",               // deep tree image
+    parameter GATE_NODES = 16,                   // gate tree
+    parameter GATE_ADDR_WIDTH = $clog2(GATE_NODES),
+    parameter GATE_INIT_FILE = ""                // gate tree image
+)(
+    input  logic         clk,
+    input  logic         rst,
+    input  logic  [7:0]  market_input,
+    input  logic         start,         // accepted only while ready is high
+    output logic         ready,
+    output logic  [1:0]  action,
+    output logic         action_valid,
+    output logic  [7:0]  result_input,  // query this result answers
+    output logic         action_deep,   // 1 = answered by the deep tree
+
+    // Statistics
+    output logic [31:0]  gate_count,    // queries answered by the gate
+    output logic [31:0]  deep_count,    // queries escalated to the deep tree
+
+    // Software write interface (sw_sel: 0 = deep tree, 1 = gate tree)
+    input  logic                  sw_we,
+    input  logic                  sw_sel,
+    input  logic [ADDR_WIDTH-1:0] sw_addr,
+    input  logic                  sw_data_is_leaf,
+    input  logic [7:0]            sw_data_threshold,
+    input  logic                  sw_data_less_than,
+    input  logic [ADDR_WIDTH-1:0] sw_data_left_idx,
+    input  logic [ADDR_WIDTH-1:0] sw_data_right_idx,
+    input  logic [1:0]            sw_data_action
+);
+
+localparam logic [1:0] ESCALATE = 2'b11;
+localparam DEEP_LATENCY = MAX_DEPTH + 2;
+
+// -------------------------------------------------------------------------
+// Gate: small FSM engine, one query at a time
+// -------------------------------------------------------------------------
+logic       gate_busy;
+logic [7:0] gate_input;                          // query the gate is working on
+logic       gate_valid;
+logic [1:0] gate_action;
+logic       accept;
+
+assign ready  = !gate_busy || gate_valid;
+assign accept = start && ready;
+
+decision_tree #(
+    .MAX_NODES      (GATE_NODES),
+    .ADDR_WIDTH     (GATE_ADDR_WIDTH),
+    .TREE_INIT_FILE (GATE_INIT_FILE)
+) u_gate (
+    .clk              (clk),
+    .rst              (rst),
+    .market_input     (market_input),
+    .start            (accept),
+    .action           (gate_action),
+    .action_valid     (gate_valid),
+    .action_error     (),
+    .error_count      (),
+    .sw_we            (sw_we && sw_sel),
+    .sw_addr          (sw_addr[GATE_ADDR_WIDTH-1:0]),
+    .sw_data_is_leaf  (sw_data_is_leaf),
+    .sw_data_threshold(sw_data_threshold),
+    .sw_data_less_than(sw_data_less_than),
+    .sw_data_left_idx (sw_data_left_idx[GATE_ADDR_WIDTH-1:0]),
+    .sw_data_right_idx(sw_data_right_idx[GATE_ADDR_WIDTH-1:0]),
+    .sw_data_action   (sw_data_action)
+);
+
+always_ff @(posedge clk or posedge rst) begin
+    if (rst) begin
+        gate_busy  <= 1'b0;
+        gate_input <= '0;
+    end else begin
+        if (accept) begin
+            gate_busy  <= 1'b1;
+            gate_input <= market_input;
+        end else if (gate_valid) begin
+            gate_busy  <= 1'b0;
+        end
+    end
+end
+
+logic gate_confident;
+logic escalate;
+
+assign gate_confident = gate_valid && gate_action != ESCALATE;
+assign escalate       = gate_valid && gate_action == ESCALATE;
+
+// -------------------------------------------------------------------------
+// Deep tree: pipelined engine, started only on escalation
+// -------------------------------------------------------------------------
+logic       deep_valid;
+logic [1:0] deep_action;
+logic [7:0] deep_key [0:DEEP_LATENCY-1];         // input rides alongside the pipeline
+
+decision_tree_pipelined #(
+    .MAX_NODES      (MAX_NODES),
+    .MAX_DEPTH      (MAX_DEPTH),
+    .ADDR_WIDTH     (ADDR_WIDTH),
+    .TREE_INIT_FILE (TREE_INIT_FILE)
+) u_deep (
+    .clk              (clk),
+    .rst              (rst),
+    .market_input     (gate_input),
+    .start            (escalate),
+    .action           (deep_action),
+    .action_valid     (deep_valid),
+    .sw_we            (sw_we && !sw_sel),
+    .sw_addr          (sw_addr),
+    .sw_data_is_leaf  (sw_data_is_leaf),
+    .sw_data_threshold(sw_data_threshold),
+    .sw_data_less_than(sw_data_less_than),
+    .sw_data_left_idx (sw_data_left_idx),
+    .sw_data_right_idx(sw_data_right_idx),
+    .sw_data_action   (sw_data_action),
+    .payload          (),                    // order templates unused here
+    .sw_payload_we    (1'b0),
+    .sw_payload_addr  ('0),
+    .sw_payload_data  ('0)
+);
+
+always_ff @(posedge clk or posedge rst) begin
+    if (rst) begin
+        for (int k = 0; k < DEEP_LATENCY; k++)
+            deep_key[k] <= '0;
+    end else begin
+        deep_key[0] <= gate_input;
+        for (int k = 1; k < DEEP_LATENCY; k++)
+            deep_key[k] <= deep_key[k-1];
+    end
+end
+
+// -------------------------------------------------------------------------
+// Output merge: deep result > parked short result > new short result
+// -------------------------------------------------------------------------
+logic       skid_valid;
+logic [1:0] skid_action;
+logic [7:0] skid_input;
+
+always_comb begin
+    action_valid = deep_valid | skid_valid | gate_confident;
+    action_deep  = deep_valid;
+    if (deep_valid) begin
+        action       = deep_action;
+        result_input = deep_key[DEEP_LATENCY-1];
+    end else if (skid_valid) begin
+        action       = skid_action;
+        result_input = skid_input;
+    end else begin
+        action       = gate_action;
+        result_input = gate_input;
+    end
+end
+
+always_ff @(posedge clk or posedge rst) begin
+    if (rst) begin
+        skid_valid  <= 1'b0;
+        skid_action <= '0;
+        skid_input  <= '0;
+    end else begin
+        if (gate_confident && (deep_valid || skid_valid)) begin
+            skid_valid  <= 1'b1;
+            skid_action <= gate_action;
+            skid_input  <= gate_input;
+        end else if (!deep_valid) begin
+            skid_valid  <= 1'b0;                 // parked result went out this cycle
+        end
+    end
+end
+
+// -------------------------------------------------------------------------
+// Statistics
+// -------------------------------------------------------------------------
+always_ff @(posedge clk or posedge rst) begin
+    if (rst) begin
+        gate_count <= '0;
+        deep_count <= '0;
+    end else begin
+        if (gate_confident) gate_count <= gate_count + 1;
+        if (escalate)       deep_count <= deep_count + 1;
+    end
+end
+
+endmodule
@@ -0,0 +1,276 @@
+`timescale 1ns / 1ps
+
+// =============================================================================
+// Combinational Decision Tree — configurable register cuts
+// =============================================================================
+//
+// Same node evaluation, ports and payload RAM as decision_tree_pipelined,
+// but the MAX_DEPTH levels are chained combinationally, with a register
+// cut after every CUT_EVERY levels:
+//
+//   CUT_EVERY = 0         no cuts: capture → all levels → output register,
+//                         1 cycle after start (the single-cycle solution)
+//   CUT_EVERY = k         a cut after levels k, 2k, ... (MAX_DEPTH / k cuts)
+//   CUT_EVERY = 1         a cut after every level — the pipelined engine
+//
+//   Latency:    MAX_DEPTH / CUT_EVERY + 2 cycles including start (fixed)
+//   Throughput: 1 result per cycle at any setting
+//
+// Fewer cuts give fewer cycles but a longer clock period: each segment is
+// CUT_EVERY chained LUTRAM reads + comparators, and the last one also
+// carries the payload read.  Which setting gives the lowest latency in ns
+// depends on the part; vivado/scripts/comb_sweep.tcl measures it.
+//
+// A cut is a plain register (no activity gating): with several levels per
+// segment most of the toggling is in the combinational chain anyway.
+// =============================================================================
+
+module decision_tree_comb #(
+    parameter MAX_NODES  = 64,
+    parameter MAX_DEPTH  = 6,                    // max tree depth (log2 of MAX_NODES)
+    parameter ADDR_WIDTH = $clog2(MAX_NODES),
+    parameter TREE_INIT_FILE = "",               // optional $readmemh image (see tools/tree2mem.cpp)
+    parameter INLINE_LEAVES = 0,                 // 1 = child pointers may carry a leaf action
+    parameter CHILD_WIDTH = ADDR_WIDTH + INLINE_LEAVES,
+    parameter PAYLOAD_ENTRIES = 64,              // order templates (leaf threshold selects one)
+    parameter PAYLOAD_ADDR_WIDTH = $clog2(PAYLOAD_ENTRIES),
+    parameter PAYLOAD_WIDTH = 32,                // {side[1:0], qty[13:0], price_offset[15:0]}
+    parameter PAYLOAD_INIT_FILE = "",            // optional $readmemh image of the templates
+    parameter CUT_EVERY = 0                      // levels per registered segment, 0 = no cuts
+)(
+    input  logic         clk,
+    input  logic         rst,
+    input  logic  [7:0]  market_input,
+    input  logic         start,
+    output logic  [1:0]  action,
+    output logic         action_valid,
+    output logic  [PAYLOAD_WIDTH-1:0] payload,   // leaf's order template, valid with action_valid
+
+    // Software write interface (identical to original)
+    input  logic                  sw_we,
+    input  logic [ADDR_WIDTH-1:0] sw_addr,
+    input  logic                  sw_data_is_leaf,
+    input  logic [7:0]            sw_data_threshold,
+    input  logic                  sw_data_less_than,
+    input  logic [CHILD_WIDTH-1:0] sw_data_left_idx,
+    input  logic [CHILD_WIDTH-1:0] sw_data_right_idx,
+    input  logic [1:0]            sw_data_action,
+
+    // Payload (order template) write interface
+    input  logic                          sw_payload_we,
+    input  logic [PAYLOAD_ADDR_WIDTH-1:0] sw_payload_addr,
+    input  logic [PAYLOAD_WIDTH-1:0]      sw_payload_data
+);
+
+// -------------------------------------------------------------------------
+// Node definition (same as original)
+// -------------------------------------------------------------------------
+typedef struct packed {
+    logic                   is_leaf;
+    logic [7:0]             threshold;
+    logic                   less_than;
+    logic [CHILD_WIDTH-1:0] left_idx;
+    logic [CHILD_WIDTH-1:0] right_idx;
+    logic [1:0]             action;
+} node_t;
+
+// -------------------------------------------------------------------------
+// Tree memory (shared, inferred as LUTRAM — one read port per level)
+// -------------------------------------------------------------------------
+node_t tree_mem [0:MAX_NODES-1];
+
+integer i;
+initial begin
+    for (i = 0; i < MAX_NODES; i++)
+        tree_mem[i] = '0;
+    if (TREE_INIT_FILE != "")
+        $readmemh(TREE_INIT_FILE, tree_mem);
+end
+
+always_ff @(posedge clk) begin
+    if (sw_we) begin
+        tree_mem[sw_addr].is_leaf    <= sw_data_is_leaf;
+        tree_mem[sw_addr].threshold  <= sw_data_threshold;
+        tree_mem[sw_addr].less_than  <= sw_data_less_than;
+        tree_mem[sw_addr].left_idx   <= sw_data_left_idx;
+        tree_mem[sw_addr].right_idx  <= sw_data_right_idx;
+        tree_mem[sw_addr].action     <= sw_data_action;
+    end
+end
+
+// -------------------------------------------------------------------------
+// Leaf payload RAM (same as decision_tree_pipelined)
+// -------------------------------------------------------------------------
+logic [PAYLOAD_WIDTH-1:0] payload_mem [0:PAYLOAD_ENTRIES-1];
+
+initial begin
+    for (i = 0; i < PAYLOAD_ENTRIES; i++)
+        payload_mem[i] = '0;
+    if (PAYLOAD_INIT_FILE != "")
+        $readmemh(PAYLOAD_INIT_FILE, payload_mem);
+end
+
+always_ff @(posedge clk) begin
+    if (sw_payload_we)
+        payload_mem[sw_payload_addr] <= sw_payload_data;
+end
+
+// -------------------------------------------------------------------------
+// Level state
+// -------------------------------------------------------------------------
+// lvl_*[s] is the query state after level s: the same fields as the
+// pipelined engine's stage registers.  Level 0 is the capture register;
+// level s > 0 is the cut register q_*[s] if a cut follows it, else the
+// level's combinational output.  q_* elements without a cut are unused.
+logic                  lvl_valid    [0:MAX_DEPTH];
+logic                  lvl_resolved [0:MAX_DEPTH];
+logic [ADDR_WIDTH-1:0] lvl_node_idx [0:MAX_DEPTH];
+logic [7:0]            lvl_input    [0:MAX_DEPTH];
+logic [1:0]            lvl_result   [0:MAX_DEPTH];
+logic [PAYLOAD_ADDR_WIDTH-1:0] lvl_slot [0:MAX_DEPTH];
+
+logic                  q_valid      [0:MAX_DEPTH];
+logic                  q_resolved   [0:MAX_DEPTH];
+logic [ADDR_WIDTH-1:0] q_node_idx   [0:MAX_DEPTH];
+logic [7:0]            q_input      [0:MAX_DEPTH];
+logic [1:0]            q_result     [0:MAX_DEPTH];
+logic [PAYLOAD_ADDR_WIDTH-1:0] q_slot [0:MAX_DEPTH];
+
+// -------------------------------------------------------------------------
+// Level 0: capture the query
+// -------------------------------------------------------------------------
+always_ff @(posedge clk or posedge rst) begin
+    if (rst) begin
+        q_valid[0]    <= 1'b0;
+        q_resolved[0] <= 1'b0;
+        q_node_idx[0] <= '0;
+        q_input[0]    <= '0;
+        q_result[0]   <= '0;
+        q_slot[0]     <= '0;
+    end else begin
+        q_valid[0]    <= start;
+        q_resolved[0] <= 1'b0;
+        q_node_idx[0] <= '0;
+        q_input[0]    <= market_input;
+        q_result[0]   <= '0;
+        q_slot[0]     <= '0;
+    end
+end
+
+assign lvl_valid[0]    = q_valid[0];
+assign lvl_resolved[0] = q_resolved[0];
+assign lvl_node_idx[0] = q_node_idx[0];
+assign lvl_input[0]    = q_input[0];
+assign lvl_result[0]   = q_result[0];
+assign lvl_slot[0]     = q_slot[0];
+
+// -------------------------------------------------------------------------
+// Levels 1..MAX_DEPTH: one node evaluation each, registered every CUT_EVERY
+// -------------------------------------------------------------------------
+genvar s;
+generate
+    for (s = 1; s <= MAX_DEPTH; s++) begin : level
+
+        node_t                         cur_node;
+        logic                          cond;
+        logic [CHILD_WIDTH-1:0]        next_idx;
+        logic                          next_is_leaf;
+        logic                          nxt_resolved;
+        logic [ADDR_WIDTH-1:0]         nxt_node_idx;
+        logic [1:0]                    nxt_result;
+        logic [PAYLOAD_ADDR_WIDTH-1:0] nxt_slot;
+
+        // Same decision as a pipelined stage
+        always_comb begin
+            cur_node = tree_mem[lvl_node_idx[s-1]];
+            cond     = cur_node.less_than
+                         ? (lvl_input[s-1] < cur_node.threshold)
+                         : (lvl_input[s-1] > cur_node.threshold);
+            next_idx = cond ? cur_node.left_idx : cur_node.right_idx;
+            next_is_leaf = (INLINE_LEAVES != 0) && next_idx[CHILD_WIDTH-1];
+
+            if (!lvl_valid[s-1]) begin
+                nxt_resolved = 1'b0;
+                nxt_node_idx = '0;
+                nxt_result   = '0;
+                nxt_slot     = '0;
+            end
+            else if (lvl_resolved[s-1]) begin
+                nxt_resolved = 1'b1;
+                nxt_node_idx = lvl_node_idx[s-1];
+                nxt_result   = lvl_result[s-1];
+                nxt_slot     = lvl_slot[s-1];
+            end
+            else if (cur_node.is_leaf) begin
+                nxt_resolved = 1'b1;
+                nxt_node_idx = lvl_node_idx[s-1];
+                nxt_result   = cur_node.action;
+                nxt_slot     = cur_node.threshold[PAYLOAD_ADDR_WIDTH-1:0];
+            end
+            else if (next_is_leaf) begin
+                nxt_resolved = 1'b1;
+                nxt_node_idx = lvl_node_idx[s-1];
+                nxt_result   = next_idx[1:0];
+                nxt_slot     = PAYLOAD_ADDR_WIDTH'(next_idx[1:0]);
+            end
+            else begin
+                nxt_resolved = 1'b0;
+                nxt_node_idx = next_idx[ADDR_WIDTH-1:0];
+                nxt_result   = '0;
+                nxt_slot     = '0;
+            end
+        end
+
+        if (CUT_EVERY > 0 && s % CUT_EVERY == 0) begin : cut
+            always_ff @(posedge clk or posedge rst) begin
+                if (rst) begin
+                    q_valid[s]    <= 1'b0;
+                    q_resolved[s] <= 1'b0;
+                    q_node_idx[s] <= '0;
+                    q_input[s]    <= '0;
+                    q_result[s]   <= '0;
+                    q_slot[s]     <= '0;
+                end else begin
+                    q_valid[s]    <= lvl_valid[s-1];
+                    q_resolved[s] <= nxt_resolved;
+                    q_node_idx[s] <= nxt_node_idx;
+                    q_input[s]    <= lvl_input[s-1];
+                    q_result[s]   <= nxt_result;
+                    q_slot[s]     <= nxt_slot;
+                end
+            end
+
+            assign lvl_valid[s]    = q_valid[s];
+            assign lvl_resolved[s] = q_resolved[s];
+            assign lvl_node_idx[s] = q_node_idx[s];
+            assign lvl_input[s]    = q_input[s];
+            assign lvl_result[s]   = q_result[s];
+            assign lvl_slot[s]     = q_slot[s];
+        end else begin : wire_through
+            assign lvl_valid[s]    = lvl_valid[s-1];
+            assign lvl_resolved[s] = nxt_resolved;
+            assign lvl_node_idx[s] = nxt_node_idx;
+            assign lvl_input[s]    = lvl_input[s-1];
+            assign lvl_result[s]   = nxt_result;
+            assign lvl_slot[s]     = nxt_slot;
+        end
+
+    end
+endgenerate
+
+// -------------------------------------------------------------------------
+// Output register (same as decision_tree_pipelined)
+// -------------------------------------------------------------------------
+always_ff @(posedge clk or posedge rst) begin
+    if (rst) begin
+        action       <= '0;
+        action_valid <= 1'b0;
+        payload      <= '0;
+    end else begin
+        action_valid <= lvl_valid[MAX_DEPTH] & lvl_resolved[MAX_DEPTH];
+        action       <= lvl_resolved[MAX_DEPTH] ? lvl_result[MAX_DEPTH] : 2'b00;
+        payload      <= payload_mem[lvl_resolved[MAX_DEPTH] ? lvl_slot[MAX_DEPTH] : '0];
+    end
+end
+
+endmodule
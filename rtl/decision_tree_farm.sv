@@ -0,0 +1,170 @@
+`timescale 1ns / 1ps
+
+// =============================================================================
+// Decision Tree Farm — NUM_CORES replicated FSM engines, in-order results
+// =============================================================================
+//
+// The FSM engine (decision_tree.sv) is small but serves one query per
+// (depth + 1) cycles.  This wrapper instantiates NUM_CORES copies behind a
+// round-robin dispatcher and an in-order merge, so throughput scales with
+// NUM_CORES while area grows linearly — a point anywhere between the FSM
+// and the full pipeline on the area/throughput curve.
+//
+//   Dispatch: query k goes to core (k mod NUM_CORES).  Because results
+//             retire in the same order, the next core in the rotation is
+//             always the first one to free up, so strict round-robin never
+//             skips an idle core.
+//   Merge:    a core that finishes ahead of its turn parks its action in a
+//             per-core result register; the head core's result is forwarded
+//             straight to the output in the cycle it arrives (no extra
+//             register), so NUM_CORES=1 has the bare FSM's latency.
+//
+// Every core holds its own copy of the tree: sw_we writes are broadcast, so
+// all copies always hold the same image.
+//
+// Each core carries the FSM hop watchdog (MAX_DEPTH): an aborted walk
+// retires in order like any other result, flagged with action_error, so a
+// bad image cannot stall the merge.  error_count counts them farm-wide.
+//
+// Flow control: ready is high when the next core in the rotation is free
+// (or retiring this cycle).  A start while ready is low is ignored — the
+// caller must hold the query until ready.
+// =============================================================================
+
+module decision_tree_farm #(
+    parameter NUM_CORES  = 4,
+    parameter MAX_NODES  = 64,
+    parameter ADDR_WIDTH = $clog2(MAX_NODES),
+    parameter TREE_INIT_FILE = "",
+    parameter INLINE_LEAVES = 0,
+    parameter CHILD_WIDTH = ADDR_WIDTH + INLINE_LEAVES,
+    parameter MAX_DEPTH = MAX_NODES,             // per-core hop limit (watchdog)
+    parameter ERROR_COUNT_WIDTH = 16
+)(
+    input  logic         clk,
+    input  logic         rst,
+    input  logic  [7:0]  market_input,
+    input  logic         start,         // accepted only while ready is high
+    output logic         ready,         // next core in the rotation can take a query
+    output logic  [1:0]  action,        // results in query order
+    output logic         action_valid,
+    output logic         action_error,  // with action_valid: walk aborted by the watchdog
+    output logic [ERROR_COUNT_WIDTH-1:0] error_count,
+
+    // Software write interface (broadcast to every core)
+    input  logic                   sw_we,
+    input  logic [ADDR_WIDTH-1:0]  sw_addr,
+    input  logic                   sw_data_is_leaf,
+    input  logic [7:0]             sw_data_threshold,
+    input  logic                   sw_data_less_than,
+    input  logic [CHILD_WIDTH-1:0] sw_data_left_idx,
+    input  logic [CHILD_WIDTH-1:0] sw_data_right_idx,
+    input  logic [1:0]             sw_data_action
+);
+
+localparam PTR_WIDTH = (NUM_CORES > 1) ? $clog2(NUM_CORES) : 1;
+
+// -------------------------------------------------------------------------
+// Per-core state
+// -------------------------------------------------------------------------
+logic [NUM_CORES-1:0] core_start;
+logic [NUM_CORES-1:0] core_valid;
+logic [1:0]           core_action [0:NUM_CORES-1];
+logic [NUM_CORES-1:0] core_error;
+
+logic [NUM_CORES-1:0] busy;                       // query dispatched, not yet retired
+logic [NUM_CORES-1:0] res_valid;                  // finished ahead of its turn, parked
+logic [1:0]           res_action [0:NUM_CORES-1];
+logic [NUM_CORES-1:0] res_error;
+
+logic [PTR_WIDTH-1:0] disp_ptr;                   // next core to dispatch to
+logic [PTR_WIDTH-1:0] ret_ptr;                    // next core to retire (oldest query)
+
+logic head_done;                                  // ret_ptr core has its result this cycle
+logic dispatch;
+
+genvar c;
+generate
+    for (c = 0; c < NUM_CORES; c++) begin : core
+        assign core_start[c] = dispatch && (disp_ptr == PTR_WIDTH'(c));
+
+        decision_tree #(
+            .MAX_NODES      (MAX_NODES),
+            .ADDR_WIDTH     (ADDR_WIDTH),
+            .TREE_INIT_FILE (TREE_INIT_FILE),
+            .INLINE_LEAVES  (INLINE_LEAVES),
+            .CHILD_WIDTH    (CHILD_WIDTH),
+            .MAX_DEPTH      (MAX_DEPTH)
+        ) u_core (
+            .clk              (clk),
+            .rst              (rst),
+            .market_input     (market_input),
+            .start            (core_start[c]),
+            .action           (core_action[c]),
+            .action_valid     (core_valid[c]),
+            .action_error     (core_error[c]),
+            .error_count      (),
+            .sw_we            (sw_we),
+            .sw_addr          (sw_addr),
+            .sw_data_is_leaf  (sw_data_is_leaf),
+            .sw_data_threshold(sw_data_threshold),
+            .sw_data_less_than(sw_data_less_than),
+            .sw_data_left_idx (sw_data_left_idx),
+            .sw_data_right_idx(sw_data_right_idx),
+            .sw_data_action   (sw_data_action)
+        );
+    end
+endgenerate
+
+// -------------------------------------------------------------------------
+// In-order merge: forward the head core's result, parked or arriving now
+// -------------------------------------------------------------------------
+assign head_done    = res_valid[ret_ptr] | core_valid[ret_ptr];
+assign action_valid = head_done;
+assign action       = res_valid[ret_ptr] ? res_action[ret_ptr] : core_action[ret_ptr];
+assign action_error = res_valid[ret_ptr] ? res_error[ret_ptr]  : core_error[ret_ptr];
+
+// -------------------------------------------------------------------------
+// Dispatch: the next core in the rotation must be free or retiring now
+// -------------------------------------------------------------------------
+assign ready    = !busy[disp_ptr] || (head_done && ret_ptr == disp_ptr);
+assign dispatch = start && ready;
+
+always_ff @(posedge clk or posedge rst) begin
+    if (rst) begin
+        busy      <= '0;
+        res_valid <= '0;
+        res_error <= '0;
+        error_count <= '0;
+        disp_ptr  <= '0;
+        ret_ptr   <= '0;
+        for (int k = 0; k < NUM_CORES; k++)
+            res_action[k] <= '0;
+    end else begin
+        // Park results from cores that finished ahead of their turn
+        for (int k = 0; k < NUM_CORES; k++) begin
+            if (core_valid[k] && !(head_done && ret_ptr == PTR_WIDTH'(k))) begin
+                res_valid[k]  <= 1'b1;
+                res_action[k] <= core_action[k];
+                res_error[k]  <= core_error[k];
+            end
+        end
+
+        // Retire the head
+        if (head_done && action_error && error_count != '1)
+            error_count <= error_count + 1'b1;
+        if (head_done) begin
+            busy[ret_ptr]      <= 1'b0;
+            res_valid[ret_ptr] <= 1'b0;
+            ret_ptr <= (ret_ptr == PTR_WIDTH'(NUM_CORES - 1)) ? '0 : ret_ptr + 1'b1;
+        end
+
+        // Dispatch (after retire, so a retiring core can be re-armed at once)
+        if (dispatch) begin
+            busy[disp_ptr] <= 1'b1;
+            disp_ptr <= (disp_ptr == PTR_WIDTH'(NUM_CORES - 1)) ? '0 : disp_ptr + 1'b1;
+        end
+    end
+end
+
+endmodule
@@ -0,0 +1,152 @@
+`timescale 1ns / 1ps
+
+// =============================================================================
+// Implicit-Indexed Decision Tree — complete tree, one memory per level
+// =============================================================================
+//
+// Pipelined like decision_tree_pipelined, but the tree is stored as a
+// complete binary tree of MAX_DEPTH split levels, so children need no
+// pointers.  The node at position p of level s has its children at
+// positions 2p and 2p + 1 of level s + 1, and a stage computes the next
+// position by appending the branch bit:
+//
+//   pos' = {pos, ~cond}            cond true → left, as in node_t
+//
+// Key differences from the pipelined engine:
+//   1. A split stores {less_than, threshold} (9 bits) instead of a 24-bit
+//      node_t; leaves store only a 2-bit action, all on the last level.
+//      MAX_DEPTH = 6: 63 x 9 + 64 x 2 = 695 bits against 64 x 24 = 1536
+//   2. Stage s reads only level s's memory (2^s entries), addressed by the
+//      position it carries — no pointer load on the stage-to-stage path
+//   3. The leaf read shares the output register, so a tree whose leaves
+//      are at depth D needs MAX_DEPTH = D (latency MAX_DEPTH + 2 cycles)
+//   4. Sparse trees are padded by the loader (to_implicit() in
+//      sim/tree_implicit.h); there is no is_leaf bit and no early exit
+//   5. No payload RAM and no preload image
+//
+// Software writes use the BFS index: sw_addr < 2^MAX_DEPTH - 1 writes a
+// split (threshold, less_than), the 2^MAX_DEPTH addresses after that write
+// the leaves left to right (action).
+// =============================================================================
+
+module decision_tree_implicit #(
+    parameter MAX_DEPTH  = 6,                    // split levels; 2^MAX_DEPTH leaves
+    parameter ADDR_WIDTH = MAX_DEPTH + 1         // BFS index of splits and leaves
+)(
+    input  logic         clk,
+    input  logic         rst,
+    input  logic  [7:0]  market_input,
+    input  logic         start,
+    output logic  [1:0]  action,
+    output logic         action_valid,
+
+    // Software write interface (BFS index; no child pointers, no is_leaf)
+    input  logic                  sw_we,
+    input  logic [ADDR_WIDTH-1:0] sw_addr,
+    input  logic [7:0]            sw_data_threshold,
+    input  logic                  sw_data_less_than,
+    input  logic [1:0]            sw_data_action
+);
+
+localparam POS_WIDTH = (MAX_DEPTH > 0) ? MAX_DEPTH : 1;
+localparam LEAF_BASE = (1 << MAX_DEPTH) - 1;    // BFS index of the first leaf
+
+// -------------------------------------------------------------------------
+// Pipeline registers
+// -------------------------------------------------------------------------
+//   - valid:  is this pipeline slot active?
+//   - pos:    position within the stage's level (low s bits used)
+//   - input:  the captured market_input (frozen at start)
+logic                 pipe_valid [0:MAX_DEPTH];
+logic [POS_WIDTH-1:0] pipe_pos   [0:MAX_DEPTH];
+logic [7:0]           pipe_input [0:MAX_DEPTH];
+
+// -------------------------------------------------------------------------
+// Stage 0: Capture input and inject into pipeline
+// -------------------------------------------------------------------------
+always_ff @(posedge clk or posedge rst) begin
+    if (rst) begin
+        pipe_valid[0] <= 1'b0;
+        pipe_pos[0]   <= '0;
+        pipe_input[0] <= '0;
+    end else begin
+        pipe_valid[0] <= start;
+        pipe_pos[0]   <= '0;                // root: the only node on level 0
+        pipe_input[0] <= market_input;
+    end
+end
+
+// -------------------------------------------------------------------------
+// Levels 0..MAX_DEPTH-1: split memory + the stage that reads it
+// -------------------------------------------------------------------------
+genvar s;
+generate
+    for (s = 0; s < MAX_DEPTH; s++) begin : level
+
+        localparam BASE  = (1 << s) - 1;         // BFS index of position 0
+        localparam SEL_W = (s > 0) ? s : 1;
+
+        // {less_than, threshold} for the 2^s splits of this level (LUTRAM)
+        logic [8:0] split_mem [0:(1 << s)-1];
+
+        initial begin
+            for (int k = 0; k < (1 << s); k++)
+                split_mem[k] = '0;
+        end
+
+        always_ff @(posedge clk) begin
+            if (sw_we && sw_addr >= ADDR_WIDTH'(BASE) && sw_addr < ADDR_WIDTH'(2 * BASE + 1))
+                split_mem[SEL_W'(sw_addr - ADDR_WIDTH'(BASE))] <= {sw_data_less_than, sw_data_threshold};
+        end
+
+        // Combinational: read this level's split and take the branch
+        logic [8:0] split;
+        logic       cond;
+
+        always_comb begin
+            split = split_mem[pipe_pos[s][SEL_W-1:0]];
+            cond  = split[8] ? (pipe_input[s] < split[7:0])
+                             : (pipe_input[s] > split[7:0]);
+        end
+
+        always_ff @(posedge clk or posedge rst) begin
+            if (rst) begin
+                pipe_valid[s+1] <= 1'b0;
+                pipe_pos[s+1]   <= '0;
+                pipe_input[s+1] <= '0;
+            end else begin
+                pipe_valid[s+1] <= pipe_valid[s];
+                pipe_pos[s+1]   <= POS_WIDTH'({pipe_pos[s], ~cond});
+                pipe_input[s+1] <= pipe_input[s];
+            end
+        end
+
+    end
+endgenerate
+
+// -------------------------------------------------------------------------
+// Leaf level: 2^MAX_DEPTH actions, read into the output register
+// -------------------------------------------------------------------------
+logic [1:0] leaf_mem [0:(1 << MAX_DEPTH)-1];
+
+initial begin
+    for (int k = 0; k < (1 << MAX_DEPTH); k++)
+        leaf_mem[k] = '0;
+end
+
+always_ff @(posedge clk) begin
+    if (sw_we && sw_addr >= ADDR_WIDTH'(LEAF_BASE))
+        leaf_mem[POS_WIDTH'(sw_addr - ADDR_WIDTH'(LEAF_BASE))] <= sw_data_action;
+end
+
+always_ff @(posedge clk or posedge rst) begin
+    if (rst) begin
+        action       <= '0;
+        action_valid <= 1'b0;
+    end else begin
+        action_valid <= pipe_valid[MAX_DEPTH];
+        action       <= pipe_valid[MAX_DEPTH] ? leaf_mem[pipe_pos[MAX_DEPTH]] : 2'b00;
+    end
+end
+
+endmodule
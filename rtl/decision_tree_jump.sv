@@ -0,0 +1,212 @@
+// =============================================================================
+// Decision Tree Inference Engine — Pointer-Doubling (Jump) FSM
+// =============================================================================
+//
+// Architecture overview:
+//
+//   Same ports, tree memory and parallel next-pointer table as the original
+//   FSM engine (decision_tree.sv), but the table is not walked one hop per
+//   cycle.  It is composed with itself instead (pointer jumping):
+//
+//     jump_0[j]     = next pointer of node j; a leaf points to itself
+//     jump_{r+1}[j] = jump_r[jump_r[j]]           (2^(r+1) hops from j)
+//
+//   Leaves are fixed points, so once a walk reaches a leaf it stays there,
+//   and jump_R[0] is the leaf reached from the root by any walk of at most
+//   2^R hops.  action_valid is high ROUNDS cycles after start (3 at
+//   MAX_DEPTH=8, 6 at 64), independent of the path:
+//
+//     Edge 0 (start):  jump[] <= jump_0 (captured like path[])
+//     Edges 1..R-1:    jump[] <= jump[] ∘ jump[], in place
+//     Edge R:          jump_sq[0] = jump_R[0] → tree_mem → action_valid
+//
+//   R = ROUNDS = clog2(MAX_DEPTH).  The default MAX_DEPTH of 8 covers
+//   every tree with leaves at depth 8 or less, which includes any 64-node
+//   tree for the 6-stage pipeline.  MAX_DEPTH = 64 covers any acyclic
+//   64-node tree, against up to 64 cycles for the linear walk.  The next
+//   start is taken the cycle after action_valid, so back-to-back queries
+//   complete one every ROUNDS + 1 cycles.
+//
+//   Cost: one composition network, MAX_NODES muxes of MAX_NODES:1, each
+//   CHILD_WIDTH bits wide, reused every round.  That is far more logic than
+//   the 64 comparators the original already builds (see synth_compare.tcl).
+//   A copy per round would accept a query every cycle, but R copies of the
+//   network do not fit the Artix-7 35T at MAX_NODES = 64.  As with the
+//   original, one query is in flight at a time, and a start restarts it.
+//
+//   Inline leaves (INLINE_LEAVES=1) are fixed points too: an inline
+//   pointer is passed through instead of being used as an index.
+//
+//   Watchdog: a walk that has not reached a leaf after 2^R hops (a cyclic
+//   image, or a tree deeper than MAX_DEPTH rounded up to a power of two)
+//   ends on a non-leaf.  It returns action NONE with action_valid and
+//   action_error and bumps error_count, as in the original, but always at
+//   the fixed latency.
+//
+// =============================================================================
+
+`timescale 1ns / 1ps
+
+module decision_tree_jump #(
+    parameter MAX_NODES = 64,
+    parameter ADDR_WIDTH = $clog2(MAX_NODES),
+    parameter TREE_INIT_FILE = "",           // optional $readmemh image (see tools/tree2mem.cpp)
+    parameter INLINE_LEAVES = 0,             // 1 = child pointers may carry a leaf action
+    parameter CHILD_WIDTH = ADDR_WIDTH + INLINE_LEAVES,
+    parameter MAX_DEPTH = 8,                 // deepest leaf; rounded up to a power of two
+    parameter ERROR_COUNT_WIDTH = 16         // saturating aborted-walk counter
+)(
+    input  logic         clk,
+    input  logic         rst,
+    input  logic  [7:0]  market_input,  // 8-bit market signal to classify
+    input  logic         start,         // pulse high for 1 cycle to begin traversal
+    output logic  [1:0]  action,        // 00=NONE, 01=BUY, 10=SELL, 11=CANCEL
+    output logic         action_valid,  // high for 1 cycle when action is ready
+    output logic         action_error,  // with action_valid: no leaf within 2^ROUNDS hops
+    output logic [ERROR_COUNT_WIDTH-1:0] error_count,  // aborted walks since reset
+
+    // Software node-write interface (same as decision_tree)
+    input  logic                  sw_we,
+    input  logic [ADDR_WIDTH-1:0] sw_addr,
+    input  logic                  sw_data_is_leaf,
+    input  logic [7:0]            sw_data_threshold,
+    input  logic                  sw_data_less_than,
+    input  logic [CHILD_WIDTH-1:0] sw_data_left_idx,
+    input  logic [CHILD_WIDTH-1:0] sw_data_right_idx,
+    input  logic [1:0]            sw_data_action
+);
+
+localparam ROUNDS = (MAX_DEPTH > 1) ? $clog2(MAX_DEPTH) : 1;
+localparam RW     = $clog2(ROUNDS + 1);
+
+// -------------------------------------------------------------------------
+// Tree Node Definition (identical to decision_tree)
+// -------------------------------------------------------------------------
+typedef struct packed {
+    logic                   is_leaf;
+    logic [7:0]             threshold;
+    logic                   less_than;
+    logic [CHILD_WIDTH-1:0] left_idx;
+    logic [CHILD_WIDTH-1:0] right_idx;
+    logic [1:0]             action;
+} node_t;
+
+node_t tree_mem [0:MAX_NODES-1];
+
+node_t                  node;                          // comparison temporaries (combinational)
+logic                   cond;
+logic [CHILD_WIDTH-1:0] computed_path [0:MAX_NODES-1]; // jump_0, before the start register
+logic [CHILD_WIDTH-1:0] jump          [0:MAX_NODES-1]; // jump_r: 2^r hops from each node
+logic [CHILD_WIDTH-1:0] jump_sq       [0:MAX_NODES-1]; // jump_r ∘ jump_r (combinational)
+logic [CHILD_WIDTH-1:0] root_ptr;                      // jump_sq[0]: where the root ends up
+node_t                  root_node;                     // tree_mem[root_ptr]
+logic                   busy;
+logic [RW-1:0]          round;
+
+function automatic logic is_inline(input logic [CHILD_WIDTH-1:0] p);
+    return (INLINE_LEAVES != 0) && p[CHILD_WIDTH-1];
+endfunction
+
+initial begin
+    for (int i = 0; i < MAX_NODES; i++) begin
+        tree_mem[i] = '0;
+    end
+    if (TREE_INIT_FILE != "")
+        $readmemh(TREE_INIT_FILE, tree_mem);
+end
+
+// -------------------------------------------------------------------------
+// Software write interface — one node per cycle, unprotected during a walk
+// -------------------------------------------------------------------------
+always_ff @(posedge clk) begin
+    if (sw_we) begin
+        tree_mem[sw_addr].is_leaf    <= sw_data_is_leaf;
+        tree_mem[sw_addr].threshold  <= sw_data_threshold;
+        tree_mem[sw_addr].less_than  <= sw_data_less_than;
+        tree_mem[sw_addr].left_idx   <= sw_data_left_idx;
+        tree_mem[sw_addr].right_idx  <= sw_data_right_idx;
+        tree_mem[sw_addr].action     <= sw_data_action;
+    end
+end
+
+// -------------------------------------------------------------------------
+// jump_0 — all MAX_NODES comparisons in parallel, leaves point to themselves
+// -------------------------------------------------------------------------
+always_comb begin
+    for (int j = 0; j < MAX_NODES; j++) begin
+        node = tree_mem[j];
+        cond = node.less_than ? (market_input < node.threshold)
+                              : (market_input > node.threshold);
+        computed_path[j] = node.is_leaf ? CHILD_WIDTH'(j)
+                                        : (cond ? node.left_idx : node.right_idx);
+    end
+end
+
+// -------------------------------------------------------------------------
+// Composition — jump_sq[j] = jump[jump[j]]; inline leaves pass through
+// -------------------------------------------------------------------------
+always_comb begin
+    for (int j = 0; j < MAX_NODES; j++)
+        jump_sq[j] = is_inline(jump[j]) ? jump[j] : jump[jump[j][ADDR_WIDTH-1:0]];
+end
+
+assign root_ptr  = jump_sq[0];
+assign root_node = tree_mem[root_ptr[ADDR_WIDTH-1:0]];
+
+// Captured on start (market_input may change afterwards), then squared in
+// place each round.  The last round only needs root_ptr, so the table is
+// left alone.
+always_ff @(posedge clk) begin
+    if (start) begin
+        for (int k = 0; k < MAX_NODES; k++)
+            jump[k] <= computed_path[k];
+    end else if (busy && round != RW'(ROUNDS - 1)) begin
+        for (int k = 0; k < MAX_NODES; k++)
+            jump[k] <= jump_sq[k];
+    end
+end
+
+// -------------------------------------------------------------------------
+// Control — ROUNDS cycles after start, always
+// -------------------------------------------------------------------------
+always_ff @(posedge clk or posedge rst) begin
+    if (rst) begin
+        action       <= 0;
+        action_valid <= 0;
+        action_error <= 0;
+        error_count  <= 0;
+        busy         <= 0;
+        round        <= 0;
+    end
+    else if (start) begin
+        busy         <= 1;
+        round        <= 0;
+        action_valid <= 0;
+        action_error <= 0;
+    end
+    else if (busy) begin
+        if (round == RW'(ROUNDS - 1)) begin
+            busy         <= 0;
+            action_valid <= 1;
+            if (is_inline(root_ptr)) begin
+                action <= root_ptr[1:0];
+            end else if (root_node.is_leaf) begin
+                action <= root_node.action;
+            end else begin
+                // No leaf within 2^ROUNDS hops — abort with an error
+                action       <= 2'b00;
+                action_error <= 1;
+                if (error_count != '1)
+                    error_count <= error_count + 1'b1;
+            end
+        end else begin
+            round <= round + 1'b1;
+        end
+    end
+    else begin
+        action_valid <= 0;
+        action_error <= 0;
+    end
+end
+
+endmodule
@@ -0,0 +1,222 @@
+`timescale 1ns / 1ps
+
+// =============================================================================
+// Bitmask Decision Tree — pipelined, with set-membership split nodes
+// =============================================================================
+//
+// Pipelined like decision_tree_pipelined, but a split node can test whether
+// market_input belongs to a programmable set instead of comparing it with
+// a threshold:
+//
+//   bucket = market_input[7 -: $clog2(MASK_BITS)]
+//   cond   = is_mask ? mask_mem[threshold][bucket]
+//                    : (less_than ? input < threshold : input > threshold)
+//
+// A threshold tree that carves the input range into bands spends one
+// level per band edge; one mask node routes every band to its side at
+// once, so the converter (convert_to_mask() in sim/tree_mask.h,
+// tools/tree2mask.cpp) replaces such chains and the tree needs fewer
+// stages — at MASK_BITS = 256 any model fits in depth 2.
+//
+// Key differences from the pipelined engine:
+//   1. node_t gains is_mask; a mask node's threshold field selects one of
+//      MASK_ENTRIES masks (its low $clog2(MASK_ENTRIES) bits)
+//   2. MASK_BITS = 256 tests the exact input; MASK_BITS = 32 tests the
+//      coarse bucket input / 8 at an eighth of the mask storage
+//   3. The mask read is a MASK_BITS:1 bit select in parallel with the
+//      comparator, then one more 2:1 mux before the child select
+//   4. No inline leaves, no payload RAM, no activity gating, no preload
+//
+// Masks are written 32 bits at a time: sw_mask_addr = mask * MASK_WORDS +
+// word, word 0 holding buckets 0..31.
+// =============================================================================
+
+module decision_tree_mask #(
+    parameter MAX_NODES    = 64,
+    parameter MAX_DEPTH    = 6,                  // pipeline stages
+    parameter ADDR_WIDTH   = $clog2(MAX_NODES),
+    parameter MASK_ENTRIES = 8,                  // masks a tree may use
+    parameter MASK_BITS    = 256,                // 256 (exact input) or 32 (input / 8)
+    parameter MASK_WORDS   = MASK_BITS / 32,
+    parameter MASK_ADDR_WIDTH = $clog2(MASK_ENTRIES * MASK_WORDS) > 0
+                                  ? $clog2(MASK_ENTRIES * MASK_WORDS) : 1
+)(
+    input  logic         clk,
+    input  logic         rst,
+    input  logic  [7:0]  market_input,
+    input  logic         start,
+    output logic  [1:0]  action,
+    output logic         action_valid,
+
+    // Software write interface (pipelined engine's, plus is_mask)
+    input  logic                  sw_we,
+    input  logic [ADDR_WIDTH-1:0] sw_addr,
+    input  logic                  sw_data_is_leaf,
+    input  logic                  sw_data_is_mask,
+    input  logic [7:0]            sw_data_threshold,
+    input  logic                  sw_data_less_than,
+    input  logic [ADDR_WIDTH-1:0] sw_data_left_idx,
+    input  logic [ADDR_WIDTH-1:0] sw_data_right_idx,
+    input  logic [1:0]            sw_data_action,
+
+    // Mask write interface, one 32-bit word per cycle
+    input  logic                       sw_mask_we,
+    input  logic [MASK_ADDR_WIDTH-1:0] sw_mask_addr,
+    input  logic [31:0]                sw_mask_data
+);
+
+localparam BUCKET_W = $clog2(MASK_BITS);
+localparam SEL_W    = (MASK_ENTRIES > 1) ? $clog2(MASK_ENTRIES) : 1;
+
+// -------------------------------------------------------------------------
+// Node definition (pipelined engine's, plus is_mask)
+// -------------------------------------------------------------------------
+typedef struct packed {
+    logic                  is_leaf;
+    logic                  is_mask;
+    logic [7:0]            threshold;        // mask node: mask index
+    logic                  less_than;
+    logic [ADDR_WIDTH-1:0] left_idx;
+    logic [ADDR_WIDTH-1:0] right_idx;
+    logic [1:0]            action;
+} node_t;
+
+// -------------------------------------------------------------------------
+// Tree and mask memories (LUTRAM)
+// -------------------------------------------------------------------------
+node_t                tree_mem [0:MAX_NODES-1];
+logic [MASK_BITS-1:0] mask_mem [0:MASK_ENTRIES-1];
+
+integer i;
+initial begin
+    for (i = 0; i < MAX_NODES; i++)
+        tree_mem[i] = '0;
+    for (i = 0; i < MASK_ENTRIES; i++)
+        mask_mem[i] = '0;
+end
+
+always_ff @(posedge clk) begin
+    if (sw_we) begin
+        tree_mem[sw_addr].is_leaf    <= sw_data_is_leaf;
+        tree_mem[sw_addr].is_mask    <= sw_data_is_mask;
+        tree_mem[sw_addr].threshold  <= sw_data_threshold;
+        tree_mem[sw_addr].less_than  <= sw_data_less_than;
+        tree_mem[sw_addr].left_idx   <= sw_data_left_idx;
+        tree_mem[sw_addr].right_idx  <= sw_data_right_idx;
+        tree_mem[sw_addr].action     <= sw_data_action;
+    end
+end
+
+always_ff @(posedge clk) begin
+    if (sw_mask_we)
+        mask_mem[sw_mask_addr / MASK_WORDS][(sw_mask_addr % MASK_WORDS) * 32 +: 32] <= sw_mask_data;
+end
+
+// -------------------------------------------------------------------------
+// Pipeline registers
+// -------------------------------------------------------------------------
+//   - valid:     is this pipeline slot active?
+//   - resolved:  has a leaf already been found at an earlier stage?
+//   - node_idx:  index of the node to evaluate at this stage
+//   - input:     the captured market_input (frozen at start)
+//   - result:    the action from the leaf (valid when resolved=1)
+logic                  pipe_valid    [0:MAX_DEPTH];
+logic                  pipe_resolved [0:MAX_DEPTH];
+logic [ADDR_WIDTH-1:0] pipe_node_idx [0:MAX_DEPTH];
+logic [7:0]            pipe_input    [0:MAX_DEPTH];
+logic [1:0]            pipe_result   [0:MAX_DEPTH];
+
+// -------------------------------------------------------------------------
+// Stage 0: Capture input and inject into pipeline
+// -------------------------------------------------------------------------
+always_ff @(posedge clk or posedge rst) begin
+    if (rst) begin
+        pipe_valid[0]    <= 1'b0;
+        pipe_resolved[0] <= 1'b0;
+        pipe_node_idx[0] <= '0;
+        pipe_input[0]    <= '0;
+        pipe_result[0]   <= '0;
+    end else begin
+        pipe_valid[0]    <= start;
+        pipe_resolved[0] <= 1'b0;
+        pipe_node_idx[0] <= '0;             // always start at root (index 0)
+        pipe_input[0]    <= market_input;
+        pipe_result[0]   <= '0;
+    end
+end
+
+// -------------------------------------------------------------------------
+// Stages 1..MAX_DEPTH: Evaluate one tree level per stage
+// -------------------------------------------------------------------------
+genvar s;
+generate
+    for (s = 1; s <= MAX_DEPTH; s++) begin : stage
+
+        // Combinational: read the node, its mask bit and the comparator
+        node_t                 cur_node;
+        logic [BUCKET_W-1:0]   bucket;
+        logic                  in_mask;
+        logic                  cond;
+        logic [ADDR_WIDTH-1:0] next_idx;
+
+        always_comb begin
+            cur_node = tree_mem[pipe_node_idx[s-1]];
+            bucket   = pipe_input[s-1][7 -: BUCKET_W];
+            in_mask  = mask_mem[cur_node.threshold[SEL_W-1:0]][bucket];
+            cond     = cur_node.is_mask   ? in_mask
+                     : cur_node.less_than ? (pipe_input[s-1] < cur_node.threshold)
+                                          : (pipe_input[s-1] > cur_node.threshold);
+            next_idx = cond ? cur_node.left_idx : cur_node.right_idx;
+        end
+
+        always_ff @(posedge clk or posedge rst) begin
+            if (rst) begin
+                pipe_valid[s]    <= 1'b0;
+                pipe_resolved[s] <= 1'b0;
+                pipe_node_idx[s] <= '0;
+                pipe_input[s]    <= '0;
+                pipe_result[s]   <= '0;
+            end else begin
+                pipe_valid[s] <= pipe_valid[s-1];
+                pipe_input[s] <= pipe_input[s-1];
+                if (!pipe_valid[s-1]) begin
+                    // Bubble — no active data
+                    pipe_resolved[s] <= 1'b0;
+                    pipe_node_idx[s] <= '0;
+                    pipe_result[s]   <= '0;
+                end else if (pipe_resolved[s-1]) begin
+                    // Already found a leaf in an earlier stage — pass through
+                    pipe_resolved[s] <= 1'b1;
+                    pipe_node_idx[s] <= pipe_node_idx[s-1];
+                    pipe_result[s]   <= pipe_result[s-1];
+                end else if (cur_node.is_leaf) begin
+                    // This node is a leaf — resolve now
+                    pipe_resolved[s] <= 1'b1;
+                    pipe_node_idx[s] <= pipe_node_idx[s-1];
+                    pipe_result[s]   <= cur_node.action;
+                end else begin
+                    // Split (threshold or mask) — advance to child
+                    pipe_resolved[s] <= 1'b0;
+                    pipe_node_idx[s] <= next_idx;
+                    pipe_result[s]   <= '0;
+                end
+            end
+        end
+
+    end
+endgenerate
+
+// -------------------------------------------------------------------------
+// Output: tap the end of the pipeline
+// -------------------------------------------------------------------------
+always_ff @(posedge clk or posedge rst) begin
+    if (rst) begin
+        action       <= '0;
+        action_valid <= 1'b0;
+    end else begin
+        action_valid <= pipe_valid[MAX_DEPTH] & pipe_resolved[MAX_DEPTH];
+        action       <= pipe_resolved[MAX_DEPTH] ? pipe_result[MAX_DEPTH] : 2'b00;
+    end
+end
+
+endmodule
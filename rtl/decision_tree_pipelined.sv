@@ -13,6 +13,15 @@
 //   4. No wasted parallel pre-computation — only the traversed node is evaluated
 //   5. market_input is captured once and flows through the pipeline (no mid-
 //      traversal corruption bug)
+//   6. Optional inline leaves (INLINE_LEAVES=1): a child pointer can carry a
+//      leaf action directly, so the parent's stage resolves the query and a
+//      tree with leaves at depth D needs MAX_DEPTH = D instead of D + 1
+//   7. Leaf payload RAM: every leaf selects an order template that comes out
+//      on `payload` in the same cycle as action_valid, so downstream logic
+//      can fire without a table lookup of its own
+//   8. Activity gating (ACTIVITY_GATING=1): the wide stage registers load
+//      only when they carry live data, so bubbles and resolved queries do
+//      not toggle them — same ports, same latency
 //
 // Same software write interface as the original for drop-in compatibility.
 // =============================================================================
@@ -20,7 +29,15 @@
 module decision_tree_pipelined #(
     parameter MAX_NODES  = 64,
     parameter MAX_DEPTH  = 6,                    // max tree depth (log2 of MAX_NODES)
-    parameter ADDR_WIDTH = $clog2(MAX_NODES)
+    parameter ADDR_WIDTH = $clog2(MAX_NODES),
+    parameter TREE_INIT_FILE = "",               // optional $readmemh image (see tools/tree2mem.cpp)
+    parameter INLINE_LEAVES = 0,                 // 1 = child pointers may carry a leaf action
+    parameter CHILD_WIDTH = ADDR_WIDTH + INLINE_LEAVES,
+    parameter PAYLOAD_ENTRIES = 64,              // order templates (leaf threshold selects one)
+    parameter PAYLOAD_ADDR_WIDTH = $clog2(PAYLOAD_ENTRIES),
+    parameter PAYLOAD_WIDTH = 32,                // {side[1:0], qty[13:0], price_offset[15:0]}
+    parameter PAYLOAD_INIT_FILE = "",            // optional $readmemh image of the templates
+    parameter ACTIVITY_GATING = 1                // 1 = clock-enable stage data on live traffic only
 )(
     input  logic         clk,
     input  logic         rst,
@@ -28,6 +45,7 @@ module decision_tree_pipelined #(
     input  logic         start,
     output logic  [1:0]  action,
     output logic         action_valid,
+    output logic  [PAYLOAD_WIDTH-1:0] payload,   // leaf's order template, valid with action_valid
 
     // Software write interface (identical to original)
     input  logic                  sw_we,
@@ -35,21 +53,28 @@ module decision_tree_pipelined #(
     input  logic                  sw_data_is_leaf,
     input  logic [7:0]            sw_data_threshold,
     input  logic                  sw_data_less_than,
-    input  logic [ADDR_WIDTH-1:0] sw_data_left_idx,
-    input  logic [ADDR_WIDTH-1:0] sw_data_right_idx,
-    input  logic [1:0]            sw_data_action
+    input  logic [CHILD_WIDTH-1:0] sw_data_left_idx,
+    input  logic [CHILD_WIDTH-1:0] sw_data_right_idx,
+    input  logic [1:0]            sw_data_action,
+
+    // Payload (order template) write interface
+    input  logic                          sw_payload_we,
+    input  logic [PAYLOAD_ADDR_WIDTH-1:0] sw_payload_addr,
+    input  logic [PAYLOAD_WIDTH-1:0]      sw_payload_data
 );
 
 // -------------------------------------------------------------------------
 // Node definition (same as original)
 // -------------------------------------------------------------------------
+// With INLINE_LEAVES=1 a child is {inline_leaf, index}; an inline leaf
+// carries its action in the low 2 bits.
 typedef struct packed {
-    logic                  is_leaf;
-    logic [7:0]            threshold;
-    logic                  less_than;
-    logic [ADDR_WIDTH-1:0] left_idx;
-    logic [ADDR_WIDTH-1:0] right_idx;
-    logic [1:0]            action;
+    logic                   is_leaf;
+    logic [7:0]             threshold;
+    logic                   less_than;
+    logic [CHILD_WIDTH-1:0] left_idx;
+    logic [CHILD_WIDTH-1:0] right_idx;
+    logic [1:0]             action;
 } node_t;
 
 // -------------------------------------------------------------------------
@@ -57,10 +82,14 @@ typedef struct packed {
 // -------------------------------------------------------------------------
 node_t tree_mem [0:MAX_NODES-1];
 
+// Zero-initialise, then optionally preload a model image so the engine is
+// live straight out of reset (same as the original).
 integer i;
 initial begin
     for (i = 0; i < MAX_NODES; i++)
         tree_mem[i] = '0;
+    if (TREE_INIT_FILE != "")
+        $readmemh(TREE_INIT_FILE, tree_mem);
 end
 
 // Software write interface
@@ -75,6 +104,27 @@ always_ff @(posedge clk) begin
     end
 end
 
+// -------------------------------------------------------------------------
+// Leaf payload RAM (order templates, LUTRAM)
+// -------------------------------------------------------------------------
+// A leaf node's threshold field is otherwise unused; its low
+// PAYLOAD_ADDR_WIDTH bits select the template.  An inline leaf has no
+// threshold to spare, so it selects template <action> — with
+// INLINE_LEAVES=1 entries 0..3 act as per-action default templates.
+logic [PAYLOAD_WIDTH-1:0] payload_mem [0:PAYLOAD_ENTRIES-1];
+
+initial begin
+    for (i = 0; i < PAYLOAD_ENTRIES; i++)
+        payload_mem[i] = '0;
+    if (PAYLOAD_INIT_FILE != "")
+        $readmemh(PAYLOAD_INIT_FILE, payload_mem);
+end
+
+always_ff @(posedge clk) begin
+    if (sw_payload_we)
+        payload_mem[sw_payload_addr] <= sw_payload_data;
+end
+
 // -------------------------------------------------------------------------
 // Pipeline registers
 // -------------------------------------------------------------------------
@@ -84,12 +134,23 @@ end
 //   - node_idx:     index of the node to evaluate at this stage
 //   - input_val:    the captured market_input (frozen at start)
 //   - result:       the action from the leaf (valid when resolved=1)
+//   - slot:         the leaf's payload template index (valid when resolved=1)
+//
+// With ACTIVITY_GATING=1 only valid and resolved load every cycle.
+// input_val and node_idx load only while the query is still walking, and
+// result and slot only for valid slots.  Bubbles keep stale values, and so
+// do resolved queries' input_val and node_idx; nothing reads them, since a
+// stage evaluates only valid, unresolved slots and the output stage masks
+// by resolved.  The enables come straight from the previous stage's
+// valid / resolved flops (the FF's CE pin), so nothing is added to the
+// node-evaluation path.
 
 logic                  pipe_valid    [0:MAX_DEPTH];
 logic                  pipe_resolved [0:MAX_DEPTH];
 logic [ADDR_WIDTH-1:0] pipe_node_idx [0:MAX_DEPTH];
 logic [7:0]            pipe_input    [0:MAX_DEPTH];
 logic [1:0]            pipe_result   [0:MAX_DEPTH];
+logic [PAYLOAD_ADDR_WIDTH-1:0] pipe_slot [0:MAX_DEPTH];
 
 // -------------------------------------------------------------------------
 // Stage 0: Capture input and inject into pipeline
@@ -101,12 +162,15 @@ always_ff @(posedge clk or posedge rst) begin
         pipe_node_idx[0] <= '0;
         pipe_input[0]    <= '0;
         pipe_result[0]   <= '0;
+        pipe_slot[0]     <= '0;
     end else begin
         pipe_valid[0]    <= start;
         pipe_resolved[0] <= 1'b0;           // not yet resolved
         pipe_node_idx[0] <= '0;             // always start at root (index 0)
-        pipe_input[0]    <= market_input;   // capture input — frozen for this traversal
+        if (start || ACTIVITY_GATING == 0)
+            pipe_input[0] <= market_input;  // capture input — frozen for this traversal
         pipe_result[0]   <= '0;
+        pipe_slot[0]     <= '0;
     end
 end
 
@@ -120,7 +184,8 @@ generate
         // Combinational: read the node and decide
         node_t                  cur_node;
         logic                   cond;
-        logic [ADDR_WIDTH-1:0]  next_idx;
+        logic [CHILD_WIDTH-1:0] next_idx;
+        logic                   next_is_leaf;
 
         always_comb begin
             cur_node = tree_mem[pipe_node_idx[s-1]];
@@ -128,8 +193,58 @@ generate
                          ? (pipe_input[s-1] < cur_node.threshold)
                          : (pipe_input[s-1] > cur_node.threshold);
             next_idx = cond ? cur_node.left_idx : cur_node.right_idx;
+            next_is_leaf = (INLINE_LEAVES != 0) && next_idx[CHILD_WIDTH-1];
         end
 
+        // Next register values
+        logic                          nxt_resolved;
+        logic [ADDR_WIDTH-1:0]         nxt_node_idx;
+        logic [1:0]                    nxt_result;
+        logic [PAYLOAD_ADDR_WIDTH-1:0] nxt_slot;
+
+        always_comb begin
+            if (!pipe_valid[s-1]) begin
+                // Bubble — no active data
+                nxt_resolved = 1'b0;
+                nxt_node_idx = '0;
+                nxt_result   = '0;
+                nxt_slot     = '0;
+            end
+            else if (pipe_resolved[s-1]) begin
+                // Already found a leaf in an earlier stage — just pass through
+                nxt_resolved = 1'b1;
+                nxt_node_idx = pipe_node_idx[s-1];
+                nxt_result   = pipe_result[s-1];
+                nxt_slot     = pipe_slot[s-1];
+            end
+            else if (cur_node.is_leaf) begin
+                // This node is a leaf — resolve now
+                nxt_resolved = 1'b1;
+                nxt_node_idx = pipe_node_idx[s-1];
+                nxt_result   = cur_node.action;
+                nxt_slot     = cur_node.threshold[PAYLOAD_ADDR_WIDTH-1:0];
+            end
+            else if (next_is_leaf) begin
+                // Chosen child is an inline leaf — resolve without a fetch
+                nxt_resolved = 1'b1;
+                nxt_node_idx = pipe_node_idx[s-1];
+                nxt_result   = next_idx[1:0];
+                nxt_slot     = PAYLOAD_ADDR_WIDTH'(next_idx[1:0]);
+            end
+            else begin
+                // Internal node — advance to child
+                nxt_resolved = 1'b0;
+                nxt_node_idx = next_idx[ADDR_WIDTH-1:0];
+                nxt_result   = '0;
+                nxt_slot     = '0;
+            end
+        end
+
+        // Clock enables: walk state while walking, result for any valid slot
+        logic ce_walk, ce_result;
+        assign ce_walk   = (ACTIVITY_GATING == 0) || (pipe_valid[s-1] && !pipe_resolved[s-1]);
+        assign ce_result = (ACTIVITY_GATING == 0) || pipe_valid[s-1];
+
         // Sequential: register the pipeline stage
         always_ff @(posedge clk or posedge rst) begin
             if (rst) begin
@@ -138,33 +253,17 @@ generate
                 pipe_node_idx[s] <= '0;
                 pipe_input[s]    <= '0;
                 pipe_result[s]   <= '0;
+                pipe_slot[s]     <= '0;
             end else begin
                 pipe_valid[s]    <= pipe_valid[s-1];
-                pipe_input[s]    <= pipe_input[s-1];
-
-                if (!pipe_valid[s-1]) begin
-                    // Bubble — no active data
-                    pipe_resolved[s] <= 1'b0;
-                    pipe_node_idx[s] <= '0;
-                    pipe_result[s]   <= '0;
+                pipe_resolved[s] <= nxt_resolved;
+                if (ce_walk) begin
+                    pipe_input[s]    <= pipe_input[s-1];
+                    pipe_node_idx[s] <= nxt_node_idx;
                 end
-                else if (pipe_resolved[s-1]) begin
-                    // Already found a leaf in an earlier stage — just pass through
-                    pipe_resolved[s] <= 1'b1;
-                    pipe_node_idx[s] <= pipe_node_idx[s-1];
-                    pipe_result[s]   <= pipe_result[s-1];
-                end
-                else if (cur_node.is_leaf) begin
-                    // This node is a leaf — resolve now
-                    pipe_resolved[s] <= 1'b1;
-                    pipe_node_idx[s] <= pipe_node_idx[s-1];
-                    pipe_result[s]   <= cur_node.action;
-                end
-                else begin
-                    // Internal node — advance to child
-                    pipe_resolved[s] <= 1'b0;
-                    pipe_node_idx[s] <= next_idx;
-                    pipe_result[s]   <= '0;
+                if (ce_result) begin
+                    pipe_result[s]   <= nxt_result;
+                    pipe_slot[s]     <= nxt_slot;
                 end
             end
         end
@@ -175,14 +274,24 @@ endgenerate
 // -------------------------------------------------------------------------
 // Output: tap the end of the pipeline
 // -------------------------------------------------------------------------
+// The payload read shares the existing output register stage, so the
+// template arrives with action_valid at no extra latency.  Masking by
+// resolved gives the same idle outputs (action 0, template 0) whether or
+// not the stage data was gated.
 always_ff @(posedge clk or posedge rst) begin
     if (rst) begin
         action       <= '0;
         action_valid <= 1'b0;
+        payload      <= '0;
     end else begin
         action_valid <= pipe_valid[MAX_DEPTH] & pipe_resolved[MAX_DEPTH];
-        action       <= pipe_result[MAX_DEPTH];
+        action       <= pipe_resolved[MAX_DEPTH] ? pipe_result[MAX_DEPTH] : 2'b00;
+        payload      <= payload_mem[pipe_resolved[MAX_DEPTH] ? pipe_slot[MAX_DEPTH] : '0];
     end
 end
 
+`ifdef FORMAL
+`include "decision_tree_pipelined_props.svh"
+`endif
+
 endmodule
@@ -0,0 +1,184 @@
+`timescale 1ns / 1ps
+
+// =============================================================================
+// Pipelined Decision Tree — 4-ary (quad) split nodes
+// =============================================================================
+//
+// Same pipeline as decision_tree_pipelined.sv, but each node holds three
+// sorted thresholds and four children.  Each stage compares the input
+// against all three thresholds in parallel and picks one of four children:
+//
+//   bucket = (x >= t0) + (x >= t1) + (x >= t2)      → child[bucket]
+//
+// One quad level covers two binary levels, so the same leaf count needs
+// half the stages (and half the latency):
+//
+//   binary, leaves at depth <= 5:  MAX_DEPTH = 6  →  8 cycles
+//   quad,   leaves at depth <= 3:  MAX_DEPTH = 4  →  6 cycles
+//
+// Cost per stage is 3 comparators + a 4:1 index mux instead of 1 + 2:1, and
+// a 3*8 + 4*ADDR_WIDTH node word.  Binary trees are converted with
+// convert_to_quad() in sim/tree_quad.h (tools/tree2quad).
+//
+// Latency: MAX_DEPTH + 2 cycles (fixed).  Throughput: 1 result / cycle.
+// =============================================================================
+
+module decision_tree_quad #(
+    parameter MAX_NODES  = 64,
+    parameter MAX_DEPTH  = 4,                    // quad levels (one stage each)
+    parameter ADDR_WIDTH = $clog2(MAX_NODES),
+    parameter TREE_INIT_FILE = ""                // optional $readmemh image
+)(
+    input  logic         clk,
+    input  logic         rst,
+    input  logic  [7:0]  market_input,
+    input  logic         start,
+    output logic  [1:0]  action,
+    output logic         action_valid,
+
+    // Software write interface — one quad node per cycle
+    input  logic                       sw_we,
+    input  logic [ADDR_WIDTH-1:0]      sw_addr,
+    input  logic                       sw_data_is_leaf,
+    input  logic [2:0][7:0]            sw_data_threshold,   // [0] <= [1] <= [2]
+    input  logic [3:0][ADDR_WIDTH-1:0] sw_data_child_idx,
+    input  logic [1:0]                 sw_data_action
+);
+
+// -------------------------------------------------------------------------
+// Node definition
+// -------------------------------------------------------------------------
+// For MAX_NODES=64: 1 + 24 + 24 + 2 = 51 bits per node.
+typedef struct packed {
+    logic                       is_leaf;
+    logic [2:0][7:0]            threshold;
+    logic [3:0][ADDR_WIDTH-1:0] child_idx;
+    logic [1:0]                 action;
+} quad_node_t;
+
+// -------------------------------------------------------------------------
+// Tree memory (shared, inferred as LUTRAM / distributed RAM)
+// -------------------------------------------------------------------------
+quad_node_t tree_mem [0:MAX_NODES-1];
+
+integer i;
+initial begin
+    for (i = 0; i < MAX_NODES; i++)
+        tree_mem[i] = '0;
+    if (TREE_INIT_FILE != "")
+        $readmemh(TREE_INIT_FILE, tree_mem);
+end
+
+always_ff @(posedge clk) begin
+    if (sw_we) begin
+        tree_mem[sw_addr].is_leaf   <= sw_data_is_leaf;
+        tree_mem[sw_addr].threshold <= sw_data_threshold;
+        tree_mem[sw_addr].child_idx <= sw_data_child_idx;
+        tree_mem[sw_addr].action    <= sw_data_action;
+    end
+end
+
+// -------------------------------------------------------------------------
+// Pipeline registers (same meaning as decision_tree_pipelined)
+// -------------------------------------------------------------------------
+logic                  pipe_valid    [0:MAX_DEPTH];
+logic                  pipe_resolved [0:MAX_DEPTH];
+logic [ADDR_WIDTH-1:0] pipe_node_idx [0:MAX_DEPTH];
+logic [7:0]            pipe_input    [0:MAX_DEPTH];
+logic [1:0]            pipe_result   [0:MAX_DEPTH];
+
+// -------------------------------------------------------------------------
+// Stage 0: Capture input and inject into pipeline
+// -------------------------------------------------------------------------
+always_ff @(posedge clk or posedge rst) begin
+    if (rst) begin
+        pipe_valid[0]    <= 1'b0;
+        pipe_resolved[0] <= 1'b0;
+        pipe_node_idx[0] <= '0;
+        pipe_input[0]    <= '0;
+        pipe_result[0]   <= '0;
+    end else begin
+        pipe_valid[0]    <= start;
+        pipe_resolved[0] <= 1'b0;
+        pipe_node_idx[0] <= '0;
+        pipe_input[0]    <= market_input;
+        pipe_result[0]   <= '0;
+    end
+end
+
+// -------------------------------------------------------------------------
+// Stages 1..MAX_DEPTH: Evaluate one quad level per stage
+// -------------------------------------------------------------------------
+genvar s;
+generate
+    for (s = 1; s <= MAX_DEPTH; s++) begin : stage
+
+        quad_node_t             cur_node;
+        logic [1:0]             bucket;
+        logic [ADDR_WIDTH-1:0]  next_idx;
+
+        // Three comparators in parallel; with sorted thresholds the sum of
+        // the thermometer bits is the bucket index.
+        always_comb begin
+            cur_node = tree_mem[pipe_node_idx[s-1]];
+            bucket   = 2'(pipe_input[s-1] >= cur_node.threshold[0])
+                     + 2'(pipe_input[s-1] >= cur_node.threshold[1])
+                     + 2'(pipe_input[s-1] >= cur_node.threshold[2]);
+            next_idx = cur_node.child_idx[bucket];
+        end
+
+        always_ff @(posedge clk or posedge rst) begin
+            if (rst) begin
+                pipe_valid[s]    <= 1'b0;
+                pipe_resolved[s] <= 1'b0;
+                pipe_node_idx[s] <= '0;
+                pipe_input[s]    <= '0;
+                pipe_result[s]   <= '0;
+            end else begin
+                pipe_valid[s]    <= pipe_valid[s-1];
+                pipe_input[s]    <= pipe_input[s-1];
+
+                if (!pipe_valid[s-1]) begin
+                    // Bubble — no active data
+                    pipe_resolved[s] <= 1'b0;
+                    pipe_node_idx[s] <= '0;
+                    pipe_result[s]   <= '0;
+                end
+                else if (pipe_resolved[s-1]) begin
+                    // Already found a leaf in an earlier stage — just pass through
+                    pipe_resolved[s] <= 1'b1;
+                    pipe_node_idx[s] <= pipe_node_idx[s-1];
+                    pipe_result[s]   <= pipe_result[s-1];
+                end
+                else if (cur_node.is_leaf) begin
+                    // This node is a leaf — resolve now
+                    pipe_resolved[s] <= 1'b1;
+                    pipe_node_idx[s] <= pipe_node_idx[s-1];
+                    pipe_result[s]   <= cur_node.action;
+                end
+                else begin
+                    // Internal node — advance to the selected child
+                    pipe_resolved[s] <= 1'b0;
+                    pipe_node_idx[s] <= next_idx;
+                    pipe_result[s]   <= '0;
+                end
+            end
+        end
+
+    end
+endgenerate
+
+// -------------------------------------------------------------------------
+// Output: tap the end of the pipeline
+// -------------------------------------------------------------------------
+always_ff @(posedge clk or posedge rst) begin
+    if (rst) begin
+        action       <= '0;
+        action_valid <= 1'b0;
+    end else begin
+        action_valid <= pipe_valid[MAX_DEPTH] & pipe_resolved[MAX_DEPTH];
+        action       <= pipe_result[MAX_DEPTH];
+    end
+end
+
+endmodule
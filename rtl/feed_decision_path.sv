@@ -0,0 +1,114 @@
+`timescale 1ns / 1ps
+
+// =============================================================================
+// Feed → Decision Path — feed_parser in front of the pipelined engine
+// =============================================================================
+//
+// Binary market-data stream in, action/payload out.  The parser issues
+// start/market_input combinationally in the cycle the configured field is on
+// the bus, so wire-to-decision latency is
+//
+//   field beat accepted ──(MAX_DEPTH + 2)──▶ action_valid
+//
+// (+1 from the first beat of the message for size queries, which ride on
+// beat 1).
+// =============================================================================
+
+module feed_decision_path #(
+    parameter MAX_NODES  = 64,
+    parameter MAX_DEPTH  = 6,
+    parameter ADDR_WIDTH = $clog2(MAX_NODES),
+    parameter TREE_INIT_FILE = "",
+    parameter PAYLOAD_ENTRIES = 64,
+    parameter PAYLOAD_ADDR_WIDTH = $clog2(PAYLOAD_ENTRIES)
+)(
+    input  logic         clk,
+    input  logic         rst,
+
+    // Feed stream
+    input  logic [63:0]  s_tdata,
+    input  logic         s_tvalid,
+    input  logic         s_tlast,
+    output logic         s_tready,
+
+    // Parser configuration
+    input  logic         cfg_field,
+    input  logic [7:0]   cfg_msg_type,
+    input  logic         cfg_match_instrument,
+    input  logic [15:0]  cfg_instrument,
+    input  logic [31:0]  cfg_offset,
+    input  logic [4:0]   cfg_shift,
+
+    // Decision
+    output logic  [1:0]  action,
+    output logic         action_valid,
+    output logic [31:0]  payload,
+
+    // Observability / statistics
+    output logic         query_start,           // parser → engine start
+    output logic  [7:0]  query_input,           // parser → engine market_input
+    output logic [31:0]  msg_count,
+    output logic [31:0]  query_count,
+
+    // Software write interface (tree + order templates)
+    input  logic                          sw_we,
+    input  logic [ADDR_WIDTH-1:0]         sw_addr,
+    input  logic                          sw_data_is_leaf,
+    input  logic [7:0]                    sw_data_threshold,
+    input  logic                          sw_data_less_than,
+    input  logic [ADDR_WIDTH-1:0]         sw_data_left_idx,
+    input  logic [ADDR_WIDTH-1:0]         sw_data_right_idx,
+    input  logic [1:0]                    sw_data_action,
+    input  logic                          sw_payload_we,
+    input  logic [PAYLOAD_ADDR_WIDTH-1:0] sw_payload_addr,
+    input  logic [31:0]                   sw_payload_data
+);
+
+feed_parser u_parser (
+    .clk                  (clk),
+    .rst                  (rst),
+    .s_tdata              (s_tdata),
+    .s_tvalid             (s_tvalid),
+    .s_tlast              (s_tlast),
+    .s_tready             (s_tready),
+    .cfg_field            (cfg_field),
+    .cfg_msg_type         (cfg_msg_type),
+    .cfg_match_instrument (cfg_match_instrument),
+    .cfg_instrument       (cfg_instrument),
+    .cfg_offset           (cfg_offset),
+    .cfg_shift            (cfg_shift),
+    .start                (query_start),
+    .market_input         (query_input),
+    .msg_count            (msg_count),
+    .query_count          (query_count)
+);
+
+decision_tree_pipelined #(
+    .MAX_NODES          (MAX_NODES),
+    .MAX_DEPTH          (MAX_DEPTH),
+    .ADDR_WIDTH         (ADDR_WIDTH),
+    .TREE_INIT_FILE     (TREE_INIT_FILE),
+    .PAYLOAD_ENTRIES    (PAYLOAD_ENTRIES),
+    .PAYLOAD_ADDR_WIDTH (PAYLOAD_ADDR_WIDTH)
+) u_engine (
+    .clk              (clk),
+    .rst              (rst),
+    .market_input     (query_input),
+    .start            (query_start),
+    .action           (action),
+    .action_valid     (action_valid),
+    .payload          (payload),
+    .sw_we            (sw_we),
+    .sw_addr          (sw_addr),
+    .sw_data_is_leaf  (sw_data_is_leaf),
+    .sw_data_threshold(sw_data_threshold),
+    .sw_data_less_than(sw_data_less_than),
+    .sw_data_left_idx (sw_data_left_idx),
+    .sw_data_right_idx(sw_data_right_idx),
+    .sw_data_action   (sw_data_action),
+    .sw_payload_we    (sw_payload_we),
+    .sw_payload_addr  (sw_payload_addr),
+    .sw_payload_data  (sw_payload_data)
+);
+
+endmodule
@@ -0,0 +1,137 @@
+`timescale 1ns / 1ps
+
+// =============================================================================
+// Feed Parser — fixed-layout binary market-data stream → start/market_input
+// =============================================================================
+//
+// Input is a 64-bit stream (valid/last, AXI-Stream style), one 16-byte feed
+// message per two beats, big-endian fields:
+//
+//   beat 0  [63:56] msg_type       e.g. 'T' (0x54) trade, 'Q' (0x51) quote
+//           [55:48] flags          ignored
+//           [47:32] instrument_id
+//           [31:0]  price
+//   beat 1  [63:32] size
+//           [31:0]  seq / timestamp (ignored)
+//
+// s_tlast marks the last beat of a message; the beat counter resynchronises
+// on it, so a truncated or over-long message cannot shift later ones.
+//
+// For messages of type cfg_msg_type (and instrument cfg_instrument when
+// cfg_match_instrument is set) the configured field (cfg_field: 0 = price,
+// 1 = size) is quantised to 8 bits:
+//
+//   market_input = clamp((field - cfg_offset) >> cfg_shift, 0, 255)
+//
+// and start is issued combinationally in the cycle the beat carrying the
+// field is on the bus — price queries start with beat 0, size queries with
+// beat 1.  The engine registers market_input on that edge, so the parser
+// adds no cycles of its own.  s_tready is always high: the parser never
+// back-pressures the feed, and at most one query is issued per message.
+// =============================================================================
+
+module feed_parser (
+    input  logic         clk,
+    input  logic         rst,
+
+    // Feed stream
+    input  logic [63:0]  s_tdata,
+    input  logic         s_tvalid,
+    input  logic         s_tlast,
+    output logic         s_tready,
+
+    // Configuration (static while streaming)
+    input  logic         cfg_field,             // 0 = price, 1 = size
+    input  logic [7:0]   cfg_msg_type,
+    input  logic         cfg_match_instrument,
+    input  logic [15:0]  cfg_instrument,
+    input  logic [31:0]  cfg_offset,
+    input  logic [4:0]   cfg_shift,
+
+    // To the decision engine
+    output logic         start,
+    output logic  [7:0]  market_input,
+
+    // Statistics
+    output logic [31:0]  msg_count,             // messages seen (s_tlast beats)
+    output logic [31:0]  query_count            // queries issued
+);
+
+assign s_tready = 1'b1;
+
+// -------------------------------------------------------------------------
+// Beat tracking; header fields kept for the size beat
+// -------------------------------------------------------------------------
+logic [1:0]  beat_idx;                          // 0, 1, 2 = beat 2 or later
+logic [7:0]  hdr_type;
+logic [15:0] hdr_instrument;
+
+logic        accept;
+assign accept = s_tvalid;                       // s_tready is always high
+
+always_ff @(posedge clk or posedge rst) begin
+    if (rst) begin
+        beat_idx       <= '0;
+        hdr_type       <= '0;
+        hdr_instrument <= '0;
+    end else if (accept) begin
+        if (beat_idx == 2'd0) begin
+            hdr_type       <= s_tdata[63:56];
+            hdr_instrument <= s_tdata[47:32];
+        end
+        if (s_tlast)
+            beat_idx <= '0;
+        else if (beat_idx != 2'd2)
+            beat_idx <= beat_idx + 1'b1;
+    end
+end
+
+// -------------------------------------------------------------------------
+// Field select, filter and quantise (combinational)
+// -------------------------------------------------------------------------
+logic [7:0]  cur_type;
+logic [15:0] cur_instrument;
+logic        field_beat;
+logic [31:0] field;
+logic        match;
+
+logic [32:0] diff;
+logic [31:0] shifted;
+
+always_comb begin
+    // Beat 0 carries the header itself; beat 1 uses the registered copy
+    cur_type       = (beat_idx == 2'd0) ? s_tdata[63:56] : hdr_type;
+    cur_instrument = (beat_idx == 2'd0) ? s_tdata[47:32] : hdr_instrument;
+
+    field_beat = (cfg_field == 1'b0) ? (beat_idx == 2'd0) : (beat_idx == 2'd1);
+    field      = (cfg_field == 1'b0) ? s_tdata[31:0] : s_tdata[63:32];
+
+    match = cur_type == cfg_msg_type
+         && (!cfg_match_instrument || cur_instrument == cfg_instrument);
+
+    diff    = {1'b0, field} - {1'b0, cfg_offset};
+    shifted = diff[31:0] >> cfg_shift;
+
+    if (diff[32])                 market_input = 8'd0;      // below offset
+    else if (|shifted[31:8])      market_input = 8'd255;    // above range
+    else                          market_input = shifted[7:0];
+end
+
+// A size query needs a real beat 1: a one-beat message (s_tlast on beat 0)
+// never issues one, and beats past 1 of a long message are ignored.
+assign start = accept && field_beat && match;
+
+// -------------------------------------------------------------------------
+// Statistics
+// -------------------------------------------------------------------------
+always_ff @(posedge clk or posedge rst) begin
+    if (rst) begin
+        msg_count   <= '0;
+        query_count <= '0;
+    end else begin
+        if (accept && s_tlast) msg_count   <= msg_count + 1;
+        if (start)             query_count <= query_count + 1;
+    end
+end
+
+endmodule
@@ -0,0 +1,183 @@
+`timescale 1ns / 1ps
+
+// =============================================================================
+// Order Message Generator — action + order template → binary order message
+// =============================================================================
+//
+// Sits downstream of decision_tree_pipelined.  Every result that is not NONE
+// becomes one fixed-layout 16-byte order message, streamed out as two 64-bit
+// beats (valid/ready/last handshake, AXI-Stream style):
+//
+//   beat 0  [63:56] msg_type       'N' (0x4E) new order, 'X' (0x58) cancel
+//           [55:48] side           'B' (0x42) / 'S' (0x53) / 0x00
+//           [47:32] instrument_id
+//           [31:0]  seq_num        per message, from 0 after reset
+//   beat 1  [63:32] price          ref_price + sign-extended price_offset
+//           [31:0]  qty            zero-extended
+//
+// msg_type comes from the action (BUY/SELL → 'N', CANCEL → 'X'); side, qty
+// and price_offset come from the leaf's order template (payload), laid out
+// as {side[1:0], qty, price_offset[15:0]}: qty takes the PAYLOAD_WIDTH - 18
+// bits in between (14 at the default 32, at most 32).  The
+// instrument context (instrument_id, ref_price) is sampled with
+// action_valid.
+//
+// Timing: the message is assembled in the cycle action_valid is high and
+// beat 0 leaves on the next cycle, beat 1 (m_tlast) on the one after —
+// +1 / +2 cycles after action_valid when the output is idle and m_tready is
+// high.  Two beats per message is the minimum for 16 bytes on 64 bits.
+//
+// Back-pressure: messages that arrive while a message is on the wire wait in
+// a FIFO_DEPTH-entry FIFO.  The engine cannot be stalled, so a message that
+// finds the FIFO full is dropped and counted in `dropped`.
+// =============================================================================
+
+module order_msg_gen #(
+    parameter FIFO_DEPTH    = 8,
+    parameter PAYLOAD_WIDTH = 32
+)(
+    input  logic                     clk,
+    input  logic                     rst,
+
+    // From the decision engine
+    input  logic [1:0]               action,
+    input  logic                     action_valid,
+    input  logic [PAYLOAD_WIDTH-1:0] payload,        // {side[1:0], qty, price_offset[15:0]}
+
+    // Instrument context
+    input  logic [15:0]              instrument_id,
+    input  logic [31:0]              ref_price,
+
+    // Message stream
+    output logic [63:0]              m_tdata,
+    output logic                     m_tvalid,
+    output logic                     m_tlast,
+    input  logic                     m_tready,
+
+    // Statistics
+    output logic [31:0]              msg_count,       // messages accepted (= next seq_num)
+    output logic [31:0]              dropped          // messages lost to a full FIFO
+);
+
+localparam logic [1:0] ACT_NONE   = 2'b00;
+localparam logic [1:0] ACT_CANCEL = 2'b11;
+localparam PTR_WIDTH = (FIFO_DEPTH > 1) ? $clog2(FIFO_DEPTH) : 1;
+
+// Template fields: side on top, price_offset at the bottom, qty in between
+localparam OFFSET_W = 16;
+localparam QTY_W    = PAYLOAD_WIDTH - 2 - OFFSET_W;
+localparam SIDE_LSB = PAYLOAD_WIDTH - 2;
+
+generate
+    if (QTY_W < 1 || QTY_W > 32) begin : bad_payload_width
+        $error("order_msg_gen: PAYLOAD_WIDTH must be 19..50 ({side[1:0], qty, price_offset[15:0]})");
+    end
+endgenerate
+
+typedef struct packed {
+    logic [7:0]  msg_type;
+    logic [7:0]  side;
+    logic [15:0] instrument_id;
+    logic [31:0] seq_num;
+    logic [31:0] price;
+    logic [31:0] qty;
+} order_msg_t;
+
+// -------------------------------------------------------------------------
+// Assemble the message in the action_valid cycle
+// -------------------------------------------------------------------------
+order_msg_t new_msg;
+logic       new_valid;
+
+always_comb begin
+    new_valid             = action_valid && action != ACT_NONE;
+    new_msg.msg_type      = (action == ACT_CANCEL) ? 8'h58 : 8'h4E;
+    new_msg.side          = (payload[SIDE_LSB +: 2] == 2'd1) ? 8'h42 :
+                            (payload[SIDE_LSB +: 2] == 2'd2) ? 8'h53 : 8'h00;
+    new_msg.instrument_id = instrument_id;
+    new_msg.seq_num       = msg_count;
+    new_msg.price         = ref_price + 32'($signed(payload[OFFSET_W-1:0]));
+    new_msg.qty           = 32'(payload[OFFSET_W +: QTY_W]);
+end
+
+// -------------------------------------------------------------------------
+// Message on the wire + FIFO behind it
+// -------------------------------------------------------------------------
+order_msg_t cur;
+logic       cur_valid;
+logic       beat;                                // 0 = header beat, 1 = price/qty beat
+
+order_msg_t fifo [0:FIFO_DEPTH-1];
+logic [PTR_WIDTH-1:0] rd_ptr, wr_ptr;
+logic [PTR_WIDTH:0]   count;
+
+logic done;                                      // last beat accepted this cycle
+logic cur_free;                                  // cur can load a message at this edge
+logic fifo_empty, fifo_full;
+
+assign done       = cur_valid && beat && m_tready;
+assign cur_free   = !cur_valid || done;
+assign fifo_empty = (count == 0);
+assign fifo_full  = (count == FIFO_DEPTH);
+
+assign m_tvalid = cur_valid;
+assign m_tlast  = beat;
+assign m_tdata  = beat ? {cur.price, cur.qty}
+                       : {cur.msg_type, cur.side, cur.instrument_id, cur.seq_num};
+
+logic load_fifo;                                 // head of FIFO → cur
+logic load_new;                                  // new message straight → cur
+logic push;                                      // new message → FIFO
+
+assign load_fifo = cur_free && !fifo_empty;
+assign load_new  = cur_free && fifo_empty && new_valid;
+assign push      = new_valid && !load_new && (!fifo_full || load_fifo);
+
+always_ff @(posedge clk or posedge rst) begin
+    if (rst) begin
+        cur       <= '0;
+        cur_valid <= 1'b0;
+        beat      <= 1'b0;
+        rd_ptr    <= '0;
+        wr_ptr    <= '0;
+        count     <= '0;
+        msg_count <= '0;
+        dropped   <= '0;
+    end else begin
+        // Output side
+        if (cur_valid && !beat && m_tready)
+            beat <= 1'b1;
+
+        if (load_fifo) begin
+            cur       <= fifo[rd_ptr];
+            cur_valid <= 1'b1;
+            beat      <= 1'b0;
+            rd_ptr    <= (rd_ptr == PTR_WIDTH'(FIFO_DEPTH - 1)) ? '0 : rd_ptr + 1'b1;
+        end else if (load_new) begin
+            cur       <= new_msg;
+            cur_valid <= 1'b1;
+            beat      <= 1'b0;
+        end else if (done) begin
+            cur_valid <= 1'b0;
+            beat      <= 1'b0;
+        end
+
+        // Input side
+        if (push)
+            wr_ptr <= (wr_ptr == PTR_WIDTH'(FIFO_DEPTH - 1)) ? '0 : wr_ptr + 1'b1;
+        count <= count + {{PTR_WIDTH{1'b0}}, push} - {{PTR_WIDTH{1'b0}}, load_fifo};
+
+        if (load_new || push)
+            msg_count <= msg_count + 1;
+        else if (new_valid)
+            dropped <= dropped + 1;
+    end
+end
+
+// FIFO storage (no reset — LUTRAM)
+always_ff @(posedge clk) begin
+    if (push)
+        fifo[wr_ptr] <= new_msg;
+end
+
+endmodule
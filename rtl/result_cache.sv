@@ -0,0 +1,93 @@
+`timescale 1ns / 1ps
+
+// =============================================================================
+// Result Cache — small fully-associative (CAM) key → data memo
+// =============================================================================
+//
+// ENTRIES registers of {valid, key, data}.  A lookup compares the key against
+// every entry in parallel and returns hit/data combinationally, so a wrapper
+// can answer in the cycle after the query is registered.  Nothing about the
+// key is tabulated, so KEY_WIDTH can grow well past the point where a direct
+// 2^KEY_WIDTH result table stops being practical — cost is ENTRIES
+// comparators of KEY_WIDTH bits.
+//
+//   Fill:       writes {key, data}.  If the key is already present that entry
+//               is refreshed, otherwise the entry at the round-robin victim
+//               pointer is replaced (FIFO replacement).
+//   Invalidate: clears every valid bit in one cycle; takes priority over a
+//               fill in the same cycle.
+// =============================================================================
+
+module result_cache #(
+    parameter ENTRIES    = 8,
+    parameter KEY_WIDTH  = 8,
+    parameter DATA_WIDTH = 2
+)(
+    input  logic                  clk,
+    input  logic                  rst,
+
+    // Lookup (combinational)
+    input  logic [KEY_WIDTH-1:0]  lookup_key,
+    output logic                  lookup_hit,
+    output logic [DATA_WIDTH-1:0] lookup_data,
+
+    // Fill
+    input  logic                  fill_en,
+    input  logic [KEY_WIDTH-1:0]  fill_key,
+    input  logic [DATA_WIDTH-1:0] fill_data,
+
+    input  logic                  invalidate
+);
+
+localparam IDX_WIDTH = (ENTRIES > 1) ? $clog2(ENTRIES) : 1;
+
+logic                  entry_valid [0:ENTRIES-1];
+logic [KEY_WIDTH-1:0]  entry_key   [0:ENTRIES-1];
+logic [DATA_WIDTH-1:0] entry_data  [0:ENTRIES-1];
+
+logic [IDX_WIDTH-1:0]  victim;
+
+// -------------------------------------------------------------------------
+// Lookup and fill match — one comparator bank each
+// -------------------------------------------------------------------------
+logic                 fill_match;
+logic [IDX_WIDTH-1:0] fill_idx;
+
+always_comb begin
+    lookup_hit  = 1'b0;
+    lookup_data = '0;
+    fill_match  = 1'b0;
+    fill_idx    = victim;
+    for (int k = 0; k < ENTRIES; k++) begin
+        if (entry_valid[k] && entry_key[k] == lookup_key) begin
+            lookup_hit  = 1'b1;
+            lookup_data = entry_data[k];
+        end
+        if (entry_valid[k] && entry_key[k] == fill_key) begin
+            fill_match = 1'b1;
+            fill_idx   = IDX_WIDTH'(k);
+        end
+    end
+end
+
+always_ff @(posedge clk or posedge rst) begin
+    if (rst) begin
+        victim <= '0;
+        for (int k = 0; k < ENTRIES; k++) begin
+            entry_valid[k] <= 1'b0;
+            entry_key[k]   <= '0;
+            entry_data[k]  <= '0;
+        end
+    end else if (invalidate) begin
+        for (int k = 0; k < ENTRIES; k++)
+            entry_valid[k] <= 1'b0;
+    end else if (fill_en) begin
+        entry_valid[fill_idx] <= 1'b1;
+        entry_key[fill_idx]   <= fill_key;
+        entry_data[fill_idx]  <= fill_data;
+        if (!fill_match)
+            victim <= (victim == IDX_WIDTH'(ENTRIES - 1)) ? '0 : victim + 1'b1;
+    end
+end
+
+endmodule
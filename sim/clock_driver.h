@@ -0,0 +1,85 @@
+#pragma once
+
+#include "verilated.h"
+#include "verilated_vcd_c.h"
+#include <cstdint>
+#include <functional>
+
+// =========================================================================
+// Clock driver with idle fast-forward
+// =========================================================================
+//
+// Drives clk for a Verilated top the same way the harnesses' tick() does
+// (two evals per cycle, VCD dump on both edges, 10 time units per cycle).
+// It also tracks quiescence, so a sparse replay can jump over idle stretches
+// instead of clocking through them:
+//
+//   ClockDriver<Vtop> drv(dut, tfp, sim_time, settle, active);
+//   ...
+//   if (nothing to drive && nothing in flight && drv.quiescent())
+//       drv.skip_to(next_event_cycle);     // no evals, time still advances
+//   else
+//       drv.tick();
+//
+// active(dut) reports whether the inputs currently applied are stimulus
+// (start, a valid beat, a write, ...).  After `settle` consecutive edges
+// without stimulus every register in the design must hold its value: for
+// the pipelined engine that is MAX_DEPTH + 2 (bubbles reach the output
+// register), for the FSM engine max depth + 1 (path_valid drops).  From
+// then on further idle edges cannot change any state, so skipping them is
+// exact.  sim_time and cycle() still advance by the skipped amount, so
+// timestamps and latencies stay in wall-clock cycles.
+//
+// The VCD holds its last values across a skip; clk stops toggling there.
+// =========================================================================
+
+template <class T>
+class ClockDriver {
+public:
+    ClockDriver(T *dut, VerilatedVcdC *tfp, vluint64_t &time, int settle,
+                std::function<bool(const T *)> active)
+        : dut_(dut), tfp_(tfp), time_(time), settle_(settle), active_(active) {}
+
+    void tick() {
+        quiet_ = active_(dut_) ? 0 : (quiet_ < settle_ ? quiet_ + 1 : quiet_);
+        dut_->clk = 0; dut_->eval(); if (tfp_) tfp_->dump(time_); time_ += 5;
+        dut_->clk = 1; dut_->eval(); if (tfp_) tfp_->dump(time_); time_ += 5;
+        if (tfp_) tfp_->flush();
+        cycle_++;
+        evals_ += 2;
+    }
+
+    // No stimulus for `settle` edges: idle edges no longer change state.
+    bool quiescent() const { return quiet_ >= settle_; }
+
+    // Advances to `cycle`: jumps if the design is quiescent (and the
+    // current inputs are idle), otherwise clocks until it is.
+    void skip_to(uint64_t cycle) {
+        while (cycle_ < cycle) {
+            if (enabled_ && quiescent() && !active_(dut_)) {
+                skipped_ += cycle - cycle_;
+                time_    += 10 * (cycle - cycle_);
+                cycle_    = cycle;
+            } else {
+                tick();
+            }
+        }
+    }
+
+    void     set_fast_forward(bool on) { enabled_ = on; }
+    uint64_t cycle()   const { return cycle_; }
+    uint64_t skipped() const { return skipped_; }
+    uint64_t evals()   const { return evals_; }
+
+private:
+    T             *dut_;
+    VerilatedVcdC *tfp_;
+    vluint64_t    &time_;
+    int            settle_;
+    std::function<bool(const T *)> active_;
+    bool           enabled_ = true;
+    int            quiet_   = 0;
+    uint64_t       cycle_   = 0;
+    uint64_t       skipped_ = 0;
+    uint64_t       evals_   = 0;
+};
@@ -0,0 +1,219 @@
+#ifdef DT_SIM_PIPE
+#include "Vdecision_tree_pipelined.h"
+typedef Vdecision_tree_pipelined Dut;
+#else
+#include "Vdecision_tree.h"
+typedef Vdecision_tree Dut;
+#endif
+#include "verilated.h"
+#include "dt_sim.h"
+#include "tree_model.h"
+#include <new>
+#include <string>
+#include <vector>
+
+// =========================================================================
+// libdtsim — C API over one Verilated engine (see dt_sim.h)
+//
+// Built once per engine, like test_lockstep: -DDT_SIM_PIPE selects
+// decision_tree_pipelined (default decision_tree).  The query loop is the
+// one test_load.cpp runs for a single offered load, minus the queue: the
+// caller's arrays are the queue, and results go straight back into them.
+// =========================================================================
+
+#ifdef DT_SIM_PIPE
+static const char *ENGINE = "pipelined";
+static const int   STAGES = 6;            // MAX_DEPTH the library is built with
+static const int   SETTLE = STAGES + 3;   // idle edges until no register can change
+#else
+static const char *ENGINE = "fsm";
+static const int   SETTLE = 66;           // hop watchdog (MAX_DEPTH = 64) + 2
+#endif
+static const int   MAX_NODES = 64;
+static const int   INFLIGHT  = 64;        // >= queries one engine can hold
+
+vluint64_t sim_time = 0;
+double sc_time_stamp() { return sim_time; }
+
+struct dt_sim {
+    Dut        *dut;
+    uint64_t    cycle;
+    int         quiet;         // consecutive edges without start / sw_we
+    bool        loaded;
+    std::string error;
+};
+
+static void tick(dt_sim *s) {
+    Dut *dut = s->dut;
+    s->quiet = dut->start || dut->sw_we ? 0 : (s->quiet < SETTLE ? s->quiet + 1 : s->quiet);
+    dut->clk = 0; dut->eval(); sim_time += 5;
+    dut->clk = 1; dut->eval(); sim_time += 5;
+    s->cycle++;
+}
+
+static int fail(dt_sim *s, const std::string &why) {
+    s->error = why;
+    return -1;
+}
+
+extern "C" {
+
+const char *dt_sim_engine(void) { return ENGINE; }
+
+dt_sim *dt_sim_open(void) {
+    dt_sim *s = new (std::nothrow) dt_sim{nullptr, 0, 0, false, ""};
+    if (!s) return nullptr;
+    s->dut = new (std::nothrow) Dut;
+    if (!s->dut) {
+        delete s;
+        return nullptr;
+    }
+    Dut *dut = s->dut;
+    dut->rst   = 1;
+    dut->start = 0;
+    dut->sw_we = 0;
+    tick(s); tick(s);
+    dut->rst = 0;
+    tick(s);
+    return s;
+}
+
+void dt_sim_close(dt_sim *s) {
+    if (!s) return;
+    delete s->dut;
+    delete s;
+}
+
+int dt_sim_load_tree(dt_sim *s, const dt_node *nodes, size_t count) {
+    if (!nodes || count == 0 || count > (size_t)MAX_NODES)
+        return fail(s, "tree must have 1.." + std::to_string(MAX_NODES) + " nodes");
+
+    std::vector<Node> tree(count);
+    for (size_t i = 0; i < count; i++)
+        tree[i] = {nodes[i].is_leaf, nodes[i].threshold, nodes[i].less_than,
+                   nodes[i].left_idx, nodes[i].right_idx, nodes[i].action};
+    for (size_t i = 0; i < count; i++) {
+        const Node &n = tree[i];
+        if (n.is_leaf > 1 || n.less_than > 1 || n.action > 3)
+            return fail(s, "node " + std::to_string(i) + ": field out of range");
+        if (!n.is_leaf && (n.left_idx >= count || n.right_idx >= count))
+            return fail(s, "node " + std::to_string(i) + ": child outside the tree"
+                           " (inline leaves are not supported)");
+    }
+    if (tree_depth(tree) < 0)
+        return fail(s, "some input never reaches a leaf (cycle in tree?)");
+#ifdef DT_SIM_PIPE
+    if (tree_stages(tree) > STAGES)
+        return fail(s, "tree needs " + std::to_string(tree_stages(tree)) +
+                       " stages, engine has " + std::to_string(STAGES));
+#endif
+
+    Dut *dut = s->dut;
+    for (size_t i = 0; i < count; i++) {
+        const Node &n = tree[i];
+        dut->sw_we             = 1;
+        dut->sw_addr           = (uint32_t)i;
+        dut->sw_data_is_leaf   = n.is_leaf;
+        dut->sw_data_threshold = n.threshold;
+        dut->sw_data_less_than = n.less_than;
+        dut->sw_data_left_idx  = engine_child(n.left_idx, 6);
+        dut->sw_data_right_idx = engine_child(n.right_idx, 6);
+        dut->sw_data_action    = n.action;
+        tick(s);
+    }
+    dut->sw_we = 0;
+    tick(s);
+    s->loaded = true;
+    s->error.clear();
+    return 0;
+}
+
+int dt_sim_load_tree_file(dt_sim *s, const char *path) {
+    std::vector<Node> tree;
+    if (!read_tree_file(path, tree))
+        return fail(s, std::string("cannot read ") + path);
+    std::vector<dt_node> nodes(tree.size());
+    for (size_t i = 0; i < tree.size(); i++)
+        nodes[i] = {tree[i].is_leaf, tree[i].threshold, tree[i].less_than,
+                    tree[i].left_idx, tree[i].right_idx, tree[i].action};
+    return dt_sim_load_tree(s, nodes.data(), nodes.size());
+}
+
+int64_t dt_sim_run(dt_sim *s, const uint8_t *inputs, size_t count,
+                   const uint64_t *arrivals, uint8_t *actions, uint32_t *latencies) {
+    if (!s->loaded)
+        return fail(s, "no tree loaded");
+    if (count && (!inputs || !actions))
+        return fail(s, "inputs and actions are required");
+    for (size_t i = 1; arrivals && i < count; i++)
+        if (arrivals[i] < arrivals[i - 1])
+            return fail(s, "arrivals must be non-decreasing");
+
+    // Queries started and not yet returned, oldest first: index, arrival cycle
+    size_t   ring_idx[INFLIGHT];
+    uint64_t ring_arr[INFLIGHT];
+    int      head = 0, inflight = 0;
+
+    Dut *dut = s->dut;
+    uint64_t base  = s->cycle;
+    uint64_t last  = base;
+    uint64_t stall = 0;
+    size_t   next  = 0, done = 0;
+
+    while (done < count) {
+        uint64_t now = s->cycle - base;
+        bool arrived = next < count && (!arrivals || arrivals[next] <= now);
+
+        // Nothing to do until the next arrival: once the engine has
+        // settled, jump there without evaluating it
+        if (!arrived && inflight == 0 && next < count) {
+            dut->start = 0;
+            if (s->quiet >= SETTLE) {
+                sim_time += 10 * (base + arrivals[next] - s->cycle);
+                s->cycle = base + arrivals[next];
+            } else {
+                tick(s);
+            }
+            continue;
+        }
+
+#ifdef DT_SIM_PIPE
+        bool can = true;
+#else
+        bool can = inflight == 0;                    // one walk at a time
+#endif
+        bool go = can && arrived;
+        dut->start        = go;
+        dut->market_input = go ? inputs[next] : 0;
+        if (go) {
+            int t = (head + inflight++) % INFLIGHT;
+            ring_idx[t] = next;
+            ring_arr[t] = arrivals ? base + arrivals[next] : s->cycle;
+            next++;
+        }
+
+        tick(s);
+
+        if (dut->action_valid && inflight) {
+            size_t q = ring_idx[head];
+            actions[q] = dut->action;
+            if (latencies) latencies[q] = (uint32_t)(s->cycle - ring_arr[head]);
+            head = (head + 1) % INFLIGHT;
+            inflight--;
+            done++;
+            last  = s->cycle;
+            stall = 0;
+        } else if (inflight && ++stall > 4 * MAX_NODES) {
+            dut->start = 0;
+            return fail(s, "engine stopped returning results");
+        }
+    }
+    dut->start = 0;
+    return (int64_t)(last - base);
+}
+
+uint64_t dt_sim_cycles(const dt_sim *s) { return s->cycle; }
+
+const char *dt_sim_error(const dt_sim *s) { return s->error.c_str(); }
+
+}  // extern "C"
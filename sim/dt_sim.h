@@ -0,0 +1,91 @@
+#ifndef DT_SIM_H
+#define DT_SIM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* =========================================================================
+ * libdtsim — cycle-accurate batch simulation of a Verilated engine, C API
+ * =========================================================================
+ *
+ * One library per engine, built from sim/dt_sim.cpp:
+ *
+ *   make lib-orig   ->  build/lib_orig/libdtsim_orig.so   (decision_tree)
+ *   make lib-pipe   ->  build/lib_pipe/libdtsim_pipe.so   (decision_tree_pipelined)
+ *
+ * Both export the same symbols, so a process links one of them (or
+ * dlopen()s each with RTLD_LOCAL).  Engines are built with the default
+ * parameters: MAX_NODES = 64, pipelined MAX_DEPTH = 6, no inline leaves.
+ *
+ *   dt_sim *s = dt_sim_open();
+ *   dt_sim_load_tree_file(s, "models/test_tree.tree");
+ *   int64_t cycles = dt_sim_run(s, inputs, n, NULL, actions, latencies);
+ *   dt_sim_close(s);
+ *
+ * dt_sim_run reads the caller's input array in place and writes each
+ * result straight into the caller's output arrays, in query order: no
+ * copies, no per-batch allocation, no text in between.  Queries are
+ * started in order, each as soon as it has arrived and the engine can
+ * take it (pipelined: every cycle; FSM: when the previous walk has
+ * returned).  Latency is in cycles from arrival to action_valid, so it
+ * includes any wait for the engine:
+ *
+ *   arrivals == NULL   each query arrives when the engine can take it;
+ *                      latency is the engine's own (pipelined MAX_DEPTH + 2,
+ *                      FSM depth + 1)
+ *   arrivals != NULL   query i arrives arrivals[i] cycles after the batch
+ *                      starts (non-decreasing); idle stretches are skipped
+ *                      without evaluating the model
+ *
+ * Functions returning int give 0 on success and -1 on error, with the
+ * reason in dt_sim_error().  Handles are independent, but share
+ * Verilator's global state: drive them from one thread.
+ * ========================================================================= */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct dt_sim dt_sim;
+
+/* Same fields and order as Node in sim/tree_model.h */
+typedef struct {
+    uint8_t is_leaf;
+    uint8_t threshold;   /* leaf: payload template slot */
+    uint8_t less_than;
+    uint8_t left_idx;
+    uint8_t right_idx;
+    uint8_t action;      /* 0 NONE, 1 BUY, 2 SELL, 3 CANCEL */
+} dt_node;
+
+/* "fsm" or "pipelined" */
+const char *dt_sim_engine(void);
+
+/* New engine, held in reset for a cycle; NULL on allocation failure */
+dt_sim *dt_sim_open(void);
+void    dt_sim_close(dt_sim *s);
+
+/* Writes the tree over the sw_* port, one node per cycle.  The tree must
+ * fit the engine: <= 64 nodes, every input reaches a leaf, and for the
+ * pipelined engine <= 6 stages (tree_stages() in sim/tree_model.h). */
+int dt_sim_load_tree(dt_sim *s, const dt_node *nodes, size_t count);
+
+/* Same, from a model file (text format of models/, see tree_model.h) */
+int dt_sim_load_tree_file(dt_sim *s, const char *path);
+
+/* Runs count queries; arrivals and latencies may be NULL.  Returns the
+ * cycles from the batch start to the last result, or -1. */
+int64_t dt_sim_run(dt_sim *s, const uint8_t *inputs, size_t count,
+                   const uint64_t *arrivals, uint8_t *actions, uint32_t *latencies);
+
+/* Cycles since dt_sim_open (loads and skipped idle cycles included) */
+uint64_t dt_sim_cycles(const dt_sim *s);
+
+/* Reason for the last -1 on this handle ("" if none) */
+const char *dt_sim_error(const dt_sim *s);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DT_SIM_H */
@@ -0,0 +1,284 @@
+#pragma once
+
+#include "tree_model.h"
+
+// =========================================================================
+// Cycle-accurate C++ models of decision_tree and decision_tree_pipelined
+// =========================================================================
+//
+// Hand-written equivalents of the two engines, exact at the ports: same
+// latency per input, same action_valid timing, same response to a start
+// that overlaps a walk, to sw_we writes in flight and to reset.  They are
+// for long replays and latency studies where a Verilated model is too slow.
+// test_lockstep.cpp checks them cycle by cycle against the RTL.
+//
+// The port members carry the RTL port names, so the same driver code
+// works on a model and on a Verilated top:
+//
+//   m.start = 1; m.market_input = x; m.tick();    // one rising clk edge
+//   if (m.action_valid) ... m.action ...
+//
+// tick() samples the inputs as they were before the edge and updates the
+// registered outputs.  rst is applied on the edge.  The harnesses only
+// ever change rst between edges, so the async reset behaves the same.
+// MAX_NODES is assumed to be a power of two (as in every build here).
+// =========================================================================
+
+// Node as stored in tree_mem: child pointers in engine encoding
+// (CHILD_WIDTH bits, top bit = inline leaf when INLINE_LEAVES=1).
+struct EngineNode {
+    uint8_t  is_leaf;
+    uint8_t  threshold;
+    uint8_t  less_than;
+    uint32_t left_idx;
+    uint32_t right_idx;
+    uint8_t  action;
+};
+
+// Ports and tree memory shared by both engines
+struct EngineModelBase {
+    // Inputs
+    uint8_t  rst = 0;
+    uint8_t  market_input = 0;
+    uint8_t  start = 0;
+    uint8_t  sw_we = 0;
+    uint32_t sw_addr = 0;
+    uint8_t  sw_data_is_leaf = 0;
+    uint8_t  sw_data_threshold = 0;
+    uint8_t  sw_data_less_than = 0;
+    uint32_t sw_data_left_idx = 0;
+    uint32_t sw_data_right_idx = 0;
+    uint8_t  sw_data_action = 0;
+
+    // Outputs
+    uint8_t  action = 0;
+    uint8_t  action_valid = 0;
+
+    int      max_nodes;
+    int      addr_width;
+    int      child_width;
+    bool     inline_leaves;
+    std::vector<EngineNode> tree_mem;
+
+    EngineModelBase(int nodes, bool inl)
+        : max_nodes(nodes), addr_width(0), inline_leaves(inl) {
+        while ((1 << addr_width) < nodes) addr_width++;
+        child_width = addr_width + (inl ? 1 : 0);
+        tree_mem.assign(nodes, EngineNode{0, 0, 0, 0, 0, 0});
+    }
+
+    // Same image as TREE_INIT_FILE / write_mem_file()
+    void preload(const std::vector<Node> &tree) {
+        for (int i = 0; i < (int)tree.size() && i < max_nodes; i++) {
+            const Node &n = tree[i];
+            tree_mem[i] = {n.is_leaf, n.threshold, n.less_than,
+                           engine_child(n.left_idx, addr_width) & child_mask(),
+                           engine_child(n.right_idx, addr_width) & child_mask(),
+                           (uint8_t)(n.action & 3)};
+        }
+    }
+
+protected:
+    uint32_t addr_mask()  const { return (1u << addr_width) - 1; }
+    uint32_t child_mask() const { return (1u << child_width) - 1; }
+    bool is_inline(uint32_t child) const {
+        return inline_leaves && ((child >> (child_width - 1)) & 1);
+    }
+
+    // computed_path[j] / next_idx: the child the input takes at node j
+    uint32_t next_child(uint32_t j, uint8_t input) const {
+        const EngineNode &n = tree_mem[j & addr_mask()];
+        bool cond = n.less_than ? input < n.threshold : input > n.threshold;
+        return cond ? n.left_idx : n.right_idx;
+    }
+
+    void write_node() {
+        tree_mem[sw_addr & addr_mask()] = {
+            (uint8_t)(sw_data_is_leaf & 1), sw_data_threshold,
+            (uint8_t)(sw_data_less_than & 1),
+            sw_data_left_idx & child_mask(), sw_data_right_idx & child_mask(),
+            (uint8_t)(sw_data_action & 3)};
+    }
+};
+
+// -------------------------------------------------------------------------
+// decision_tree (FSM): latency = depth + 1 ticks, one walk at a time
+// -------------------------------------------------------------------------
+// max_depth is the RTL's MAX_DEPTH hop watchdog (default MAX_NODES): a walk
+// with no leaf after that many hops returns NONE with action_error.
+// The RTL captures a full next-pointer table path[] on start.  The model
+// keeps only the captured input and derives path[j] on demand, which is
+// exact as long as tree_mem is unchanged since the capture.  A write that
+// lands while a walk is in progress materialises the table first.
+struct FsmEngineModel : EngineModelBase {
+    uint8_t  action_error = 0;
+    uint32_t error_count = 0;       // ERROR_COUNT_WIDTH = 16, saturating
+
+    int      max_depth;
+
+    explicit FsmEngineModel(int nodes = 64, bool inl = false, int depth = 0)
+        : EngineModelBase(nodes, inl), max_depth(depth > 0 ? depth : nodes) {}
+
+    void tick() {
+        bool     capture = start;
+        uint8_t  input   = market_input;
+
+        // Traversal FSM (reads the pre-edge path table and tree_mem)
+        if (rst) {
+            action = 0;
+            action_valid = 0;
+            action_error = 0;
+            error_count = 0;
+            path_valid = false;
+            cur = 0;
+            hops = 0;
+        } else if (start) {
+            path_valid = true;
+            action_valid = 0;
+            action_error = 0;
+            cur = 0;
+            hops = 0;
+        } else if (path_valid) {
+            uint32_t pi = path(cur);
+            if (is_inline(pi)) {
+                path_valid = false;
+                action_valid = 1;
+                action = pi & 3;
+            } else if (tree_mem[pi & addr_mask()].is_leaf) {
+                path_valid = false;
+                action_valid = 1;
+                action = tree_mem[pi & addr_mask()].action;
+            } else if (hops == max_depth - 1) {
+                path_valid = false;
+                action_valid = 1;
+                action_error = 1;
+                action = 0;
+                if (error_count != 0xffff) error_count++;
+            } else {
+                cur = pi & addr_mask();
+                hops++;
+            }
+        } else {
+            action_valid = 0;
+            action_error = 0;
+        }
+
+        // path[] capture has no reset.  Both it and a table still in use
+        // after this edge see tree_mem from before this edge's write.
+        if (capture) {
+            path_input   = input;
+            materialised = false;
+        }
+        if (sw_we && path_valid && !materialised) materialise();
+        if (sw_we) write_node();
+    }
+
+private:
+    bool     path_valid   = false;
+    uint32_t cur          = 0;      // current_path_index
+    int      hops         = 0;      // hop_count
+    uint8_t  path_input   = 0;
+    bool     materialised = false;
+    std::vector<uint32_t> table;    // path[] once materialised
+
+    uint32_t path(uint32_t j) const {
+        return materialised ? table[j] : next_child(j, path_input);
+    }
+
+    void materialise() {
+        table.resize(max_nodes);
+        for (int j = 0; j < max_nodes; j++) table[j] = next_child(j, path_input);
+        materialised = true;
+    }
+};
+
+// -------------------------------------------------------------------------
+// decision_tree_pipelined: latency = MAX_DEPTH + 2 ticks, 1 result / tick
+// -------------------------------------------------------------------------
+// The stage registers live in a ring indexed by the pipeline head, so an
+// edge advances every stage by moving the head, not by copying registers.
+// Only valid, unresolved slots are evaluated.
+struct PipelinedEngineModel : EngineModelBase {
+    // Payload ports
+    uint8_t  sw_payload_we = 0;
+    uint32_t sw_payload_addr = 0;
+    uint32_t sw_payload_data = 0;
+    uint32_t payload = 0;
+
+    int      max_depth;
+    int      payload_entries;
+    int      payload_addr_width;
+    std::vector<uint32_t> payload_mem;
+
+    explicit PipelinedEngineModel(int nodes = 64, int depth = 6, bool inl = false,
+                                  int entries = 64)
+        : EngineModelBase(nodes, inl), max_depth(depth), payload_entries(entries),
+          payload_addr_width(0) {
+        while ((1 << payload_addr_width) < entries) payload_addr_width++;
+        payload_mem.assign(entries, 0);
+        ring.assign(depth + 1, Stage{});
+    }
+
+    void tick() {
+        if (rst) {
+            for (Stage &s : ring) s = Stage{};
+            action = 0;
+            action_valid = 0;
+            payload = 0;
+        } else {
+            // Output register taps stage MAX_DEPTH
+            const Stage &last = ring[stage(max_depth)];
+            action_valid = last.valid && last.resolved;
+            action       = last.resolved ? last.result : 0;
+            payload      = payload_mem[last.resolved ? last.slot : 0];
+
+            // Stage s-1 → s for every live slot, then the freed slot becomes stage 0
+            for (int s = max_depth - 1; s >= 0; s--) {
+                Stage &st = ring[stage(s)];
+                if (st.valid && !st.resolved) advance(st);
+            }
+            head = head == 0 ? max_depth : head - 1;
+            Stage &s0 = ring[stage(0)];
+            s0 = Stage{};
+            s0.valid = start;
+            s0.input = market_input;
+        }
+
+        if (sw_we) write_node();
+        if (sw_payload_we)
+            payload_mem[sw_payload_addr & ((1u << payload_addr_width) - 1)] = sw_payload_data;
+    }
+
+private:
+    struct Stage {
+        bool     valid    = false;
+        bool     resolved = false;
+        uint32_t node     = 0;
+        uint8_t  input    = 0;
+        uint8_t  result   = 0;
+        uint32_t slot     = 0;
+    };
+    std::vector<Stage> ring;
+    int head = 0;
+
+    int stage(int s) const { return (head + s) % (max_depth + 1); }
+
+    // One stage of evaluation (the generate block body)
+    void advance(Stage &st) const {
+        const EngineNode &n = tree_mem[st.node];
+        if (n.is_leaf) {
+            st.resolved = true;
+            st.result   = n.action;
+            st.slot     = n.threshold & ((1u << payload_addr_width) - 1);
+            return;
+        }
+        uint32_t next = next_child(st.node, st.input);
+        if (is_inline(next)) {
+            st.resolved = true;
+            st.result   = next & 3;
+            st.slot     = next & 3;
+        } else {
+            st.node = next & addr_mask();
+        }
+    }
+};
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+// =========================================================================
+// Binary market-data feed — message layout, quantiser model, file readers
+// =========================================================================
+//
+// One 16-byte message, big-endian, sent as two 64-bit beats (beat 0 first).
+// Mirrors rtl/feed_parser.sv:
+//
+//   bytes 0     msg_type      'T' trade, 'Q' quote, ...
+//         1     flags
+//         2-3   instrument_id
+//         4-7   price
+//         8-11  size
+//         12-15 seq
+//
+// Replay files:
+//   *.pcap  classic libpcap (µs or ns timestamps), Ethernet/IPv4/UDP; each
+//           UDP payload holds one or more back-to-back 16-byte messages
+//   other   raw concatenated 16-byte messages, no timestamps
+
+static const int FEED_MSG_BYTES = 16;
+
+struct FeedMsg {
+    uint8_t  msg_type;
+    uint8_t  flags;
+    uint16_t instrument_id;
+    uint32_t price;
+    uint32_t size;
+    uint32_t seq;
+};
+
+struct FeedConfig {
+    int      field;              // 0 = price, 1 = size
+    uint8_t  msg_type;
+    bool     match_instrument;
+    uint16_t instrument;
+    uint32_t offset;
+    int      shift;
+};
+
+static inline uint64_t feed_beat(const FeedMsg &m, int beat) {
+    if (beat == 0)
+        return ((uint64_t)m.msg_type << 56) | ((uint64_t)m.flags << 48)
+             | ((uint64_t)m.instrument_id << 32) | m.price;
+    return ((uint64_t)m.size << 32) | m.seq;
+}
+
+static inline bool feed_selected(const FeedConfig &c, const FeedMsg &m) {
+    return m.msg_type == c.msg_type && (!c.match_instrument || m.instrument_id == c.instrument);
+}
+
+// clamp((field - offset) >> shift, 0, 255) — same as the parser
+static inline uint8_t feed_quantize(const FeedConfig &c, const FeedMsg &m) {
+    uint32_t field = c.field ? m.size : m.price;
+    if (field < c.offset) return 0;
+    uint32_t q = (field - c.offset) >> c.shift;
+    return q > 255 ? 255 : (uint8_t)q;
+}
+
+static inline uint32_t rd_be(const uint8_t *p, int n) {
+    uint32_t v = 0;
+    for (int i = 0; i < n; i++) v = (v << 8) | p[i];
+    return v;
+}
+
+static inline FeedMsg feed_decode(const uint8_t *p) {
+    return {p[0], p[1], (uint16_t)rd_be(p + 2, 2), rd_be(p + 4, 4), rd_be(p + 8, 4), rd_be(p + 12, 4)};
+}
+
+// Appends every message in a UDP payload; a trailing partial message is ignored.
+static inline void feed_split(const uint8_t *p, size_t len, std::vector<FeedMsg> &out) {
+    for (size_t o = 0; o + FEED_MSG_BYTES <= len; o += FEED_MSG_BYTES)
+        out.push_back(feed_decode(p + o));
+}
+
+// A packet = the messages of one UDP datagram (or one message for raw files).
+// Returns false on a file error; non-UDP pcap records are skipped.  For a
+// pcap, ts_ns (if given) receives each packet's capture time in ns; for a
+// raw file it is left empty.
+static inline bool read_feed_file(const char *path, std::vector<std::vector<FeedMsg>> &packets,
+                                  std::vector<uint64_t> *ts_ns = nullptr) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        fprintf(stderr, "error: cannot open %s\n", path);
+        return false;
+    }
+    std::vector<uint8_t> buf;
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof chunk, f)) > 0) buf.insert(buf.end(), chunk, chunk + n);
+    fclose(f);
+
+    packets.clear();
+    if (ts_ns) ts_ns->clear();
+    uint32_t magic = buf.size() >= 4 ? (buf[0] | buf[1] << 8 | buf[2] << 16 | (uint32_t)buf[3] << 24) : 0;
+    bool le = magic == 0xa1b2c3d4 || magic == 0xa1b23c4d;
+    bool be = magic == 0xd4c3b2a1 || magic == 0x4d3cb2a1;
+    bool nano = magic == 0xa1b23c4d || magic == 0x4d3cb2a1;
+
+    if (!le && !be) {                                  // raw messages
+        for (size_t o = 0; o + FEED_MSG_BYTES <= buf.size(); o += FEED_MSG_BYTES)
+            packets.push_back({feed_decode(&buf[o])});
+        return true;
+    }
+
+    auto u32 = [&](size_t o) {
+        return le ? (uint32_t)(buf[o] | buf[o + 1] << 8 | buf[o + 2] << 16 | (uint32_t)buf[o + 3] << 24)
+                  : rd_be(&buf[o], 4);
+    };
+    uint32_t linktype = buf.size() >= 24 ? u32(20) : 0;
+    if (linktype != 1) {
+        fprintf(stderr, "error: %s: only Ethernet pcaps are supported\n", path);
+        return false;
+    }
+
+    for (size_t o = 24; o + 16 <= buf.size();) {
+        uint64_t ts     = (uint64_t)u32(o) * 1000000000ull + (uint64_t)u32(o + 4) * (nano ? 1 : 1000);
+        uint32_t caplen = u32(o + 8);
+        size_t   pkt    = o + 16;
+        o = pkt + caplen;
+        if (o > buf.size()) break;
+
+        const uint8_t *e = &buf[pkt];
+        if (caplen < 14 + 20 + 8 || rd_be(e + 12, 2) != 0x0800) continue;   // IPv4 only
+        const uint8_t *ip = e + 14;
+        size_t ihl = (ip[0] & 15) * 4;
+        if (ip[9] != 17 || caplen < 14 + ihl + 8) continue;                  // UDP only
+        const uint8_t *udp = ip + ihl;
+        size_t ulen = rd_be(udp + 4, 2);
+        size_t have = caplen - 14 - ihl;
+        if (ulen < 8) continue;
+        if (ulen > have) ulen = have;
+
+        std::vector<FeedMsg> msgs;
+        feed_split(udp + 8, ulen - 8, msgs);
+        if (msgs.empty()) continue;
+        packets.push_back(msgs);
+        if (ts_ns) ts_ns->push_back(ts);
+    }
+    return true;
+}
+
+// Writes packets as a little-endian Ethernet pcap (one UDP datagram each),
+// e.g. to turn a synthetic feed into a file other tools can replay.
+// Timestamps come from ts_ns (µs resolution) or default to 10 µs apart.
+static inline bool write_feed_pcap(const char *path, const std::vector<std::vector<FeedMsg>> &packets,
+                                   const std::vector<uint64_t> *ts_ns = nullptr) {
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        fprintf(stderr, "error: cannot create %s\n", path);
+        return false;
+    }
+    auto le32 = [&](uint32_t v) { uint8_t b[4] = {(uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24)}; fwrite(b, 1, 4, f); };
+    auto le16 = [&](uint16_t v) { uint8_t b[2] = {(uint8_t)v, (uint8_t)(v >> 8)}; fwrite(b, 1, 2, f); };
+    le32(0xa1b2c3d4); le16(2); le16(4); le32(0); le32(0); le32(65535); le32(1);
+
+    for (size_t k = 0; k < packets.size(); k++) {
+        const auto &pkt = packets[k];
+        std::vector<uint8_t> p(14 + 20 + 8, 0);
+        p[12] = 0x08;                                   // EtherType IPv4
+        p[14] = 0x45; p[14 + 8] = 64; p[14 + 9] = 17;   // IPv4, TTL, UDP
+        for (const FeedMsg &m : pkt) {
+            for (int beat = 0; beat < 2; beat++) {
+                uint64_t w = feed_beat(m, beat);
+                for (int i = 7; i >= 0; i--) p.push_back((uint8_t)(w >> (8 * i)));
+            }
+        }
+        uint16_t ip_len = (uint16_t)(p.size() - 14), udp_len = (uint16_t)(ip_len - 20);
+        p[16] = ip_len >> 8;  p[17] = ip_len & 255;
+        p[38] = udp_len >> 8; p[39] = udp_len & 255;
+        p[36] = 0x4e; p[37] = 0x20;                     // dst port 20000
+
+        uint64_t usec = ts_ns && k < ts_ns->size() ? (*ts_ns)[k] / 1000 : 10 * k;
+        le32((uint32_t)(usec / 1000000)); le32((uint32_t)(usec % 1000000));
+        le32((uint32_t)p.size()); le32((uint32_t)p.size());
+        fwrite(p.data(), 1, p.size(), f);
+    }
+    fclose(f);
+    return true;
+}
@@ -0,0 +1,43 @@
+# =============================================================================
+# Offered load vs achieved throughput and p50/p99 latency, one curve per engine
+# =============================================================================
+# Usage (after make test-load):
+#   gnuplot sim/plot_load.gp                          → load_curve.png (poisson)
+#   gnuplot -e "pattern='bursty'" sim/plot_load.gp
+#
+# Reads results_load_{orig,pipe,farm}.csv (sim/test_load.cpp); missing files
+# are skipped.  The FSM flattens out where it saturates, and its latency
+# turns from its own walk time into queueing time.
+# =============================================================================
+
+if (!exists("pattern")) pattern = 'poisson'
+if (!exists("output"))  output  = 'load_curve.png'
+
+engines = "orig pipe farm"
+titles  = "FSM pipelined farm"
+sel(e)  = sprintf("< grep ',%s,' results_load_%s.csv 2>/dev/null", pattern, e)
+
+set terminal pngcairo size 1200,500 font ",10"
+set output output
+set datafile separator ","
+set key top left
+set grid
+set multiplot layout 1,2 title sprintf("Offered load sweep — %s arrivals", pattern)
+
+set xlabel "offered load (queries / cycle)"
+set ylabel "achieved throughput (queries / cycle)"
+set xrange [0:1]
+set yrange [0:1.05]
+plot for [i=1:words(engines)] sel(word(engines, i)) using 3:4 \
+         with linespoints title word(titles, i), \
+     x with lines dashtype 2 lc rgb "gray" title "offered"
+
+set ylabel "latency, arrival → action\\_valid (cycles)"
+set logscale y
+set yrange [1:*]
+plot for [i=1:words(engines)] sel(word(engines, i)) using 3:5 \
+         with linespoints lc i title word(titles, i)." p50", \
+     for [i=1:words(engines)] sel(word(engines, i)) using 3:6 \
+         with linespoints lc i dashtype 2 title word(titles, i)." p99"
+
+unset multiplot
@@ -0,0 +1,272 @@
+#include "Vdecision_tree_cached.h"
+#include "verilated.h"
+#include "verilated_vcd_c.h"
+#include "tree_model.h"
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+// =========================================================================
+// Replay benchmark for the cached pipelined engine
+// Output: results_cached.txt
+//
+// Usage: test_cached [trace.txt]
+//
+// A trace is one market_input (0-255) per line (read_trace_file()).
+// Without one, two synthetic traces are replayed: a quiet market (slow
+// random walk, long runs of repeated inputs) and a busy one (uniform
+// random).  Each trace is replayed back to back with cache_en=0 and
+// cache_en=1; every result is matched to its query by result_input and
+// its arrival cycle, checked against the golden model, and the latency
+// distribution is reported.
+// =========================================================================
+
+static const int MAX_DEPTH = 6;
+static const int LATENCY   = MAX_DEPTH + 2;   // engine latency on a miss
+
+vluint64_t sim_time = 0;
+double sc_time_stamp() { return sim_time; }
+
+static void tick(Vdecision_tree_cached *dut, VerilatedVcdC *tfp) {
+    dut->clk = 0; dut->eval(); tfp->dump(sim_time); sim_time += 5;
+    dut->clk = 1; dut->eval(); tfp->dump(sim_time); sim_time += 5;
+    tfp->flush();
+}
+
+static void write_node(Vdecision_tree_cached *dut, VerilatedVcdC *tfp,
+                       int addr, const Node &n) {
+    dut->sw_we             = 1;
+    dut->sw_addr           = addr;
+    dut->sw_data_is_leaf   = n.is_leaf;
+    dut->sw_data_threshold = n.threshold;
+    dut->sw_data_less_than = n.less_than;
+    dut->sw_data_left_idx  = engine_child(n.left_idx, 6);
+    dut->sw_data_right_idx = engine_child(n.right_idx, 6);
+    dut->sw_data_action    = n.action;
+    tick(dut, tfp);
+    dut->sw_we = 0;
+}
+
+static void reset(Vdecision_tree_cached *dut, VerilatedVcdC *tfp) {
+    dut->rst   = 1;
+    dut->start = 0;
+    dut->sw_we = 0;
+    tick(dut, tfp); tick(dut, tfp);
+    dut->rst = 0;
+    tick(dut, tfp);
+}
+
+struct ReplayStats {
+    int      received;
+    int      correct;
+    int      matched;          // result_input + arrival cycle fit exactly one query
+    int      hits;             // result_hit as seen by the harness
+    int      hist[LATENCY + 1];
+    uint32_t hw_hits, hw_misses, hw_latency_sum;
+};
+
+// Issue one query per cycle, collect the (out-of-order) results.
+static ReplayStats replay(Vdecision_tree_cached *dut, VerilatedVcdC *tfp,
+                          const std::vector<Node> &tree,
+                          const std::vector<uint8_t> &trace, bool cache_en) {
+    ReplayStats st = {};
+    int n = (int)trace.size();
+    std::vector<bool> done(n, false);
+
+    reset(dut, tfp);   // clears the cache and the counters, tree_mem is kept
+    dut->cache_en = cache_en;
+
+    for (int c = 0; st.received < n && c < n + 4 * LATENCY; c++) {
+        dut->start        = c < n;
+        dut->market_input = c < n ? trace[c] : 0;
+        tick(dut, tfp);
+
+        if (dut->action_valid) {
+            st.received++;
+            int lat = dut->result_hit ? 1 : LATENCY;
+            int q   = c - lat + 1;          // query this result must belong to
+            if (q >= 0 && q < n && !done[q] && trace[q] == dut->result_input) {
+                done[q] = true;
+                st.matched++;
+            }
+            if (dut->action == simulate_tree(tree, dut->result_input).action)
+                st.correct++;
+            if (dut->result_hit) st.hits++;
+            st.hist[lat]++;
+        }
+    }
+    dut->start = 0;
+    tick(dut, tfp);
+
+    st.hw_hits        = dut->hit_count;
+    st.hw_misses      = dut->miss_count;
+    st.hw_latency_sum = dut->latency_sum;
+    return st;
+}
+
+static bool report(FILE *out, const char *label, int n, const ReplayStats &st) {
+    bool counters_ok = (int)st.hw_hits == st.hits
+                    && (int)(st.hw_hits + st.hw_misses) == n
+                    && st.hw_latency_sum == (uint32_t)(st.hits + (n - st.hits) * LATENCY);
+    bool ok = st.received == n && st.correct == n && st.matched == n && counters_ok;
+
+    fprintf(out, "  %-22s  received %5d / %d   correct %5d   matched %5d   %s\n",
+            label, st.received, n, st.correct, st.matched, ok ? "PASS" : "*** FAIL ***");
+    fprintf(out, "  %-22s  hit rate %5.1f%%   mean latency %5.2f cycles   (hw: %u hits, %u misses)\n",
+            "", 100.0 * st.hw_hits / (n ? n : 1),
+            (double)st.hw_latency_sum / (st.received ? st.received : 1),
+            st.hw_hits, st.hw_misses);
+    fprintf(out, "  %-22s  latency histogram:", "");
+    for (int l = 1; l <= LATENCY; l++)
+        if (st.hist[l]) fprintf(out, "  %d cyc × %d (%.1f%%)", l, st.hist[l], 100.0 * st.hist[l] / n);
+    fprintf(out, "\n\n");
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    Verilated::traceEverOn(true);
+
+    std::vector<Node> tree;
+    if (!read_tree_file("models/test_tree.tree", tree)) return 1;
+
+    // ----- Traces -----
+    struct Trace { const char *name; std::vector<uint8_t> v; };
+    std::vector<Trace> traces;
+    const char *trace_file = nullptr;
+    for (int a = 1; a < argc; a++)
+        if (argv[a][0] != '+') trace_file = argv[a];
+
+    if (trace_file) {
+        traces.push_back({trace_file, {}});
+        if (!read_trace_file(trace_file, traces.back().v)) return 1;
+    } else {
+        uint32_t lfsr = 0xACE1u;
+        auto rnd = [&]() { lfsr = lfsr * 1103515245u + 12345u; return lfsr >> 16; };
+
+        // Quiet: price drifts ±1 about 1 tick in 8
+        traces.push_back({"quiet (random walk)", {}});
+        int price = 128;
+        for (int i = 0; i < 4096; i++) {
+            uint32_t r = rnd() & 15;
+            if (r == 0 && price > 0)   price--;
+            if (r == 1 && price < 255) price++;
+            traces.back().v.push_back((uint8_t)price);
+        }
+
+        traces.push_back({"busy (uniform random)", {}});
+        for (int i = 0; i < 4096; i++)
+            traces.back().v.push_back((uint8_t)rnd());
+    }
+
+    auto *dut = new Vdecision_tree_cached;
+    auto *tfp = new VerilatedVcdC;
+    dut->trace(tfp, 99);
+    tfp->open("test_cached.vcd");
+
+    FILE *out = fopen("results_cached.txt", "w");
+
+    reset(dut, tfp);
+    for (int i = 0; i < (int)tree.size(); i++)
+        write_node(dut, tfp, i, tree[i]);
+    tick(dut, tfp);
+
+    fprintf(out, "================================================================\n");
+    fprintf(out, "  Decision Tree Test — CACHED Pipelined (MAX_DEPTH=%d)\n", MAX_DEPTH);
+    fprintf(out, "================================================================\n\n");
+    fprintf(out, "Miss latency %d cycles, hit latency 1 cycle, one query per cycle.\n\n", LATENCY);
+
+    bool all_ok = true;
+
+    // =====================================================================
+    // Replay — each trace with the cache off and on
+    // =====================================================================
+    for (const Trace &t : traces) {
+        fprintf(out, "----------------------------------------------------------------\n");
+        fprintf(out, "  Replay: %s  (%d queries)\n", t.name, (int)t.v.size());
+        fprintf(out, "----------------------------------------------------------------\n\n");
+        ReplayStats off = replay(dut, tfp, tree, t.v, false);
+        ReplayStats on  = replay(dut, tfp, tree, t.v, true);
+        all_ok &= report(out, "cache_en=0", (int)t.v.size(), off);
+        all_ok &= report(out, "cache_en=1", (int)t.v.size(), on);
+    }
+
+    // =====================================================================
+    // Invalidation — a tree write must flush every cached result
+    // =====================================================================
+    fprintf(out, "----------------------------------------------------------------\n");
+    fprintf(out, "  Invalidation  (warm cache, rewrite a leaf with a query in the\n");
+    fprintf(out, "                 same cycle, replay)\n");
+    fprintf(out, "----------------------------------------------------------------\n\n");
+
+    std::vector<Node> changed = tree;
+    int leaf = -1;
+    for (int i = 0; i < (int)changed.size() && leaf < 0; i++)
+        if (changed[i].is_leaf) leaf = i;
+    changed[leaf].action = (changed[leaf].action + 1) & 3;
+
+    // Inputs whose answer the write changes, a few of each, repeated
+    std::vector<uint8_t> affected, warm;
+    for (int i = 0; i < 256 && (int)affected.size() < 6; i++)
+        if (simulate_tree(tree, (uint8_t)i).action != simulate_tree(changed, (uint8_t)i).action)
+            affected.push_back((uint8_t)i);
+    for (int r = 0; r < 8; r++)
+        warm.insert(warm.end(), affected.begin(), affected.end());
+
+    // Driven by hand (replay() resets, which would hide a stale cache):
+    // fill the cache, write the tree while repeating a cached query in the
+    // same cycle, then query the same inputs again.
+    reset(dut, tfp);
+    dut->cache_en = 1;
+    // One query per LATENCY cycles: back to back, every cold miss pushes the
+    // query LATENCY - 1 cycles behind it down the pipeline too (collide), so
+    // a continuous warm-up would never hit.
+    for (uint8_t in : warm) {
+        dut->start        = 1;
+        dut->market_input = in;
+        tick(dut, tfp);
+        dut->start = 0;
+        for (int c = 1; c < LATENCY; c++) tick(dut, tfp);
+    }
+    uint32_t warm_hits = dut->hit_count;
+
+    int inv_received = 0, inv_correct = 0;
+    const int inv_expected = (int)warm.size() + 1;
+    auto collect = [&]() {
+        if (!dut->action_valid) return;
+        inv_received++;
+        if (dut->action == simulate_tree(changed, dut->result_input).action) inv_correct++;
+    };
+    dut->start        = 1;                               // query in the write cycle
+    dut->market_input = affected.empty() ? 0 : affected[0];
+    write_node(dut, tfp, leaf, changed[leaf]);
+    collect();
+    for (int i = 0; i < (int)warm.size() + 2 * LATENCY && inv_received < inv_expected; i++) {
+        dut->start        = i < (int)warm.size();
+        dut->market_input = i < (int)warm.size() ? warm[i] : 0;
+        tick(dut, tfp);
+        collect();
+    }
+    dut->start = 0;
+    write_node(dut, tfp, leaf, tree[leaf]);              // restore
+
+    bool inv_ok = !affected.empty() && warm_hits > 0 && inv_received == inv_expected
+               && inv_correct == inv_received;
+    all_ok &= inv_ok;
+    fprintf(out, "  Rewrote node %d action %s → %s  (%d affected inputs, %u warm hits)\n", leaf,
+            action_name(tree[leaf].action), action_name(changed[leaf].action),
+            (int)affected.size(), warm_hits);
+    fprintf(out, "  After write: received %d / %d, correct vs new tree %d   %s\n\n",
+            inv_received, inv_expected, inv_correct, inv_ok ? "PASS" : "*** FAIL ***");
+
+    fprintf(out, "================================================================\n");
+    fprintf(out, "  Summary: %s\n", all_ok ? "PASS" : "*** FAIL ***");
+    fprintf(out, "================================================================\n");
+
+    printf("Cached test complete — results written to results_cached.txt\n");
+
+    fclose(out);
+    tfp->close();
+    delete dut;
+    return all_ok ? 0 : 1;
+}
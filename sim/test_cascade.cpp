@@ -0,0 +1,231 @@
+#include "Vdecision_tree_cascade.h"
+#include "verilated.h"
+#include "verilated_vcd_c.h"
+#include "tree_model.h"
+#include <cstdio>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <vector>
+
+// =========================================================================
+// Replay harness for the cascaded (gate → deep) decision tree
+// Output: results_cascade.txt
+//
+// Usage: test_cascade [trace.txt]   (one market_input per line)
+//
+// Gate: models/gate_tree.tree (leaf action 3 = escalate), deep tree:
+// models/test_tree.tree.  Without a trace, a quiet-market trace (mean-
+// reverting walk in the NONE region with occasional jumps) and a busy
+// uniform-random trace are replayed.  Every result is matched to its query,
+// checked against the cascade golden model, and compared with the deep
+// tree alone (agreement rate).  Latency is reported per path.
+// =========================================================================
+
+static const int MAX_DEPTH    = 6;
+static const int DEEP_LATENCY = MAX_DEPTH + 2;
+static const int ESCALATE     = 3;
+
+vluint64_t sim_time = 0;
+double sc_time_stamp() { return sim_time; }
+
+static void tick(Vdecision_tree_cascade *dut, VerilatedVcdC *tfp) {
+    dut->clk = 0; dut->eval(); tfp->dump(sim_time); sim_time += 5;
+    dut->clk = 1; dut->eval(); tfp->dump(sim_time); sim_time += 5;
+    tfp->flush();
+}
+
+static void write_node(Vdecision_tree_cascade *dut, VerilatedVcdC *tfp,
+                       bool gate, int addr, const Node &n) {
+    dut->sw_we             = 1;
+    dut->sw_sel            = gate;
+    dut->sw_addr           = addr;
+    dut->sw_data_is_leaf   = n.is_leaf;
+    dut->sw_data_threshold = n.threshold;
+    dut->sw_data_less_than = n.less_than;
+    dut->sw_data_left_idx  = n.left_idx;
+    dut->sw_data_right_idx = n.right_idx;
+    dut->sw_data_action    = n.action;
+    tick(dut, tfp);
+    dut->sw_we = 0;
+}
+
+struct Pending { uint8_t input; int accept_cycle; };
+
+struct CascadeStats {
+    int received, correct, matched, agree;
+    int gate_results, deep_results;
+    int cycles;                               // first accept → last result
+    std::map<int, int> lat_gate, lat_deep;    // latency → count
+    uint32_t hw_gate, hw_deep;
+};
+
+static CascadeStats replay(Vdecision_tree_cascade *dut, VerilatedVcdC *tfp,
+                           const std::vector<Node> &gate,
+                           const std::vector<Node> &deep,
+                           const std::vector<uint8_t> &trace) {
+    CascadeStats st = {};
+    std::deque<Pending> want_gate, want_deep;   // each path returns in order
+    int n = (int)trace.size(), sent = 0, cycle = 0, first = -1, last = 0;
+
+    while (st.received < n && cycle < 64 * n + 100) {
+        bool offer  = sent < n;
+        bool accept = offer && dut->ready;
+        dut->start        = offer;
+        dut->market_input = offer ? trace[sent] : 0;
+        if (accept) {
+            uint8_t x = trace[sent++];
+            bool esc = simulate_tree(gate, x).action == ESCALATE;
+            (esc ? want_deep : want_gate).push_back({x, cycle});
+            if (first < 0) first = cycle;
+        }
+
+        tick(dut, tfp);
+        cycle++;
+
+        if (dut->action_valid) {
+            st.received++;
+            last = cycle;
+            uint8_t x    = dut->result_input;
+            bool    deep_path = dut->action_deep;
+            std::deque<Pending> &q = deep_path ? want_deep : want_gate;
+            if (!q.empty() && q.front().input == x) {
+                int lat = cycle - q.front().accept_cycle;
+                (deep_path ? st.lat_deep : st.lat_gate)[lat]++;
+                q.pop_front();
+                st.matched++;
+            }
+            SimResult g = simulate_tree(gate, x);
+            int expect  = g.action == ESCALATE ? simulate_tree(deep, x).action : g.action;
+            if (dut->action == expect) st.correct++;
+            if (dut->action == simulate_tree(deep, x).action) st.agree++;
+            (deep_path ? st.deep_results : st.gate_results)++;
+        }
+    }
+    dut->start = 0;
+
+    st.cycles  = last - first;
+    st.hw_gate = dut->gate_count;
+    st.hw_deep = dut->deep_count;
+    return st;
+}
+
+static void print_hist(FILE *out, const char *label, const std::map<int, int> &h, int total) {
+    long sum = 0;
+    int  cnt = 0, max = 0;
+    for (auto &kv : h) { sum += (long)kv.first * kv.second; cnt += kv.second; max = kv.first; }
+    fprintf(out, "    %-6s %5d (%5.1f%%)  mean %5.2f  max %2d   ", label, cnt,
+            100.0 * cnt / (total ? total : 1), cnt ? (double)sum / cnt : 0.0, max);
+    for (auto &kv : h) fprintf(out, " %d:%d", kv.first, kv.second);
+    fprintf(out, "\n");
+}
+
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    Verilated::traceEverOn(true);
+
+    std::vector<Node> gate, deep;
+    if (!read_tree_file("models/gate_tree.tree", gate)) return 1;
+    if (!read_tree_file("models/test_tree.tree", deep)) return 1;
+
+    // ----- Traces -----
+    struct Trace { const char *name; std::vector<uint8_t> v; };
+    std::vector<Trace> traces;
+    const char *trace_file = nullptr;
+    for (int a = 1; a < argc; a++)
+        if (argv[a][0] != '+') trace_file = argv[a];
+
+    if (trace_file) {
+        traces.push_back({trace_file, {}});
+        if (!read_trace_file(trace_file, traces.back().v)) return 1;
+    } else {
+        uint32_t lfsr = 0xACE1u;
+        auto rnd = [&]() { lfsr = lfsr * 1103515245u + 12345u; return lfsr >> 16; };
+
+        // Quiet: drifts back towards 224 (NONE), a jump about 1 tick in 256
+        traces.push_back({"quiet (mean-reverting walk)", {}});
+        int price = 224;
+        for (int i = 0; i < 4096; i++) {
+            uint32_t r = rnd();
+            if ((r & 255) == 0)    price = (r >> 8) & 255;
+            else if ((r & 7) == 1) price += price < 224 ? 1 : (price > 224 ? -1 : 0);
+            traces.back().v.push_back((uint8_t)price);
+        }
+
+        traces.push_back({"busy (uniform random)", {}});
+        for (int i = 0; i < 4096; i++)
+            traces.back().v.push_back((uint8_t)rnd());
+    }
+
+    auto *dut = new Vdecision_tree_cascade;
+    auto *tfp = new VerilatedVcdC;
+    dut->trace(tfp, 99);
+    tfp->open("test_cascade.vcd");
+
+    FILE *out = fopen("results_cascade.txt", "w");
+
+    // ----- Reset -----
+    dut->rst    = 1;
+    dut->start  = 0;
+    dut->sw_we  = 0;
+    dut->sw_sel = 0;
+    tick(dut, tfp); tick(dut, tfp);
+    dut->rst = 0;
+    tick(dut, tfp);
+
+    // ----- Load both trees -----
+    for (int i = 0; i < (int)gate.size(); i++) write_node(dut, tfp, true,  i, gate[i]);
+    for (int i = 0; i < (int)deep.size(); i++) write_node(dut, tfp, false, i, deep[i]);
+    tick(dut, tfp);
+
+    fprintf(out, "================================================================\n");
+    fprintf(out, "  Decision Tree Test — CASCADE (gate FSM → deep pipeline)\n");
+    fprintf(out, "================================================================\n\n");
+    fprintf(out, "Gate: models/gate_tree.tree (%d nodes, depth %d, leaf 3 = escalate)\n",
+            (int)gate.size(), tree_depth(gate));
+    fprintf(out, "Deep: models/test_tree.tree (%d nodes, depth %d, MAX_DEPTH=%d)\n",
+            (int)deep.size(), tree_depth(deep), MAX_DEPTH);
+    fprintf(out, "Deep tree alone: %d cycles for every query.\n\n", DEEP_LATENCY);
+
+    bool all_ok = true;
+
+    for (const Trace &t : traces) {
+        int n = (int)t.v.size();
+        CascadeStats st = replay(dut, tfp, gate, deep, t.v);
+        bool ok = st.received == n && st.correct == n && st.matched == n
+               && (int)st.hw_gate == st.gate_results && (int)st.hw_deep == st.deep_results;
+        all_ok &= ok;
+
+        long lat_sum = 0;
+        for (auto &kv : st.lat_gate) lat_sum += (long)kv.first * kv.second;
+        for (auto &kv : st.lat_deep) lat_sum += (long)kv.first * kv.second;
+
+        fprintf(out, "----------------------------------------------------------------\n");
+        fprintf(out, "  Replay: %s  (%d queries)\n", t.name, n);
+        fprintf(out, "----------------------------------------------------------------\n\n");
+        fprintf(out, "  Received %d, correct %d, matched %d   %s\n",
+                st.received, st.correct, st.matched, ok ? "PASS" : "*** FAIL ***");
+        fprintf(out, "  Agreement with deep tree alone: %.2f%%\n",
+                100.0 * st.agree / (st.received ? st.received : 1));
+        fprintf(out, "  Latency split (cycles, accept → action_valid):\n");
+        print_hist(out, "gate", st.lat_gate, st.received);
+        print_hist(out, "deep", st.lat_deep, st.received);
+        fprintf(out, "    mean   %.2f cycles  (deep alone: %d)\n",
+                st.matched ? (double)lat_sum / st.matched : 0.0, DEEP_LATENCY);
+        fprintf(out, "  Deep pipeline started for %.1f%% of queries\n",
+                100.0 * st.hw_deep / (n ? n : 1));
+        fprintf(out, "  Throughput: %.3f results/cycle (gate FSM bound)\n\n",
+                st.cycles ? (double)(st.received - 1) / st.cycles : 0.0);
+    }
+
+    fprintf(out, "================================================================\n");
+    fprintf(out, "  Summary: %s\n", all_ok ? "PASS" : "*** FAIL ***");
+    fprintf(out, "================================================================\n");
+
+    printf("Cascade test complete — results written to results_cascade.txt\n");
+
+    fclose(out);
+    tfp->close();
+    delete dut;
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,203 @@
+#include "Vdecision_tree_comb.h"
+#include "verilated.h"
+#include "verilated_vcd_c.h"
+#include "tree_model.h"
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+// =========================================================================
+// Test harness for the combinational engine with register cuts
+// Output: results_comb.txt
+//
+// Usage: test_comb [model.tree]   (default models/test_tree.tree)
+//
+// -DCOMB_CUT_EVERY=k must match the engine's -GCUT_EVERY=k (default 0);
+// the engine keeps the default MAX_DEPTH = 6.
+//
+//   1. all 256 inputs one at a time: action and payload match the golden
+//      model, latency MAX_DEPTH / k + 1 cycles after the start tick
+//   2. all 256 inputs back to back: one result per cycle, in order, each
+//      at the same fixed latency
+// =========================================================================
+
+#ifndef COMB_CUT_EVERY
+#define COMB_CUT_EVERY 0
+#endif
+
+static const int MAX_DEPTH = 6;
+
+vluint64_t sim_time = 0;
+double sc_time_stamp() { return sim_time; }
+
+static void tick(Vdecision_tree_comb *dut, VerilatedVcdC *tfp) {
+    dut->clk = 0; dut->eval(); tfp->dump(sim_time); sim_time += 5;
+    dut->clk = 1; dut->eval(); tfp->dump(sim_time); sim_time += 5;
+    tfp->flush();
+}
+
+static void write_node(Vdecision_tree_comb *dut, VerilatedVcdC *tfp,
+                       int addr, const Node &n) {
+    dut->sw_we             = 1;
+    dut->sw_addr           = addr;
+    dut->sw_data_is_leaf   = n.is_leaf;
+    dut->sw_data_threshold = n.threshold;
+    dut->sw_data_less_than = n.less_than;
+    dut->sw_data_left_idx  = engine_child(n.left_idx, 6);
+    dut->sw_data_right_idx = engine_child(n.right_idx, 6);
+    dut->sw_data_action    = n.action;
+    tick(dut, tfp);
+    dut->sw_we = 0;
+}
+
+// Distinct template per payload slot so a wrong slot can't go unnoticed
+static OrderTemplate slot_template(int slot) {
+    return {(uint8_t)(slot & 3), (uint16_t)(100 + 10 * slot), (int16_t)(slot - 32)};
+}
+
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    Verilated::traceEverOn(true);
+
+    const char *model = "models/test_tree.tree";
+    for (int a = 1; a < argc; a++)
+        if (argv[a][0] != '+') model = argv[a];
+
+    std::vector<Node> tree;
+    if (!read_tree_file(model, tree)) return 1;
+    if (tree_stages(tree) > MAX_DEPTH) {
+        fprintf(stderr, "error: %s needs %d levels, engine has %d\n",
+                model, tree_stages(tree), MAX_DEPTH);
+        return 1;
+    }
+
+    const int cuts    = COMB_CUT_EVERY > 0 ? MAX_DEPTH / COMB_CUT_EVERY : 0;
+    const int latency = cuts + 1;            // cycles after the start tick
+
+    auto *dut = new Vdecision_tree_comb;
+    auto *tfp = new VerilatedVcdC;
+    dut->trace(tfp, 99);
+    tfp->open("test_comb.vcd");
+
+    FILE *out = fopen("results_comb.txt", "w");
+
+    // ----- Reset, tree, order templates (PAYLOAD_ENTRIES = 64) -----
+    dut->rst   = 1;
+    dut->start = 0;
+    dut->sw_we = 0;
+    dut->sw_payload_we = 0;
+    tick(dut, tfp); tick(dut, tfp);
+    dut->rst = 0;
+    tick(dut, tfp);
+    for (int i = 0; i < (int)tree.size(); i++)
+        write_node(dut, tfp, i, tree[i]);
+    for (int k = 0; k < 64; k++) {
+        dut->sw_payload_we   = 1;
+        dut->sw_payload_addr = k;
+        dut->sw_payload_data = pack_template(slot_template(k));
+        tick(dut, tfp);
+    }
+    dut->sw_payload_we = 0;
+    tick(dut, tfp);
+
+    fprintf(out, "================================================================\n");
+    fprintf(out, "  Decision Tree Test — COMBINATIONAL (CUT_EVERY=%d)\n", COMB_CUT_EVERY);
+    fprintf(out, "================================================================\n\n");
+    fprintf(out, "Model: %s (%d nodes, %d levels)\n", model, (int)tree.size(), tree_stages(tree));
+    fprintf(out, "Levels: %d, register cuts: %d, latency %d cycles after start\n\n",
+            MAX_DEPTH, cuts, latency);
+
+    // =====================================================================
+    // 1. One at a time
+    // =====================================================================
+    fprintf(out, "----------------------------------------------------------------\n");
+    fprintf(out, "  Exhaustive Verification  (all 256 inputs, one at a time)\n");
+    fprintf(out, "----------------------------------------------------------------\n\n");
+
+    int exhaust_pass = 0, payload_pass = 0;
+    for (int inp = 0; inp < 256; inp++) {
+        SimResult sw = simulate_tree(tree, (uint8_t)inp);
+
+        dut->market_input = inp;
+        dut->start = 1;
+        tick(dut, tfp);
+        dut->start = 0;
+
+        int cycles = -1, hw_action = -1;
+        uint32_t hw_payload = 0;
+        for (int c = 1; c <= 20; c++) {
+            tick(dut, tfp);
+            if (dut->action_valid) {
+                cycles     = c;
+                hw_action  = dut->action;
+                hw_payload = dut->payload;
+                break;
+            }
+        }
+
+        if (cycles == latency && hw_action == sw.action) {
+            exhaust_pass++;
+        } else {
+            fprintf(out, "  MISMATCH input=%3d: SW=%s HW=%s after %d cycles\n",
+                    inp, action_name(sw.action),
+                    cycles > 0 ? action_name(hw_action) : "TIMEOUT", cycles);
+        }
+        uint32_t sw_payload = pack_template(slot_template(sw.slot));
+        if (cycles > 0 && hw_payload == sw_payload) {
+            payload_pass++;
+        } else {
+            fprintf(out, "  PAYLOAD MISMATCH input=%3d: slot %d expected %08x got %08x\n",
+                    inp, sw.slot, sw_payload, hw_payload);
+        }
+    }
+    fprintf(out, "  Passed: %d / 256    Payload: %d / 256\n", exhaust_pass, payload_pass);
+
+    // =====================================================================
+    // 2. Back to back
+    // =====================================================================
+    fprintf(out, "\n----------------------------------------------------------------\n");
+    fprintf(out, "  Throughput Test  (256 queries on consecutive cycles)\n");
+    fprintf(out, "----------------------------------------------------------------\n\n");
+
+    // Query q starts on tick q; its result is due on tick q + latency
+    int received = 0, in_order = 0;
+    for (int t = 0; t < 256 + latency + 4; t++) {
+        dut->start        = t < 256;
+        dut->market_input = t < 256 ? t : 0;
+        tick(dut, tfp);
+        if (!dut->action_valid) continue;
+        int q = t - latency;
+        if (q == received && q < 256 && dut->action == simulate_tree(tree, (uint8_t)q).action)
+            in_order++;
+        received++;
+    }
+    dut->start = 0;
+    bool tp_ok = received == 256 && in_order == 256;
+    fprintf(out, "  Results: %d, in order at the fixed latency and correct: %d  %s\n",
+            received, in_order, tp_ok ? "PASS" : "*** FAIL ***");
+
+    // =====================================================================
+    // Summary
+    // =====================================================================
+    bool pass = exhaust_pass == 256 && payload_pass == 256 && tp_ok;
+    fprintf(out, "\n================================================================\n");
+    fprintf(out, "  Summary\n");
+    fprintf(out, "================================================================\n");
+    fprintf(out, "  Exhaustive (0-255): %d / 256\n", exhaust_pass);
+    fprintf(out, "  Payload (0-255):    %d / 256\n", payload_pass);
+    fprintf(out, "  Back to back:       %s\n", tp_ok ? "PASS" : "*** FAIL ***");
+    fprintf(out, "  Design: %d levels, a register cut every %d (%d cuts)\n",
+            MAX_DEPTH, COMB_CUT_EVERY, cuts);
+    fprintf(out, "  Latency formula: MAX_DEPTH / CUT_EVERY + 2 cycles including start\n");
+    fprintf(out, "  Throughput: 1 result per cycle\n");
+    fprintf(out, "  Verification: C++ golden model (simulate_tree)\n");
+    fprintf(out, "================================================================\n");
+
+    printf("Comb test (CUT_EVERY=%d) %s — results written to results_comb.txt\n",
+           COMB_CUT_EVERY, pass ? "PASS" : "FAIL");
+
+    fclose(out);
+    tfp->close();
+    delete dut;
+    return pass ? 0 : 1;
+}
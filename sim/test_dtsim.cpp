@@ -0,0 +1,156 @@
+#include "dt_sim.h"
+#include "tree_model.h"
+#include "traffic.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// =========================================================================
+// libdtsim check — drives the engine only through the C API (dt_sim.h)
+// and checks the batch results against the golden model.
+//
+// Built against libdtsim_orig.so or libdtsim_pipe.so (make test-lib-orig,
+// test-lib-pipe); the engine is whichever the library reports.
+//
+// Usage: test_dtsim [--queries N]
+//
+//   1. back-to-back batch: every action matches simulate_tree(), every
+//      latency is the engine's own (pipelined MAX_DEPTH + 2, FSM depth + 1),
+//      and the batch takes the expected number of cycles
+//   2. Poisson arrivals at 20% load: same actions, and every latency is
+//      the engine's own plus the wait for the engine to take the query
+//   3. a second batch on the same handle, and a tree reload between batches
+//   4. bad trees and bad calls are refused with a reason
+// =========================================================================
+
+static int engine_latency(bool pipe, const std::vector<Node> &tree, uint8_t input) {
+    return pipe ? 6 + 2 : simulate_tree(tree, input).depth + 1;
+}
+
+static std::vector<dt_node> to_c(const std::vector<Node> &tree) {
+    std::vector<dt_node> out(tree.size());
+    for (size_t i = 0; i < tree.size(); i++)
+        out[i] = {tree[i].is_leaf, tree[i].threshold, tree[i].less_than,
+                  tree[i].left_idx, tree[i].right_idx, tree[i].action};
+    return out;
+}
+
+int main(int argc, char **argv) {
+    size_t queries = 200000;
+    for (int a = 1; a < argc; a++) {
+        if (std::string(argv[a]) == "--queries" && a + 1 < argc) queries = strtoul(argv[++a], nullptr, 10);
+    }
+
+    std::string engine = dt_sim_engine();
+    bool pipe = engine == "pipelined";
+    printf("================================================================\n");
+    printf("  libdtsim C API check (%s)\n", engine.c_str());
+    printf("================================================================\n\n");
+
+    std::vector<Node> tree;
+    if (!read_tree_file("models/test_tree.tree", tree)) return 1;
+
+    dt_sim *s = dt_sim_open();
+    if (!s || dt_sim_load_tree_file(s, "models/test_tree.tree") != 0) {
+        fprintf(stderr, "error: open/load failed: %s\n", s ? dt_sim_error(s) : "out of memory");
+        return 1;
+    }
+
+    TrafficConfig cfg = {TrafficPattern::Poisson, 0.2};
+    std::vector<Arrival> arr = make_traffic(cfg, queries);
+    std::vector<uint8_t>  inputs(queries), actions(queries);
+    std::vector<uint64_t> arrivals(queries);
+    std::vector<uint32_t> lat(queries);
+    for (size_t i = 0; i < queries; i++) {
+        inputs[i]   = arr[i].input;
+        arrivals[i] = arr[i].cycle;
+    }
+    int fails = 0;
+
+    // ----- 1. Back-to-back -----
+    int64_t cycles = dt_sim_run(s, inputs.data(), queries, nullptr, actions.data(), lat.data());
+    long bad_action = 0, bad_lat = 0;
+    int64_t expect = 0;
+    for (size_t i = 0; i < queries; i++) {
+        int l = engine_latency(pipe, tree, inputs[i]);
+        bad_action += actions[i] != simulate_tree(tree, inputs[i]).action;
+        bad_lat    += (int)lat[i] != l;
+        expect     += pipe ? (i == 0 ? l : 1) : l;
+    }
+    bool ok = cycles == expect && !bad_action && !bad_lat;
+    fails += !ok;
+    printf("  Back-to-back:   %zu queries, %lld cycles (expect %lld), %ld action / %ld latency"
+           " mismatches  %s\n", queries, (long long)cycles, (long long)expect,
+           bad_action, bad_lat, ok ? "PASS" : "*** FAIL ***");
+
+    // ----- 2. Poisson arrivals -----
+    cycles = dt_sim_run(s, inputs.data(), queries, arrivals.data(), actions.data(), lat.data());
+    bad_action = bad_lat = 0;
+    uint64_t free_at = 0, busy_until = 0, queued = 0, sum = 0;
+    for (size_t i = 0; i < queries; i++) {
+        int l = engine_latency(pipe, tree, inputs[i]);
+        bad_action += actions[i] != simulate_tree(tree, inputs[i]).action;
+        // A query starts once it has arrived and the engine can take it:
+        // pipelined, the cycle after the previous start; FSM, once the
+        // previous result is out
+        uint64_t start = std::max<uint64_t>(arrivals[i], free_at);
+        busy_until = start + l;
+        free_at    = pipe ? start + 1 : busy_until;
+        bad_lat += lat[i] != busy_until - arrivals[i];
+        queued  += start > arrivals[i];
+        sum     += lat[i];
+    }
+    ok = cycles == (int64_t)busy_until && !bad_action && !bad_lat;
+    fails += !ok;
+    printf("  Poisson 20%%:    %lld cycles, mean latency %.2f, %llu queued, %ld action / %ld"
+           " latency mismatches  %s\n", (long long)cycles, (double)sum / queries,
+           (unsigned long long)queued, bad_action, bad_lat, ok ? "PASS" : "*** FAIL ***");
+
+    // ----- 3. Reload between batches -----
+    std::vector<Node> flipped = tree;
+    for (Node &n : flipped)
+        if (n.is_leaf) n.action = 3 - n.action;
+    std::vector<dt_node> c = to_c(flipped);
+    size_t n3 = std::min<size_t>(queries, 4096);
+    ok = dt_sim_load_tree(s, c.data(), c.size()) == 0
+      && dt_sim_run(s, inputs.data(), n3, nullptr, actions.data(), nullptr) > 0;
+    for (size_t i = 0; ok && i < n3; i++)
+        ok = actions[i] == simulate_tree(flipped, inputs[i]).action;
+    fails += !ok;
+    printf("  Reload:         %zu queries on a new tree  %s\n", n3, ok ? "PASS" : "*** FAIL ***");
+
+    // ----- 4. Refusals -----
+    std::vector<dt_node> loop = to_c(tree);
+    loop[1].is_leaf = 0;                             // 1 → 3 → 1 ...
+    loop[1].left_idx = loop[1].right_idx = 3;
+    loop[3].is_leaf = 0;
+    loop[3].left_idx = loop[3].right_idx = 1;
+    std::vector<dt_node> far = to_c(tree);
+    far[0].left_idx = 200;
+    uint64_t back[2] = {5, 4};
+    struct { const char *what; bool refused; } cases[] = {
+        {"cyclic tree",            dt_sim_load_tree(s, loop.data(), loop.size()) == -1},
+        {"child outside the tree", dt_sim_load_tree(s, far.data(), far.size()) == -1},
+        {"empty tree",             dt_sim_load_tree(s, c.data(), 0) == -1},
+        {"arrivals out of order",  dt_sim_run(s, inputs.data(), 2, back, actions.data(), nullptr) == -1},
+    };
+    for (auto &k : cases) {
+        fails += !k.refused;
+        printf("  Refuses %-22s %s\n", k.what, k.refused ? "PASS" : "*** FAIL ***");
+    }
+    // The loaded tree survives refused loads
+    ok = dt_sim_run(s, inputs.data(), 16, nullptr, actions.data(), nullptr) > 0;
+    for (size_t i = 0; ok && i < 16; i++)
+        ok = actions[i] == simulate_tree(flipped, inputs[i]).action;
+    fails += !ok;
+    printf("  Tree kept after refused loads  %s\n", ok ? "PASS" : "*** FAIL ***");
+
+    printf("\n  %llu cycles on the handle\n", (unsigned long long)dt_sim_cycles(s));
+    dt_sim_close(s);
+
+    printf("\nlibdtsim test (%s) %s\n", engine.c_str(), fails ? "FAIL" : "PASS");
+    return fails ? 1 : 0;
+}
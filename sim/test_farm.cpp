@@ -0,0 +1,178 @@
+#include "Vdecision_tree_farm.h"
+#include "verilated.h"
+#include "verilated_vcd_c.h"
+#include "tree_model.h"
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+// =========================================================================
+// Test harness + throughput measurement for the FSM engine farm
+// Output: results_farm.txt, one row appended to results_farm.csv
+//
+// Build with -GNUM_CORES=M and -DFARM_CORES=M (make bench-farm sweeps 1..8).
+// =========================================================================
+
+#ifndef FARM_CORES
+#define FARM_CORES 4
+#endif
+
+vluint64_t sim_time = 0;
+double sc_time_stamp() { return sim_time; }
+
+static void tick(Vdecision_tree_farm *dut, VerilatedVcdC *tfp) {
+    dut->clk = 0; dut->eval(); tfp->dump(sim_time); sim_time += 5;
+    dut->clk = 1; dut->eval(); tfp->dump(sim_time); sim_time += 5;
+    tfp->flush();
+}
+
+static void write_node(Vdecision_tree_farm *dut, VerilatedVcdC *tfp,
+                       int addr, const Node &n) {
+    dut->sw_we             = 1;
+    dut->sw_addr           = addr;
+    dut->sw_data_is_leaf   = n.is_leaf;
+    dut->sw_data_threshold = n.threshold;
+    dut->sw_data_less_than = n.less_than;
+    dut->sw_data_left_idx  = engine_child(n.left_idx, 6);
+    dut->sw_data_right_idx = engine_child(n.right_idx, 6);
+    dut->sw_data_action    = n.action;
+    tick(dut, tfp);
+    dut->sw_we = 0;
+}
+
+struct StreamStats {
+    int    sent;
+    int    received;
+    int    correct;
+    int    cycles;          // first accepted start → last result
+    double mean_latency;    // cycles from accept to result
+    int    max_latency;
+};
+
+// Offer `inputs` back to back: a query is presented every cycle and held
+// until ready, results are collected and checked in order.
+static StreamStats run_stream(Vdecision_tree_farm *dut, VerilatedVcdC *tfp,
+                              const std::vector<Node> &tree,
+                              const std::vector<uint8_t> &inputs) {
+    StreamStats st = {0, 0, 0, 0, 0.0, 0};
+    std::vector<int> accept_cycle(inputs.size(), 0);
+    long latency_sum = 0;
+    int  cycle = 0;
+    int  first = -1, last = 0;
+
+    while (st.received < (int)inputs.size() && cycle < 64 * (int)inputs.size() + 100) {
+        bool offer  = st.sent < (int)inputs.size();
+        bool accept = offer && dut->ready;   // ready is settled from the previous edge
+        dut->start        = offer;
+        dut->market_input = offer ? inputs[st.sent] : 0;
+        if (accept) {
+            accept_cycle[st.sent] = cycle;
+            if (first < 0) first = cycle;
+            st.sent++;
+        }
+
+        tick(dut, tfp);
+        cycle++;
+
+        if (dut->action_valid) {
+            int k = st.received++;
+            if (dut->action == simulate_tree(tree, inputs[k]).action) st.correct++;
+            int lat = cycle - accept_cycle[k];
+            latency_sum += lat;
+            if (lat > st.max_latency) st.max_latency = lat;
+            last = cycle;
+        }
+    }
+    dut->start = 0;
+
+    st.cycles       = last - first;
+    st.mean_latency = st.received ? (double)latency_sum / st.received : 0.0;
+    return st;
+}
+
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    Verilated::traceEverOn(true);
+
+    auto *dut = new Vdecision_tree_farm;
+    auto *tfp = new VerilatedVcdC;
+    dut->trace(tfp, 99);
+    tfp->open("test_farm.vcd");
+
+    FILE *out = fopen("results_farm.txt", "w");
+
+    std::vector<Node> tree;
+    if (!read_tree_file("models/test_tree.tree", tree)) return 1;
+
+    // ----- Reset -----
+    dut->rst   = 1;
+    dut->start = 0;
+    dut->sw_we = 0;
+    tick(dut, tfp); tick(dut, tfp);
+    dut->rst = 0;
+    tick(dut, tfp);
+
+    // ----- Load tree (broadcast to every core) -----
+    for (int i = 0; i < (int)tree.size(); i++)
+        write_node(dut, tfp, i, tree[i]);
+    tick(dut, tfp);
+
+    fprintf(out, "================================================================\n");
+    fprintf(out, "  Decision Tree Test — FSM FARM (NUM_CORES=%d)\n", FARM_CORES);
+    fprintf(out, "================================================================\n\n");
+    fprintf(out, "Tree: models/test_tree.tree (%d nodes, max depth %d)\n\n",
+            (int)tree.size(), tree_depth(tree));
+
+    // =====================================================================
+    // Exhaustive, saturated — all 256 inputs, results must come back in order
+    // =====================================================================
+    std::vector<uint8_t> all(256);
+    for (int i = 0; i < 256; i++) all[i] = (uint8_t)i;
+    StreamStats ex = run_stream(dut, tfp, tree, all);
+
+    fprintf(out, "----------------------------------------------------------------\n");
+    fprintf(out, "  Exhaustive Verification  (256 inputs, saturated, in order)\n");
+    fprintf(out, "----------------------------------------------------------------\n\n");
+    fprintf(out, "  Received: %d / 256    Correct: %d / 256\n\n", ex.received, ex.correct);
+
+    // =====================================================================
+    // Throughput — 4096 pseudo-random inputs offered every cycle
+    // =====================================================================
+    std::vector<uint8_t> rnd(4096);
+    uint32_t lfsr = 0xACE1u;
+    for (auto &v : rnd) {
+        lfsr = lfsr * 1103515245u + 12345u;
+        v = (uint8_t)(lfsr >> 16);
+    }
+    StreamStats tp = run_stream(dut, tfp, tree, rnd);
+    double rpc = tp.cycles ? (double)(tp.received - 1) / tp.cycles : 0.0;
+
+    fprintf(out, "----------------------------------------------------------------\n");
+    fprintf(out, "  Throughput  (4096 random inputs, offered every cycle)\n");
+    fprintf(out, "----------------------------------------------------------------\n\n");
+    fprintf(out, "  Correct:        %d / %d\n", tp.correct, tp.received);
+    fprintf(out, "  Results/cycle:  %.3f   (%.2f cycles/result)\n", rpc, rpc > 0 ? 1.0 / rpc : 0.0);
+    fprintf(out, "  Latency:        mean %.2f, max %d cycles (accept → action_valid)\n",
+            tp.mean_latency, tp.max_latency);
+
+    bool ok = ex.correct == 256 && tp.correct == (int)rnd.size();
+
+    fprintf(out, "\n================================================================\n");
+    fprintf(out, "  Summary: %s   NUM_CORES=%d   %.3f results/cycle\n",
+            ok ? "PASS" : "*** FAIL ***", FARM_CORES, rpc);
+    fprintf(out, "================================================================\n");
+    fclose(out);
+
+    // One row per build for the M=1..8 sweep (LUTs come from farm_sweep.tcl)
+    FILE *csv = fopen("results_farm.csv", "a");
+    if (csv) {
+        fprintf(csv, "%d,%.4f,%.2f,%d\n", FARM_CORES, rpc, tp.mean_latency, tp.max_latency);
+        fclose(csv);
+    }
+
+    printf("Farm test (NUM_CORES=%d) %s — %.3f results/cycle\n", FARM_CORES, ok ? "PASS" : "FAIL", rpc);
+
+    tfp->close();
+    delete dut;
+    return ok ? 0 : 1;
+}
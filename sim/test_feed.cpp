@@ -0,0 +1,285 @@
+#include "Vfeed_decision_path.h"
+#include "verilated.h"
+#include "verilated_vcd_c.h"
+#include "tree_model.h"
+#include "feed_format.h"
+#include "clock_driver.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+// =========================================================================
+// Feed replay driver: binary market data → feed_parser → pipelined engine
+// Output: results_feed.txt
+//
+// Usage: test_feed [feed.pcap | feed.bin] [--field price|size] [--type T]
+//                  [--instrument N] [--offset N] [--shift N] [--gap N]
+//                  [--realtime MHZ] [--no-ff] [--save out.pcap]
+//
+// Replays a pcap (Ethernet/IPv4/UDP, 16-byte messages in each payload) or a
+// raw message file; without one, a synthetic two-instrument trade/quote feed
+// is generated.  Beats of a datagram are driven back to back, with --gap
+// idle cycles between datagrams.  Checks every query the parser issues
+// (market_input vs the quantiser model) and every decision (vs simulate_tree),
+// and reports wire-to-decision latency: first beat of the message on the bus
+// → action_valid.  --save writes the replayed feed as a pcap.
+//
+// --realtime MHZ places each datagram at its capture timestamp, with the
+// engine clocked at MHZ (the synthetic feed has sparse timestamps as well).
+// The idle stretches between datagrams are fast-forwarded by ClockDriver
+// (sim/clock_driver.h), so the run time follows the number of messages, not
+// the length of the capture.  --no-ff clocks every cycle instead; the
+// results must be identical.
+// =========================================================================
+
+static const int MAX_DEPTH = 6;
+
+vluint64_t sim_time = 0;
+double sc_time_stamp() { return sim_time; }
+
+typedef ClockDriver<Vfeed_decision_path> Driver;
+
+static void write_node(Vfeed_decision_path *dut, Driver &drv, int addr, const Node &n) {
+    dut->sw_we             = 1;
+    dut->sw_addr           = addr;
+    dut->sw_data_is_leaf   = n.is_leaf;
+    dut->sw_data_threshold = n.threshold;
+    dut->sw_data_less_than = n.less_than;
+    dut->sw_data_left_idx  = n.left_idx;
+    dut->sw_data_right_idx = n.right_idx;
+    dut->sw_data_action    = n.action;
+    drv.tick();
+    dut->sw_we = 0;
+}
+
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    Verilated::traceEverOn(true);
+
+    // ----- Options -----
+    FeedConfig cfg = {0, 'T', true, 7, 9744, 2};   // trades on instrument 7, price 9744.. → 0..255
+    int gap = 2;
+    double mhz = 0;                                   // 0 = --gap spacing
+    bool fast_forward = true;
+    const char *feed_file = nullptr;
+    const char *save_file = nullptr;
+    for (int a = 1; a < argc; a++) {
+        std::string o = argv[a];
+        bool has_val = a + 1 < argc;
+        if (o[0] == '+') continue;                               // +verilator+ args
+        else if (o == "--field" && has_val)      cfg.field = std::string(argv[++a]) == "size";
+        else if (o == "--type" && has_val)       cfg.msg_type = (uint8_t)argv[++a][0];
+        else if (o == "--instrument" && has_val) { cfg.instrument = (uint16_t)atoi(argv[++a]);
+                                                   cfg.match_instrument = cfg.instrument != 0; }
+        else if (o == "--offset" && has_val)     cfg.offset = (uint32_t)strtoul(argv[++a], nullptr, 0);
+        else if (o == "--shift" && has_val)      cfg.shift = atoi(argv[++a]);
+        else if (o == "--gap" && has_val)        gap = atoi(argv[++a]);
+        else if (o == "--save" && has_val)       save_file = argv[++a];
+        else if (o == "--realtime" && has_val)   mhz = atof(argv[++a]);
+        else if (o == "--no-ff")                 fast_forward = false;
+        else                                     feed_file = argv[a];
+    }
+
+    std::vector<Node> tree;
+    if (!read_tree_file("models/test_tree.tree", tree)) return 1;
+
+    // ----- Feed -----
+    std::vector<std::vector<FeedMsg>> packets;
+    std::vector<uint64_t> ts_ns;
+    if (feed_file) {
+        if (!read_feed_file(feed_file, packets, &ts_ns)) return 1;
+    } else {
+        uint32_t lfsr = 0xACE1u;
+        auto rnd = [&]() { lfsr = lfsr * 1103515245u + 12345u; return lfsr >> 16; };
+        uint32_t price[2] = {10000, 20000}, seq = 0;
+        uint64_t t = 0;
+        for (int p = 0; p < 512; p++) {
+            t += (rnd() & 7) ? 200 + rnd() % 2000 : 50000 + 20 * rnd();   // bursts + ms-scale lulls
+            std::vector<FeedMsg> pkt;
+            int nmsg = 1 + rnd() % 4;
+            for (int m = 0; m < nmsg; m++) {
+                int inst = rnd() & 1;
+                price[inst] += (int)(rnd() % 33) - 16;
+                pkt.push_back({(uint8_t)((rnd() & 3) ? 'Q' : 'T'), 0, (uint16_t)(inst ? 9 : 7),
+                               price[inst], 100 * (1 + rnd() % 50), seq++});
+            }
+            packets.push_back(pkt);
+            ts_ns.push_back(t);
+        }
+    }
+    if (mhz > 0 && ts_ns.size() != packets.size()) {
+        fprintf(stderr, "error: --realtime needs a timestamped feed (pcap)\n");
+        return 1;
+    }
+    if (save_file && !write_feed_pcap(save_file, packets, &ts_ns)) return 1;
+
+    auto *dut = new Vfeed_decision_path;
+    auto *tfp = new VerilatedVcdC;
+    dut->trace(tfp, 99);
+    tfp->open("test_feed.vcd");
+
+    FILE *out = fopen("results_feed.txt", "w");
+
+    // Stimulus = a valid beat or a write; cfg_* is static.  Bubbles reach the
+    // engine's output register MAX_DEPTH + 2 edges after the last start.
+    Driver drv(dut, tfp, sim_time, MAX_DEPTH + 3, [](const Vfeed_decision_path *d) {
+        return d->s_tvalid || d->sw_we || d->sw_payload_we || d->rst;
+    });
+    drv.set_fast_forward(fast_forward);
+
+    // ----- Reset + configuration -----
+    dut->rst                  = 1;
+    dut->s_tvalid             = 0;
+    dut->s_tlast              = 0;
+    dut->sw_we                = 0;
+    dut->sw_payload_we        = 0;
+    dut->cfg_field            = cfg.field;
+    dut->cfg_msg_type         = cfg.msg_type;
+    dut->cfg_match_instrument = cfg.match_instrument;
+    dut->cfg_instrument       = cfg.instrument;
+    dut->cfg_offset           = cfg.offset;
+    dut->cfg_shift            = cfg.shift;
+    drv.tick(); drv.tick();
+    dut->rst = 0;
+    drv.tick();
+
+    for (int i = 0; i < (int)tree.size(); i++) write_node(dut, drv, i, tree[i]);
+    drv.tick();
+
+    // ----- Beat schedule (absolute cycles) -----
+    // Datagram beats go back to back.  A datagram starts --gap cycles after
+    // the previous one, or at its timestamp with --realtime (never earlier
+    // than the end of the previous one).
+    struct Beat { uint64_t data; bool last; int msg; uint64_t cycle; };
+    std::vector<Beat> beats;
+    std::vector<FeedMsg> msgs;
+    uint64_t next = drv.cycle() + 1;
+    for (size_t k = 0; k < packets.size(); k++) {
+        if (mhz > 0) {
+            uint64_t dt = ts_ns[k] > ts_ns[0] ? ts_ns[k] - ts_ns[0] : 0;
+            uint64_t at = drv.cycle() + 1 + (uint64_t)(dt * mhz / 1000.0);
+            if (at > next) next = at;
+        }
+        for (const FeedMsg &m : packets[k]) {
+            int id = (int)msgs.size();
+            msgs.push_back(m);
+            beats.push_back({feed_beat(m, 0), false, id, next++});
+            beats.push_back({feed_beat(m, 1), true,  id, next++});
+        }
+        if (mhz <= 0) next += gap;
+    }
+    uint64_t replay_start = drv.cycle();
+
+    // ----- Replay -----
+    struct Query { uint8_t input; uint64_t first_beat_cycle; uint64_t start_cycle; };
+    std::deque<Query> pending;
+    std::vector<uint64_t> first_beat(msgs.size(), 0);
+    std::map<int, int> lat_wire, lat_field;
+    int queries = 0, parse_ok = 0, decided = 0, correct = 0;
+    uint64_t end_cycle = beats.empty() ? drv.cycle() : beats.back().cycle;
+    auto wall_start = std::chrono::steady_clock::now();
+
+    for (size_t b = 0; b < beats.size() || (!pending.empty() && drv.cycle() < end_cycle + 64);) {
+        uint64_t cycle = drv.cycle();
+        bool drive = b < beats.size() && beats[b].cycle == cycle;
+        dut->s_tvalid = drive;
+        dut->s_tdata  = drive ? beats[b].data : 0;
+        dut->s_tlast  = drive && beats[b].last;
+        dut->eval();                                   // settle the parser's combinational start
+
+        // Decision for an earlier query (registered output)
+        if (dut->action_valid && !pending.empty()) {
+            Query q = pending.front();
+            pending.pop_front();
+            decided++;
+            if (dut->action == simulate_tree(tree, q.input).action) correct++;
+            lat_wire[(int)(cycle - q.first_beat_cycle)]++;
+            lat_field[(int)(cycle - q.start_cycle)]++;
+        }
+
+        if (drive) {
+            int id    = beats[b].msg;
+            bool beat0 = !beats[b].last;
+            if (beat0) first_beat[id] = cycle;
+            const FeedMsg &m = msgs[id];
+            bool field_beat = cfg.field ? !beat0 : beat0;
+            if (field_beat && feed_selected(cfg, m)) {
+                queries++;
+                uint8_t want = feed_quantize(cfg, m);
+                if (dut->query_start && dut->query_input == want) parse_ok++;
+                pending.push_back({want, first_beat[id], cycle});
+            } else if (dut->query_start) {
+                fprintf(out, "  UNEXPECTED start on message %d beat %d\n", id, beat0 ? 0 : 1);
+            }
+        }
+        if (drive) b++;
+
+        // Nothing on the wire until the next datagram and nothing in flight:
+        // jump there (ClockDriver clocks on until the engine has drained).
+        if (!drive && pending.empty() && b < beats.size() && beats[b].cycle > cycle + 1)
+            drv.skip_to(beats[b].cycle);
+        else
+            drv.tick();
+    }
+    dut->s_tvalid = 0;
+    std::chrono::duration<double> wall = std::chrono::steady_clock::now() - wall_start;
+    uint64_t replay_cycles = drv.cycle() - replay_start;
+
+    bool ok = parse_ok == queries && decided == queries && correct == queries
+           && dut->query_count == (uint32_t)queries && dut->msg_count == (uint32_t)msgs.size();
+
+    auto print_hist = [&](const char *label, const std::map<int, int> &h) {
+        long sum = 0; int cnt = 0;
+        for (auto &kv : h) { sum += (long)kv.first * kv.second; cnt += kv.second; }
+        fprintf(out, "  %-28s mean %.2f cycles   ", label, cnt ? (double)sum / cnt : 0.0);
+        for (auto &kv : h) fprintf(out, " %d:%d", kv.first, kv.second);
+        fprintf(out, "\n");
+    };
+
+    fprintf(out, "================================================================\n");
+    fprintf(out, "  Feed Replay Test — feed_parser → pipelined engine (MAX_DEPTH=%d)\n", MAX_DEPTH);
+    fprintf(out, "================================================================\n\n");
+    fprintf(out, "Feed: %s (%d datagrams, %d messages), ", feed_file ? feed_file : "synthetic",
+            (int)packets.size(), (int)msgs.size());
+    if (mhz > 0)
+        fprintf(out, "timestamps at %.0f MHz (%.3f ms of feed)\n", mhz,
+                packets.empty() ? 0.0 : (ts_ns.back() - ts_ns.front()) / 1e6);
+    else
+        fprintf(out, "%d idle cycles between datagrams\n", gap);
+    fprintf(out, "Query: %s of '%c' messages%s, market_input = clamp((field - %u) >> %d)\n\n",
+            cfg.field ? "size" : "price", cfg.msg_type,
+            cfg.match_instrument ? (" on instrument " + std::to_string(cfg.instrument)).c_str() : "",
+            cfg.offset, cfg.shift);
+
+    fprintf(out, "  Messages parsed:   %u / %d\n", dut->msg_count, (int)msgs.size());
+    fprintf(out, "  Queries issued:    %u (expected %d), market_input correct %d\n",
+            dut->query_count, queries, parse_ok);
+    fprintf(out, "  Decisions:         %d, correct vs golden model %d\n\n", decided, correct);
+    fprintf(out, "  Latency (cycles → action_valid):\n");
+    print_hist("first beat of message:", lat_wire);
+    print_hist("field beat (parser start):", lat_field);
+
+    fprintf(out, "\n  Simulation (%s):\n", fast_forward ? "idle fast-forward" : "every cycle clocked");
+    fprintf(out, "    Replay cycles:     %llu simulated, %llu clocked, %llu skipped\n",
+            (unsigned long long)replay_cycles, (unsigned long long)(replay_cycles - drv.skipped()),
+            (unsigned long long)drv.skipped());
+    fprintf(out, "    eval() calls:      %llu total\n", (unsigned long long)drv.evals());
+    fprintf(out, "    Wall time:         %.3f s\n", wall.count());
+
+    fprintf(out, "\n================================================================\n");
+    fprintf(out, "  Summary: %s\n", ok ? "PASS" : "*** FAIL ***");
+    fprintf(out, "================================================================\n");
+
+    printf("Feed test complete — results written to results_feed.txt\n");
+
+    fclose(out);
+    tfp->close();
+    delete dut;
+    return ok ? 0 : 1;
+}
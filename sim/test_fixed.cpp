@@ -0,0 +1,166 @@
+#include "Vdecision_tree_fixed.h"
+#include "verilated.h"
+#include "verilated_vcd_c.h"
+#include "tree_model.h"
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+// =========================================================================
+// Equivalence test for the GENERATED fixed-model engine (tools/tree2sv)
+// Output: results_fixed.txt
+//
+// Usage: test_fixed [model.tree]   (default models/test_tree.tree — must be
+//        the model the module was generated from)
+// =========================================================================
+
+vluint64_t sim_time = 0;
+double sc_time_stamp() { return sim_time; }
+
+static void tick(Vdecision_tree_fixed *dut, VerilatedVcdC *tfp) {
+    dut->clk = 0; dut->eval(); tfp->dump(sim_time); sim_time += 5;
+    dut->clk = 1; dut->eval(); tfp->dump(sim_time); sim_time += 5;
+    tfp->flush();
+}
+
+// Distinct order template per payload slot (the payload RAM stays programmable)
+static OrderTemplate slot_template(int slot) {
+    return {(uint8_t)(slot & 3), (uint16_t)(100 + 10 * slot), (int16_t)(slot - 32)};
+}
+
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    Verilated::traceEverOn(true);
+
+    const char *model = "models/test_tree.tree";
+    for (int a = 1; a < argc; a++)
+        if (argv[a][0] != '+') model = argv[a];   // skip +verilator+ args
+
+    std::vector<Node> tree;
+    if (!read_tree_file(model, tree)) return 1;
+
+    auto *dut = new Vdecision_tree_fixed;
+    auto *tfp = new VerilatedVcdC;
+    dut->trace(tfp, 99);
+    tfp->open("test_fixed.vcd");
+
+    FILE *out = fopen("results_fixed.txt", "w");
+
+    // ----- Reset (no tree load — the model is hard-wired) -----
+    dut->rst   = 1;
+    dut->start = 0;
+    dut->sw_we = 0;
+    tick(dut, tfp); tick(dut, tfp);
+    dut->rst = 0;
+    tick(dut, tfp);
+
+    for (int k = 0; k < 64; k++) {
+        dut->sw_payload_we   = 1;
+        dut->sw_payload_addr = k;
+        dut->sw_payload_data = pack_template(slot_template(k));
+        tick(dut, tfp);
+    }
+    dut->sw_payload_we = 0;
+
+    fprintf(out, "================================================================\n");
+    fprintf(out, "  Decision Tree Test — FIXED-MODEL engine (generated by tree2sv)\n");
+    fprintf(out, "================================================================\n\n");
+    fprintf(out, "Model: %s  (%d nodes, depth %d)\n\n", model, (int)tree.size(), tree_depth(tree));
+
+    // =====================================================================
+    // Exhaustive, one query at a time — checks action and fixed latency
+    // =====================================================================
+    fprintf(out, "----------------------------------------------------------------\n");
+    fprintf(out, "  Exhaustive Verification  (all 256 inputs vs C++ golden model)\n");
+    fprintf(out, "----------------------------------------------------------------\n\n");
+
+    int exhaust_pass = 0;
+    int exhaust_fail = 0;
+    int latency      = -1;   // must be identical for every input
+    bool latency_ok  = true;
+    int payload_fail = 0;
+
+    for (int inp = 0; inp < 256; inp++) {
+        SimResult sw = simulate_tree(tree, (uint8_t)inp);
+
+        dut->market_input = inp;
+        dut->start = 1;
+        tick(dut, tfp);
+        dut->start = 0;
+
+        int hw_action = -1;
+        int cycles    = 0;
+        bool got      = false;
+        for (int c = 0; c < 20; c++) {
+            tick(dut, tfp);
+            cycles++;
+            if (dut->action_valid) {
+                hw_action = dut->action;
+                if (dut->payload != pack_template(slot_template(sw.slot))) payload_fail++;
+                got = true;
+                break;
+            }
+        }
+
+        tick(dut, tfp); tick(dut, tfp);
+
+        if (got) {
+            if (latency < 0) latency = cycles;
+            if (cycles != latency) latency_ok = false;
+        }
+
+        if (got && hw_action == sw.action) {
+            exhaust_pass++;
+        } else {
+            exhaust_fail++;
+            fprintf(out, "  MISMATCH input=%3d: SW=%s HW=%s\n",
+                    inp, action_name(sw.action),
+                    got ? action_name(hw_action) : "TIMEOUT");
+        }
+    }
+
+    if (exhaust_fail == 0)
+        fprintf(out, "  All 256 inputs match the golden model.\n");
+    fprintf(out, "  Passed: %d / 256    Failed: %d / 256\n", exhaust_pass, exhaust_fail);
+    fprintf(out, "  Payload: %d / 256 match the leaf's order template\n", 256 - payload_fail);
+    fprintf(out, "  Latency: %d cycles after start %s\n", latency,
+            latency_ok ? "(fixed, all inputs)" : "*** VARIES ***");
+
+    // =====================================================================
+    // Streaming — all 256 inputs back to back, results must come out in order
+    // =====================================================================
+    fprintf(out, "\n----------------------------------------------------------------\n");
+    fprintf(out, "  Streaming Verification  (256 inputs on consecutive cycles)\n");
+    fprintf(out, "----------------------------------------------------------------\n\n");
+
+    int received    = 0;
+    int stream_pass = 0;
+    for (int c = 0; c < 256 + 30 && received < 256; c++) {
+        dut->start        = c < 256;
+        dut->market_input = c < 256 ? c : 0;
+        tick(dut, tfp);
+        if (dut->action_valid) {
+            if (dut->action == simulate_tree(tree, (uint8_t)received).action)
+                stream_pass++;
+            else
+                fprintf(out, "  MISMATCH input=%3d (stream)\n", received);
+            received++;
+        }
+    }
+    dut->start = 0;
+    fprintf(out, "  Received: %d / 256    Correct: %d / 256\n", received, stream_pass);
+
+    bool ok = exhaust_fail == 0 && payload_fail == 0 && latency_ok && stream_pass == 256;
+
+    fprintf(out, "\n================================================================\n");
+    fprintf(out, "  Summary: %s\n", ok ? "EQUIVALENT to simulate_tree" : "*** NOT EQUIVALENT ***");
+    fprintf(out, "================================================================\n");
+
+    printf("Fixed-model test complete — %s — results written to results_fixed.txt\n",
+           ok ? "PASS" : "FAIL");
+
+    fclose(out);
+    tfp->close();
+    delete dut;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,183 @@
+#include "Vdecision_tree_implicit.h"
+#include "verilated.h"
+#include "verilated_vcd_c.h"
+#include "tree_model.h"
+#include "tree_implicit.h"
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+// =========================================================================
+// Test harness for the implicit-indexed (complete tree) engine
+// Output: results_implicit.txt
+//
+// Usage: test_implicit [model.tree]   (default models/test_tree.tree)
+//
+// -DIMPLICIT_MAX_DEPTH=N must match the engine's -GMAX_DEPTH=N (default 6).
+//
+//   1. the model is padded to a complete tree (to_implicit) and the padded
+//      tree is checked against simulate_tree() on all 256 inputs
+//   2. all 256 inputs one at a time: action matches, latency MAX_DEPTH + 1
+//      cycles after the start tick
+//   3. all 256 inputs back to back: one result per cycle, in order
+// =========================================================================
+
+#ifndef IMPLICIT_MAX_DEPTH
+#define IMPLICIT_MAX_DEPTH 6
+#endif
+
+vluint64_t sim_time = 0;
+double sc_time_stamp() { return sim_time; }
+
+static void tick(Vdecision_tree_implicit *dut, VerilatedVcdC *tfp) {
+    dut->clk = 0; dut->eval(); tfp->dump(sim_time); sim_time += 5;
+    dut->clk = 1; dut->eval(); tfp->dump(sim_time); sim_time += 5;
+    tfp->flush();
+}
+
+// Splits in BFS order, then leaves left to right — one write per cycle
+static void load_implicit(Vdecision_tree_implicit *dut, VerilatedVcdC *tfp, const ImplicitTree &t) {
+    int splits = (int)t.threshold.size();
+    for (int a = 0; a < splits + (int)t.action.size(); a++) {
+        dut->sw_we             = 1;
+        dut->sw_addr           = a;
+        dut->sw_data_threshold = a < splits ? t.threshold[a] : 0;
+        dut->sw_data_less_than = a < splits ? t.less_than[a] : 0;
+        dut->sw_data_action    = a < splits ? 0 : t.action[a - splits];
+        tick(dut, tfp);
+    }
+    dut->sw_we = 0;
+    tick(dut, tfp);
+}
+
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    Verilated::traceEverOn(true);
+
+    const char *model = "models/test_tree.tree";
+    for (int a = 1; a < argc; a++)
+        if (argv[a][0] != '+') model = argv[a];
+
+    std::vector<Node> tree;
+    if (!read_tree_file(model, tree)) return 1;
+
+    ImplicitTree imp;
+    if (!to_implicit(tree, IMPLICIT_MAX_DEPTH, imp)) {
+        fprintf(stderr, "error: %s does not fit a complete tree of depth %d"
+                        " (deepest leaf %d)\n", model, IMPLICIT_MAX_DEPTH, tree_depth(tree));
+        return 1;
+    }
+    const int latency = IMPLICIT_MAX_DEPTH + 1;   // cycles after the start tick
+
+    auto *dut = new Vdecision_tree_implicit;
+    auto *tfp = new VerilatedVcdC;
+    dut->trace(tfp, 99);
+    tfp->open("test_implicit.vcd");
+
+    FILE *out = fopen("results_implicit.txt", "w");
+
+    dut->rst   = 1;
+    dut->start = 0;
+    dut->sw_we = 0;
+    tick(dut, tfp); tick(dut, tfp);
+    dut->rst = 0;
+    tick(dut, tfp);
+    load_implicit(dut, tfp, imp);
+
+    int used = 0;
+    for (const Node &n : tree) used += n.is_leaf ? 0 : 1;
+    fprintf(out, "================================================================\n");
+    fprintf(out, "  Decision Tree Test — IMPLICIT (complete tree, MAX_DEPTH=%d)\n", IMPLICIT_MAX_DEPTH);
+    fprintf(out, "================================================================\n\n");
+    fprintf(out, "Model: %s (%d nodes, %d splits, deepest leaf %d)\n",
+            model, (int)tree.size(), used, tree_depth(tree));
+    fprintf(out, "Padded: %d splits + %d leaves\n", (int)imp.threshold.size(), (int)imp.action.size());
+    fprintf(out, "Storage: %d bits implicit vs %d bits as 64 x 24-bit node_t\n",
+            implicit_bits(imp), 64 * 24);
+    fprintf(out, "Latency: %d cycles after start\n\n", latency);
+
+    // =====================================================================
+    // 1. Padding
+    // =====================================================================
+    int pad_pass = 0;
+    for (int inp = 0; inp < 256; inp++)
+        pad_pass += implicit_action(imp, (uint8_t)inp) == simulate_tree(tree, (uint8_t)inp).action;
+    fprintf(out, "  Padded tree vs simulate_tree: %d / 256\n", pad_pass);
+
+    // =====================================================================
+    // 2. One at a time
+    // =====================================================================
+    fprintf(out, "\n----------------------------------------------------------------\n");
+    fprintf(out, "  Exhaustive Verification  (all 256 inputs, one at a time)\n");
+    fprintf(out, "----------------------------------------------------------------\n\n");
+
+    int exhaust_pass = 0;
+    for (int inp = 0; inp < 256; inp++) {
+        SimResult sw = simulate_tree(tree, (uint8_t)inp);
+
+        dut->market_input = inp;
+        dut->start = 1;
+        tick(dut, tfp);
+        dut->start = 0;
+
+        int cycles = -1, hw_action = -1;
+        for (int c = 1; c <= 20; c++) {
+            tick(dut, tfp);
+            if (dut->action_valid) {
+                cycles    = c;
+                hw_action = dut->action;
+                break;
+            }
+        }
+        if (cycles == latency && hw_action == sw.action) {
+            exhaust_pass++;
+        } else {
+            fprintf(out, "  MISMATCH input=%3d: SW=%s HW=%s after %d cycles\n",
+                    inp, action_name(sw.action),
+                    cycles > 0 ? action_name(hw_action) : "TIMEOUT", cycles);
+        }
+    }
+    fprintf(out, "  Passed: %d / 256\n", exhaust_pass);
+
+    // =====================================================================
+    // 3. Back to back
+    // =====================================================================
+    int received = 0, in_order = 0;
+    for (int t = 0; t < 256 + latency + 4; t++) {
+        dut->start        = t < 256;
+        dut->market_input = t < 256 ? t : 0;
+        tick(dut, tfp);
+        if (!dut->action_valid) continue;
+        int q = t - latency;
+        if (q == received && q < 256 && dut->action == simulate_tree(tree, (uint8_t)q).action)
+            in_order++;
+        received++;
+    }
+    dut->start = 0;
+    bool tp_ok = received == 256 && in_order == 256;
+    fprintf(out, "\n  Back to back: %d results, %d in order at the fixed latency  %s\n",
+            received, in_order, tp_ok ? "PASS" : "*** FAIL ***");
+
+    // =====================================================================
+    // Summary
+    // =====================================================================
+    bool pass = pad_pass == 256 && exhaust_pass == 256 && tp_ok;
+    fprintf(out, "\n================================================================\n");
+    fprintf(out, "  Summary\n");
+    fprintf(out, "================================================================\n");
+    fprintf(out, "  Padding (0-255):    %d / 256\n", pad_pass);
+    fprintf(out, "  Exhaustive (0-255): %d / 256\n", exhaust_pass);
+    fprintf(out, "  Back to back:       %s\n", tp_ok ? "PASS" : "*** FAIL ***");
+    fprintf(out, "  Design: complete tree, one split memory per level\n");
+    fprintf(out, "  Latency formula: MAX_DEPTH + 2 cycles including start (fixed)\n");
+    fprintf(out, "  Throughput: 1 result per cycle\n");
+    fprintf(out, "  Verification: C++ golden model (simulate_tree)\n");
+    fprintf(out, "================================================================\n");
+
+    printf("Implicit test %s — results written to results_implicit.txt\n", pass ? "PASS" : "FAIL");
+
+    fclose(out);
+    tfp->close();
+    delete dut;
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,272 @@
+#include "Vdecision_tree_jump.h"
+#include "verilated.h"
+#include "verilated_vcd_c.h"
+#include "tree_model.h"
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+// =========================================================================
+// Test harness for the pointer-doubling (jump) FSM engine
+// Output: results_jump.txt
+//
+// Usage: test_jump [model.tree]   (default models/test_tree.tree)
+//
+// -DJUMP_MAX_DEPTH=N must match the engine's -GMAX_DEPTH=N (default 8);
+// -DINLINE_LEAVES pairs with -GINLINE_LEAVES=1 and folds the model first.
+//
+//   1. all 256 inputs: action matches simulate_tree(), no action_error,
+//      latency ROUNDS = clog2(MAX_DEPTH) cycles after the start tick for
+//      every depth (reported next to the linear walk's depth cycles)
+//   2. depth limit: a chain with its deepest leaf at exactly 2^ROUNDS
+//      resolves, one hop deeper aborts with action_error
+//   3. watchdog: a cyclic image aborts at the same fixed latency, then a
+//      repaired tree answers normally
+//   4. a start during a walk restarts it with the new input
+// =========================================================================
+
+#ifndef JUMP_MAX_DEPTH
+#define JUMP_MAX_DEPTH 8
+#endif
+
+vluint64_t sim_time = 0;
+double sc_time_stamp() { return sim_time; }
+
+static void tick(Vdecision_tree_jump *dut, VerilatedVcdC *tfp) {
+    dut->clk = 0; dut->eval(); tfp->dump(sim_time); sim_time += 5;
+    dut->clk = 1; dut->eval(); tfp->dump(sim_time); sim_time += 5;
+    tfp->flush();
+}
+
+static void write_node(Vdecision_tree_jump *dut, VerilatedVcdC *tfp,
+                       int addr, const Node &n) {
+    dut->sw_we             = 1;
+    dut->sw_addr           = addr;
+    dut->sw_data_is_leaf   = n.is_leaf;
+    dut->sw_data_threshold = n.threshold;
+    dut->sw_data_less_than = n.less_than;
+    dut->sw_data_left_idx  = engine_child(n.left_idx, 6);
+    dut->sw_data_right_idx = engine_child(n.right_idx, 6);
+    dut->sw_data_action    = n.action;
+    tick(dut, tfp);
+    dut->sw_we = 0;
+}
+
+static void load_tree(Vdecision_tree_jump *dut, VerilatedVcdC *tfp, const std::vector<Node> &tree) {
+    for (int i = 0; i < (int)tree.size(); i++) write_node(dut, tfp, i, tree[i]);
+    tick(dut, tfp);
+}
+
+struct Result {
+    int  cycles;     // after the start tick, -1 = timeout
+    int  action;
+    bool error;
+};
+
+static Result run_query(Vdecision_tree_jump *dut, VerilatedVcdC *tfp, uint8_t input) {
+    dut->market_input = input;
+    dut->start = 1;
+    tick(dut, tfp);
+    dut->start = 0;
+    for (int c = 1; c <= 80; c++) {
+        tick(dut, tfp);
+        if (dut->action_valid) return {c, dut->action, dut->action_error != 0};
+    }
+    return {-1, -1, false};
+}
+
+// Caterpillar: internal node k (at index 2k) sends input < k + 1 to a leaf,
+// anything else on down; input 255 ends at the leaf at depth `depth`.
+static std::vector<Node> chain_tree(int depth) {
+    std::vector<Node> t;
+    for (int k = 0; k < depth; k++) {
+        t.push_back({0, (uint8_t)(k + 1), 1, (uint8_t)(2 * k + 1), (uint8_t)(2 * k + 2), 0});
+        t.push_back({1, 0, 0, 0, 0, (uint8_t)(k & 3)});
+    }
+    t.push_back({1, 0, 0, 0, 0, 3});
+    return t;
+}
+
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    Verilated::traceEverOn(true);
+
+    const char *model = "models/test_tree.tree";
+    for (int a = 1; a < argc; a++)
+        if (argv[a][0] != '+') model = argv[a];
+
+    int rounds = 1;
+    while ((1 << rounds) < JUMP_MAX_DEPTH) rounds++;
+    int reach = 1 << rounds;                 // deepest leaf that resolves
+
+#ifdef INLINE_LEAVES
+    const bool INLINE = true;
+#else
+    const bool INLINE = false;
+#endif
+
+    std::vector<Node> tree;
+    if (!read_tree_file(model, tree)) return 1;
+    if (INLINE) tree = inline_leaves(tree);
+
+    auto *dut = new Vdecision_tree_jump;
+    auto *tfp = new VerilatedVcdC;
+    dut->trace(tfp, 99);
+    tfp->open("test_jump.vcd");
+
+    FILE *out = fopen("results_jump.txt", "w");
+
+    // ----- Reset -----
+    dut->rst   = 1;
+    dut->start = 0;
+    dut->sw_we = 0;
+    tick(dut, tfp); tick(dut, tfp);
+    dut->rst = 0;
+    tick(dut, tfp);
+    load_tree(dut, tfp, tree);
+
+    fprintf(out, "================================================================\n");
+    fprintf(out, "  Decision Tree Test — JUMP (pointer-doubling FSM)%s\n", INLINE ? ", INLINE_LEAVES=1" : "");
+    fprintf(out, "================================================================\n\n");
+    fprintf(out, "Model: %s (%d nodes, depth %d)\n", model, (int)tree.size(), tree_depth(tree));
+    fprintf(out, "MAX_DEPTH = %d: %d rounds, leaves up to depth %d, latency %d cycles after start\n\n",
+            JUMP_MAX_DEPTH, rounds, reach, rounds);
+
+    // =====================================================================
+    // 1. Exhaustive
+    // =====================================================================
+    fprintf(out, "----------------------------------------------------------------\n");
+    fprintf(out, "  Exhaustive Verification  (all 256 inputs)\n");
+    fprintf(out, "----------------------------------------------------------------\n\n");
+
+    int exhaust_pass = 0;
+    int by_depth[65] = {0};
+    long walk_sum = 0;
+    for (int inp = 0; inp < 256; inp++) {
+        SimResult sw = simulate_tree(tree, (uint8_t)inp);
+        Result hw = run_query(dut, tfp, (uint8_t)inp);
+        bool ok = hw.cycles == rounds && hw.action == sw.action && !hw.error;
+        if (ok) {
+            exhaust_pass++;
+        } else {
+            fprintf(out, "  MISMATCH input=%3d: SW=%s HW=%s after %d cycles%s\n",
+                    inp, action_name(sw.action),
+                    hw.cycles > 0 ? action_name(hw.action) : "TIMEOUT",
+                    hw.cycles, hw.error ? " (action_error)" : "");
+        }
+        by_depth[sw.depth]++;
+        walk_sum += sw.depth;
+    }
+    fprintf(out, "  Passed: %d / 256\n\n", exhaust_pass);
+    fprintf(out, "  Depth | Inputs | Linear walk | Jump\n");
+    fprintf(out, "  ------|--------|-------------|-----\n");
+    for (int d = 0; d <= 64; d++)
+        if (by_depth[d])
+            fprintf(out, "  %5d | %6d | %11d | %4d\n", d, by_depth[d], d, rounds);
+    fprintf(out, "  mean  |    256 | %11.2f | %4d   (cycles after the start tick)\n",
+            walk_sum / 256.0, rounds);
+
+    // =====================================================================
+    // 2. Depth limit
+    // =====================================================================
+    fprintf(out, "\n----------------------------------------------------------------\n");
+    fprintf(out, "  Depth Limit  (chain trees, input 255 takes the deepest path)\n");
+    fprintf(out, "----------------------------------------------------------------\n\n");
+
+    bool limit_ok = true;
+    if (2 * (reach + 1) + 1 > 64) {
+        fprintf(out, "  Skipped: a chain of depth %d does not fit 64 nodes\n", reach + 1);
+    } else {
+        for (int depth : {reach, reach + 1}) {
+            std::vector<Node> chain = chain_tree(depth);
+            if (INLINE) chain = inline_leaves(chain);
+            load_tree(dut, tfp, chain);
+            uint16_t errors_before = dut->error_count;
+            bool case_ok = true;
+            for (int inp : {0, depth / 2, 255}) {
+                SimResult sw = simulate_tree(chain, (uint8_t)inp);
+                Result hw = run_query(dut, tfp, (uint8_t)inp);
+                bool abort = sw.depth > reach;
+                case_ok = case_ok && hw.cycles == rounds && hw.error == abort
+                                  && hw.action == (abort ? 0 : sw.action);
+            }
+            bool count_ok = dut->error_count == errors_before + (depth > reach ? 1 : 0);
+            limit_ok = limit_ok && case_ok && count_ok;
+            fprintf(out, "  Chain depth %2d: deepest leaf %s, error_count %d  %s\n", depth,
+                    depth > reach ? "aborts with action_error" : "resolves",
+                    dut->error_count, case_ok && count_ok ? "PASS" : "*** FAIL ***");
+        }
+    }
+
+    // =====================================================================
+    // 3. Watchdog
+    // =====================================================================
+    fprintf(out, "\n----------------------------------------------------------------\n");
+    fprintf(out, "  Watchdog  (cyclic tree 0 → 1 → 0 ...)\n");
+    fprintf(out, "----------------------------------------------------------------\n\n");
+
+    load_tree(dut, tfp, tree);
+    uint16_t errors_before = dut->error_count;
+    write_node(dut, tfp, 0, Node{0, 128, 1, 1, 1, 0});
+    write_node(dut, tfp, 1, Node{0, 128, 1, 0, 0, 0});
+    tick(dut, tfp);
+    Result wd = run_query(dut, tfp, 42);
+    bool wd_ok = wd.cycles == rounds && wd.error && wd.action == 0 &&
+                 dut->error_count == errors_before + 1;
+    fprintf(out, "  Cyclic walk:  %s after %d cycles, action %s, error_count %d  %s\n",
+            wd.error ? "aborted" : "not flagged", wd.cycles,
+            wd.cycles > 0 ? action_name(wd.action) : "TIMEOUT",
+            dut->error_count, wd_ok ? "PASS" : "*** FAIL ***");
+
+    write_node(dut, tfp, 0, tree[0]);
+    write_node(dut, tfp, 1, tree[1]);
+    tick(dut, tfp);
+    Result rec = run_query(dut, tfp, 200);
+    bool rec_ok = rec.cycles == rounds && !rec.error && rec.action == simulate_tree(tree, 200).action;
+    fprintf(out, "  Recovery:     input 200 → %s, action_error %d  %s\n",
+            rec.cycles > 0 ? action_name(rec.action) : "TIMEOUT", rec.error,
+            rec_ok ? "PASS" : "*** FAIL ***");
+
+    // =====================================================================
+    // 4. Restart
+    // =====================================================================
+    dut->market_input = 4;
+    dut->start = 1;
+    tick(dut, tfp);
+    dut->market_input = 200;
+    tick(dut, tfp);                          // start again, one cycle in
+    dut->start = 0;
+    Result rs = {-1, -1, false};
+    for (int c = 1; c <= 80; c++) {
+        tick(dut, tfp);
+        if (dut->action_valid) { rs = {c, dut->action, dut->action_error != 0}; break; }
+    }
+    bool rs_ok = rs.cycles == rounds && rs.action == simulate_tree(tree, 200).action;
+    fprintf(out, "\n  Restart:      second start one cycle in → %s after %d cycles  %s\n",
+            rs.cycles > 0 ? action_name(rs.action) : "TIMEOUT", rs.cycles,
+            rs_ok ? "PASS" : "*** FAIL ***");
+
+    // =====================================================================
+    // Summary
+    // =====================================================================
+    bool pass = exhaust_pass == 256 && limit_ok && wd_ok && rec_ok && rs_ok;
+    fprintf(out, "\n================================================================\n");
+    fprintf(out, "  Summary\n");
+    fprintf(out, "================================================================\n");
+    fprintf(out, "  Exhaustive (0-255): %d / 256\n", exhaust_pass);
+    fprintf(out, "  Depth limit:        %s\n", limit_ok ? "PASS" : "*** FAIL ***");
+    fprintf(out, "  Watchdog:           %s\n", wd_ok && rec_ok ? "PASS" : "*** FAIL ***");
+    fprintf(out, "  Restart:            %s\n", rs_ok ? "PASS" : "*** FAIL ***");
+    fprintf(out, "  Design: pointer doubling over the next-pointer table\n");
+    fprintf(out, "  Latency formula: clog2(MAX_DEPTH) + 1 cycles including start, any depth\n");
+    fprintf(out, "  Throughput: 1 result every %d cycles (sequential)\n", rounds + 1);
+    fprintf(out, "  Verification: C++ golden model (simulate_tree)\n");
+    fprintf(out, "================================================================\n");
+
+    printf("Jump test %s — results written to results_jump.txt\n", pass ? "PASS" : "FAIL");
+
+    fclose(out);
+    tfp->close();
+    delete dut;
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,294 @@
+#if defined(LOAD_ORIG)
+#include "Vdecision_tree.h"
+typedef Vdecision_tree Dut;
+#elif defined(LOAD_FARM)
+#include "Vdecision_tree_farm.h"
+typedef Vdecision_tree_farm Dut;
+#else
+#include "Vdecision_tree_pipelined.h"
+typedef Vdecision_tree_pipelined Dut;
+#endif
+#include "verilated.h"
+#include "tree_model.h"
+#include "feed_format.h"
+#include "traffic.h"
+#include "clock_driver.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <string>
+#include <vector>
+
+// =========================================================================
+// Offered load vs achieved throughput and latency
+// Output: results_load_<engine>.txt, results_load_<engine>.csv
+//
+// Built once per engine: -DLOAD_ORIG / -DLOAD_FARM (with -DFARM_CORES=N)
+// or the pipelined engine by default.  `make test-load` builds all three.
+//
+// Usage: test_load [--queries N] [--pattern P] [--burst N] [--loads L,L,...]
+//                  [--replay feed.pcap]
+//
+// For each traffic pattern (sim/traffic.h: constant, poisson, bursty, and
+// replay when --replay gives a pcap) and each offered load (default 1% ..
+// 100% of line rate, one query per cycle), N queries arrive on schedule and
+// wait in an unbounded FIFO until the engine takes them.  Latency runs from
+// arrival to action_valid, so it includes queueing: below saturation it is
+// the engine's own latency, and above it the queue grows for the whole run.
+// Every result is checked against simulate_tree.  Idle stretches at low
+// load are fast-forwarded (sim/clock_driver.h).
+// =========================================================================
+
+#if defined(LOAD_ORIG)
+static const char *ENGINE = "orig";
+static const int SETTLE = 64 + 2;                  // MAX_DEPTH (= MAX_NODES) walk
+#elif defined(LOAD_FARM)
+#ifndef FARM_CORES
+#define FARM_CORES 4
+#endif
+static const char *ENGINE = "farm";
+static const int SETTLE = 64 + 2;
+#else
+static const char *ENGINE = "pipe";
+static const int SETTLE = 6 + 3;                   // MAX_DEPTH + 2 stages drain
+#endif
+
+vluint64_t sim_time = 0;
+double sc_time_stamp() { return sim_time; }
+
+typedef ClockDriver<Dut> Driver;
+
+static void write_node(Dut *dut, Driver &drv, int addr, const Node &n) {
+    dut->sw_we             = 1;
+    dut->sw_addr           = addr;
+    dut->sw_data_is_leaf   = n.is_leaf;
+    dut->sw_data_threshold = n.threshold;
+    dut->sw_data_less_than = n.less_than;
+    dut->sw_data_left_idx  = engine_child(n.left_idx, 6);
+    dut->sw_data_right_idx = engine_child(n.right_idx, 6);
+    dut->sw_data_action    = n.action;
+    drv.tick();
+    dut->sw_we = 0;
+}
+
+struct Point {
+    double   offered, achieved;
+    uint64_t p50, p99, max;
+    double   mean;
+    long     errors;
+};
+
+static uint64_t percentile(std::vector<uint64_t> &v, double p) {
+    size_t k = (size_t)(p * (v.size() - 1) + 0.5);
+    std::nth_element(v.begin(), v.begin() + k, v.end());
+    return v[k];
+}
+
+// One sweep point: replay `arr` through the engine, return the statistics
+static Point run(Dut *dut, Driver &drv, const std::vector<Node> &tree,
+                 const std::vector<Arrival> &arr, double load) {
+    std::deque<size_t> queue;                          // arrived, not started
+    std::deque<size_t> inflight;                       // started, in order
+    std::vector<uint64_t> lat;
+    lat.reserve(arr.size());
+    uint64_t base = drv.cycle();
+    uint64_t last_done = base;
+    size_t next = 0;
+    long errors = 0;
+
+    while (lat.size() < arr.size()) {
+        uint64_t now = drv.cycle() - base;
+        while (next < arr.size() && arr[next].cycle <= now) queue.push_back(next++);
+
+        // Nothing to do until the next arrival: jump there
+        if (queue.empty() && inflight.empty() && next < arr.size()) {
+            dut->start = 0;
+            drv.skip_to(base + arr[next].cycle);
+            continue;
+        }
+
+#if defined(LOAD_ORIG)
+        bool can = inflight.empty();                   // one walk at a time
+#elif defined(LOAD_FARM)
+        bool can = dut->ready;
+#else
+        bool can = true;
+#endif
+        bool go = can && !queue.empty();
+        dut->start        = go;
+        dut->market_input = go ? arr[queue.front()].input : 0;
+        if (go) { inflight.push_back(queue.front()); queue.pop_front(); }
+
+        drv.tick();
+
+        if (dut->action_valid && !inflight.empty()) {
+            size_t q = inflight.front();
+            inflight.pop_front();
+            lat.push_back(drv.cycle() - base - arr[q].cycle);
+            if (dut->action != simulate_tree(tree, arr[q].input).action) errors++;
+            last_done = drv.cycle();
+        }
+        if (drv.cycle() - base > 64 * (arr.back().cycle + arr.size()) + 1000) break;   // hung
+    }
+    dut->start = 0;
+
+    Point pt = {};
+    pt.offered  = load;
+    pt.achieved = (double)lat.size() / (double)(last_done - base);
+    pt.errors   = errors + (long)(arr.size() - lat.size());
+    if (!lat.empty()) {
+        double sum = 0;
+        for (uint64_t l : lat) { sum += l; if (l > pt.max) pt.max = l; }
+        pt.mean = sum / lat.size();
+        pt.p50  = percentile(lat, 0.50);
+        pt.p99  = percentile(lat, 0.99);
+    }
+    return pt;
+}
+
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+
+    size_t queries = 20000;
+    double burst   = 32;
+    const char *replay_file = nullptr;
+    std::vector<TrafficPattern> patterns;
+    std::vector<double> loads = {0.01, 0.02, 0.05, 0.10, 0.15, 0.20, 0.25, 0.30,
+                                 0.40, 0.50, 0.60, 0.70, 0.80, 0.90, 1.00};
+    for (int a = 1; a < argc; a++) {
+        std::string o = argv[a];
+        bool has_val = a + 1 < argc;
+        if (o[0] == '+') continue;                               // +verilator+ args
+        else if (o == "--queries" && has_val) queries = strtoul(argv[++a], nullptr, 0);
+        else if (o == "--burst" && has_val)   burst   = atof(argv[++a]);
+        else if (o == "--replay" && has_val)  replay_file = argv[++a];
+        else if (o == "--pattern" && has_val) {
+            TrafficPattern p;
+            if (!parse_traffic(argv[++a], p)) {
+                fprintf(stderr, "error: unknown pattern %s\n", argv[a]);
+                return 1;
+            }
+            patterns.push_back(p);
+        } else if (o == "--loads" && has_val) {
+            loads.clear();
+            for (char *s = argv[++a]; *s; ) {
+                loads.push_back(strtod(s, &s) / 100.0);
+                if (*s == ',') s++;
+                else if (*s) { fprintf(stderr, "error: bad --loads list\n"); return 1; }
+            }
+        }
+    }
+    if (patterns.empty())
+        patterns = {TrafficPattern::Constant, TrafficPattern::Poisson, TrafficPattern::Bursty};
+
+    // ----- Replay source: selected messages of a pcap, at capture time -----
+    std::vector<uint64_t> replay_ts;
+    std::vector<uint8_t>  replay_in;
+    if (replay_file) {
+        FeedConfig cfg = {0, 'T', true, 7, 9744, 2};           // same defaults as test_feed
+        std::vector<std::vector<FeedMsg>> packets;
+        std::vector<uint64_t> ts;
+        if (!read_feed_file(replay_file, packets, &ts)) return 1;
+        if (ts.size() != packets.size()) {
+            fprintf(stderr, "error: %s has no timestamps (replay needs a pcap)\n", replay_file);
+            return 1;
+        }
+        for (size_t p = 0; p < packets.size(); p++)
+            for (const FeedMsg &m : packets[p])
+                if (feed_selected(cfg, m)) {
+                    uint64_t t = ts[p] > ts[0] ? ts[p] - ts[0] : 0;
+                    replay_ts.push_back(replay_ts.empty() ? t : std::max(t, replay_ts.back()));
+                    replay_in.push_back(feed_quantize(cfg, m));
+                }
+        if (replay_ts.empty()) {
+            fprintf(stderr, "error: no selected messages in %s\n", replay_file);
+            return 1;
+        }
+        if (std::find(patterns.begin(), patterns.end(), TrafficPattern::Replay) == patterns.end())
+            patterns.push_back(TrafficPattern::Replay);
+    } else {
+        patterns.erase(std::remove(patterns.begin(), patterns.end(), TrafficPattern::Replay),
+                       patterns.end());
+    }
+
+    std::vector<Node> tree;
+    if (!read_tree_file("models/test_tree.tree", tree)) return 1;
+
+    auto *dut = new Dut;
+    Driver drv(dut, nullptr, sim_time, SETTLE, [](const Dut *d) { return d->start || d->sw_we; });
+
+    // ----- Reset + program -----
+    dut->rst   = 1;
+    dut->start = 0;
+    dut->sw_we = 0;
+    drv.tick(); drv.tick();
+    dut->rst = 0;
+    drv.tick();
+    for (int i = 0; i < (int)tree.size(); i++) write_node(dut, drv, i, tree[i]);
+    drv.tick();
+
+    std::string base = std::string("results_load_") + ENGINE;
+    FILE *out = fopen((base + ".txt").c_str(), "w");
+    FILE *csv = fopen((base + ".csv").c_str(), "w");
+    fprintf(csv, "engine,pattern,offered,achieved,p50,p99,mean,max\n");
+
+    fprintf(out, "================================================================\n");
+    fprintf(out, "  Offered Load vs Throughput / Latency — %s", ENGINE);
+#ifdef LOAD_FARM
+    fprintf(out, " (NUM_CORES=%d)", FARM_CORES);
+#endif
+    fprintf(out, "\n================================================================\n\n");
+    fprintf(out, "  %zu queries per point; load and throughput in queries/cycle\n", queries);
+    fprintf(out, "  (line rate = 1); latency in cycles from arrival to action_valid.\n");
+
+    bool ok = true;
+    for (TrafficPattern pat : patterns) {
+        fprintf(out, "\n----------------------------------------------------------------\n");
+        fprintf(out, "  %s%s\n", traffic_name(pat),
+                pat == TrafficPattern::Bursty ? " (on/off, line-rate bursts)" : "");
+        fprintf(out, "----------------------------------------------------------------\n\n");
+        fprintf(out, "  Offered | Achieved |   p50 |    p99 |     mean |    max\n");
+        fprintf(out, "  --------|----------|-------|--------|----------|-------\n");
+
+        double knee = -1;
+        for (double load : loads) {
+            TrafficConfig cfg = {pat, load};
+            cfg.burst_len     = burst;
+            cfg.replay_times  = &replay_ts;
+            cfg.replay_inputs = &replay_in;
+            std::vector<Arrival> arr = make_traffic(cfg, queries);
+            if (arr.empty()) continue;
+
+            Point pt = run(dut, drv, tree, arr, load);
+            if (pt.errors) ok = false;
+            if (knee < 0 && pt.achieved < 0.95 * load) knee = load;
+
+            fprintf(out, "  %6.0f%% | %8.3f | %5lu | %6lu | %8.1f | %6lu%s\n",
+                    load * 100, pt.achieved, (unsigned long)pt.p50, (unsigned long)pt.p99,
+                    pt.mean, (unsigned long)pt.max, pt.errors ? "  *** MISMATCH ***" : "");
+            fprintf(csv, "%s,%s,%.3f,%.4f,%lu,%lu,%.2f,%lu\n", ENGINE, traffic_name(pat),
+                    load, pt.achieved, (unsigned long)pt.p50, (unsigned long)pt.p99,
+                    pt.mean, (unsigned long)pt.max);
+        }
+        if (knee > 0)
+            fprintf(out, "\n  Saturates by %.0f%% offered load (achieved < 95%% of offered)\n", knee * 100);
+        else
+            fprintf(out, "\n  No saturation up to %.0f%% offered load\n", loads.back() * 100);
+    }
+
+    fprintf(out, "\n  Simulated %lu cycles, %lu skipped while idle\n",
+            (unsigned long)drv.cycle(), (unsigned long)drv.skipped());
+    fprintf(out, "\n================================================================\n");
+    fprintf(out, "  Summary: %s\n", ok ? "PASS — every result matches the golden model"
+                                       : "*** FAIL *** (wrong or missing results)");
+    fprintf(out, "================================================================\n");
+    fclose(out);
+    fclose(csv);
+
+    printf("Load sweep (%s) %s — %s.csv\n", ENGINE, ok ? "PASS" : "FAIL", base.c_str());
+
+    delete dut;
+    return ok ? 0 : 1;
+}
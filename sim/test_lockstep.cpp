@@ -0,0 +1,303 @@
+#ifdef LOCKSTEP_PIPE
+#include "Vdecision_tree_pipelined.h"
+typedef Vdecision_tree_pipelined Dut;
+#else
+#include "Vdecision_tree.h"
+typedef Vdecision_tree Dut;
+#endif
+#include "verilated.h"
+#include "engine_model.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// =========================================================================
+// Lockstep check + speed comparison: C++ engine model vs Verilated RTL
+// Output: results_lockstep_orig.txt / results_lockstep_pipe.txt
+//
+// Built once per engine: -DLOCKSTEP_PIPE selects decision_tree_pipelined
+// (default decision_tree), -DLOCKSTEP_INLINE pairs with -GINLINE_LEAVES=1.
+//
+// Usage: test_lockstep [--cycles N]
+//
+// Both models get identical port stimulus every cycle, and every output is
+// compared after every edge.  The phases cover clean traffic at several
+// loads, overlapping starts, node and payload writes while queries are in
+// flight, garbage nodes (with starts sparse enough for cyclic images to
+// hit the FSM hop watchdog) and random resets.  The speed run then clocks each
+// model alone on the same traffic.  No VCD is written: a trace would
+// dominate the run time being measured.
+// =========================================================================
+
+#ifdef LOCKSTEP_PIPE
+typedef PipelinedEngineModel Model;
+static const char *ENGINE = "pipelined";
+static const char *RESULTS = "results_lockstep_pipe.txt";
+#else
+typedef FsmEngineModel Model;
+static const char *ENGINE = "FSM";
+static const char *RESULTS = "results_lockstep_orig.txt";
+#endif
+
+#ifdef LOCKSTEP_INLINE
+static const bool INLINE = true;
+#else
+static const bool INLINE = false;
+#endif
+
+vluint64_t sim_time = 0;
+double sc_time_stamp() { return sim_time; }
+
+static void tick(Dut *dut) {
+    dut->clk = 0; dut->eval(); sim_time += 5;
+    dut->clk = 1; dut->eval(); sim_time += 5;
+}
+
+static void tick(Model *m) { m->tick(); }
+
+// One cycle of port stimulus
+struct Stim {
+    uint8_t  rst, start, market_input;
+    uint8_t  sw_we, sw_addr, is_leaf, threshold, less_than, action;
+    uint32_t left_idx, right_idx;
+    uint8_t  sw_payload_we, sw_payload_addr;
+    uint32_t sw_payload_data;
+};
+
+template <class T>
+static void apply(T *m, const Stim &s) {
+    m->rst               = s.rst;
+    m->start             = s.start;
+    m->market_input      = s.market_input;
+    m->sw_we             = s.sw_we;
+    m->sw_addr           = s.sw_addr;
+    m->sw_data_is_leaf   = s.is_leaf;
+    m->sw_data_threshold = s.threshold;
+    m->sw_data_less_than = s.less_than;
+    m->sw_data_left_idx  = s.left_idx;
+    m->sw_data_right_idx = s.right_idx;
+    m->sw_data_action    = s.action;
+#ifdef LOCKSTEP_PIPE
+    m->sw_payload_we     = s.sw_payload_we;
+    m->sw_payload_addr   = s.sw_payload_addr;
+    m->sw_payload_data   = s.sw_payload_data;
+#endif
+}
+
+struct Phase {
+    const char *name;
+    double p_start;      // start probability per cycle
+    double p_write;      // node write probability per cycle
+    double p_garbage;    // fraction of node writes with random fields
+    double p_reset;      // reset probability per cycle
+    long   cycles;
+};
+
+struct Rng {
+    uint64_t s;
+    uint32_t next() { s = s * 6364136223846793005ull + 1442695040888963407ull; return (uint32_t)(s >> 33); }
+    bool chance(double p) { return next() < p * 2147483648.0; }
+};
+
+// Programming stimulus for one node of the model tree
+static Stim node_write(const std::vector<Node> &tree, int addr) {
+    Stim s = {};
+    const Node &n = tree[addr];
+    s.sw_we     = 1;
+    s.sw_addr   = addr;
+    s.is_leaf   = n.is_leaf;
+    s.threshold = n.threshold;
+    s.less_than = n.less_than;
+    s.left_idx  = engine_child(n.left_idx, 6);
+    s.right_idx = engine_child(n.right_idx, 6);
+    s.action    = n.action;
+    return s;
+}
+
+static Stim random_stim(Rng &r, const Phase &ph, const std::vector<Node> &tree,
+                        int &reset_hold) {
+    Stim s = {};
+    if (reset_hold > 0 || r.chance(ph.p_reset)) {
+        s.rst = 1;
+        reset_hold = reset_hold > 0 ? reset_hold - 1 : (int)(r.next() % 3);
+    }
+    s.start        = r.chance(ph.p_start);
+    s.market_input = (uint8_t)r.next();
+
+    if (r.chance(ph.p_write)) {
+        if (r.chance(ph.p_garbage)) {
+            uint32_t child_mask = INLINE ? 0x7f : 0x3f;
+            s.sw_we     = 1;
+            s.sw_addr   = r.next() & 63;
+            s.is_leaf   = r.next() & 1;
+            s.threshold = (uint8_t)r.next();
+            s.less_than = r.next() & 1;
+            s.left_idx  = r.next() & child_mask;
+            s.right_idx = r.next() & child_mask;
+            s.action    = r.next() & 3;
+        } else {
+            Stim w = node_write(tree, r.next() % tree.size());
+            w.rst = s.rst; w.start = s.start; w.market_input = s.market_input;
+            s = w;
+        }
+    }
+    if (r.chance(ph.p_write)) {
+        s.sw_payload_we   = 1;
+        s.sw_payload_addr = r.next() & 63;
+        s.sw_payload_data = r.next();
+    }
+    return s;
+}
+
+// Outputs must match after every edge.  Returns false on the first mismatch.
+static bool same(Dut *dut, const Model &m) {
+    if (dut->action_valid != m.action_valid || dut->action != m.action) return false;
+#ifdef LOCKSTEP_PIPE
+    if (dut->payload != m.payload) return false;
+#else
+    if (dut->action_error != m.action_error || dut->error_count != m.error_count) return false;
+#endif
+    return true;
+}
+
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+
+    long bench_cycles = 2000000;
+    for (int a = 1; a < argc; a++) {
+        if (std::string(argv[a]) == "--cycles" && a + 1 < argc) bench_cycles = atol(argv[++a]);
+    }
+
+    std::vector<Node> tree;
+    if (!read_tree_file("models/test_tree.tree", tree)) return 1;
+    if (INLINE) tree = inline_leaves(tree);
+
+    FILE *out = fopen(RESULTS, "w");
+
+    auto *dut = new Dut;
+#ifdef LOCKSTEP_PIPE
+    Model model(64, 6, INLINE);
+#else
+    Model model(64, INLINE);
+#endif
+
+    fprintf(out, "================================================================\n");
+    fprintf(out, "  Lockstep — C++ model vs Verilated RTL (%s%s)\n", ENGINE,
+            INLINE ? ", INLINE_LEAVES=1" : "");
+    fprintf(out, "================================================================\n\n");
+
+    // ----- Reset + program the tree through the ports on both -----
+    Stim idle = {};
+    Stim rst  = {};
+    rst.rst = 1;
+    for (int i = 0; i < 2; i++) { apply(dut, rst); tick(dut); apply(&model, rst); tick(&model); }
+    for (int i = 0; i < (int)tree.size(); i++) {
+        Stim w = node_write(tree, i);
+        apply(dut, w); tick(dut);
+        apply(&model, w); tick(&model);
+    }
+    apply(dut, idle); tick(dut);
+    apply(&model, idle); tick(&model);
+
+    // =====================================================================
+    // Lockstep phases
+    // =====================================================================
+    const Phase phases[] = {
+        {"isolated queries",             0.05, 0.0,   0.0, 0.0,    200000},
+        {"half load",                    0.5,  0.0,   0.0, 0.0,    200000},
+        {"start every cycle",            1.0,  0.0,   0.0, 0.0,    100000},
+        {"node/payload writes in flight", 0.3, 0.02,  0.0, 0.0,    200000},
+        {"garbage nodes",                0.3,  0.01,  1.0, 0.0,    100000},
+        {"garbage nodes, sparse starts", 0.01, 0.01,  1.0, 0.0,    200000},
+        {"everything + resets",          0.3,  0.01,  0.2, 0.001,  200000},
+    };
+
+    fprintf(out, "----------------------------------------------------------------\n");
+    fprintf(out, "  Lockstep phases (all outputs compared after every edge)\n");
+    fprintf(out, "----------------------------------------------------------------\n\n");
+    fprintf(out, "  %-30s %10s %10s  %s\n", "Phase", "Cycles", "Results", "Status");
+
+    Rng rng = {0x5eed1234ull};
+    bool ok = true;
+    long total = 0;
+    for (const Phase &ph : phases) {
+        int  reset_hold = 0;
+        long results = 0, bad_cycle = -1;
+        for (long c = 0; c < ph.cycles; c++) {
+            Stim s = random_stim(rng, ph, tree, reset_hold);
+            apply(dut, s);     tick(dut);
+            apply(&model, s);  tick(&model);
+            if (model.action_valid) results++;
+            if (!same(dut, model)) { bad_cycle = c; break; }
+        }
+        total += ph.cycles;
+        fprintf(out, "  %-30s %10ld %10ld  %s", ph.name, ph.cycles, results,
+                bad_cycle < 0 ? "PASS" : "*** FAIL ***");
+        if (bad_cycle >= 0) {
+            fprintf(out, "  first mismatch at cycle %ld: rtl %d/%d  model %d/%d (valid/action)",
+                    bad_cycle, dut->action_valid, dut->action, model.action_valid, model.action);
+            ok = false;
+        }
+        fprintf(out, "\n");
+        if (!ok) break;
+
+        // Restore the tree between phases so each starts from a clean image
+        for (int i = 0; i < (int)tree.size(); i++) {
+            Stim w = node_write(tree, i);
+            apply(dut, w); tick(dut);
+            apply(&model, w); tick(&model);
+        }
+    }
+    fprintf(out, "\n  Total: %ld cycles compared\n\n", total);
+
+    // =====================================================================
+    // Speed — each model alone on the same half-load traffic
+    // =====================================================================
+    std::vector<uint8_t> inputs(4096);
+    for (auto &v : inputs) v = (uint8_t)rng.next();
+
+    auto run = [&](auto *m) {
+        m->rst = 0; m->sw_we = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        long results = 0;
+        for (long c = 0; c < bench_cycles; c++) {
+            m->start        = (c & 1) == 0;
+            m->market_input = inputs[c & 4095];
+            tick(m);
+            results += m->action_valid;
+        }
+        auto t1 = std::chrono::steady_clock::now();
+        std::chrono::duration<double> dt = t1 - t0;
+        return std::make_pair(dt.count(), results);
+    };
+    auto rtl = run(dut);
+    auto mdl = run(&model);
+    double rtl_rate = bench_cycles / rtl.first / 1e6;
+    double mdl_rate = bench_cycles / mdl.first / 1e6;
+
+    fprintf(out, "----------------------------------------------------------------\n");
+    fprintf(out, "  Speed  (%ld cycles, start every other cycle)\n", bench_cycles);
+    fprintf(out, "----------------------------------------------------------------\n\n");
+    fprintf(out, "  Verilated RTL:  %8.2f Mcycles/s   (%ld results)\n", rtl_rate, rtl.second);
+    fprintf(out, "  C++ model:      %8.2f Mcycles/s   (%ld results)\n", mdl_rate, mdl.second);
+    fprintf(out, "  Speedup:        %8.1fx\n", mdl_rate / rtl_rate);
+    if (rtl.second != mdl.second) {
+        fprintf(out, "  *** result counts differ ***\n");
+        ok = false;
+    }
+
+    fprintf(out, "\n================================================================\n");
+    fprintf(out, "  Summary: %s   model %.1fx faster than Verilator\n",
+            ok ? "PASS" : "*** FAIL ***", mdl_rate / rtl_rate);
+    fprintf(out, "================================================================\n");
+    fclose(out);
+
+    printf("Lockstep test (%s) %s — model %.1fx faster\n", ENGINE, ok ? "PASS" : "FAIL",
+           mdl_rate / rtl_rate);
+
+    delete dut;
+    return ok ? 0 : 1;
+}
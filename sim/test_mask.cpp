@@ -0,0 +1,216 @@
+#include "Vdecision_tree_mask.h"
+#include "verilated.h"
+#include "verilated_vcd_c.h"
+#include "tree_model.h"
+#include "tree_mask.h"
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+// =========================================================================
+// Test harness for the bitmask (set-membership) split engine
+// Output: results_mask.txt
+//
+// Usage: test_mask [model.tree]   (default models/test_tree.tree)
+//
+// The macros must match the engine's parameters:
+//   -DMASK_MAX_DEPTH=N     -GMAX_DEPTH=N      (default 3)
+//   -DMASK_BITS_N=B        -GMASK_BITS=B      (default 256)
+//   -DMASK_ENTRIES_N=E     -GMASK_ENTRIES=E   (default 8)
+//
+//   1. the model is converted (convert_to_mask) and the mask tree is
+//      checked against simulate_tree() on all 256 inputs
+//   2. all 256 inputs one at a time: action matches, latency MAX_DEPTH + 1
+//      cycles after the start tick
+//   3. all 256 inputs back to back: one result per cycle, in order
+// =========================================================================
+
+#ifndef MASK_MAX_DEPTH
+#define MASK_MAX_DEPTH 3
+#endif
+#ifndef MASK_BITS_N
+#define MASK_BITS_N 256
+#endif
+#ifndef MASK_ENTRIES_N
+#define MASK_ENTRIES_N 8
+#endif
+
+vluint64_t sim_time = 0;
+double sc_time_stamp() { return sim_time; }
+
+static void tick(Vdecision_tree_mask *dut, VerilatedVcdC *tfp) {
+    dut->clk = 0; dut->eval(); tfp->dump(sim_time); sim_time += 5;
+    dut->clk = 1; dut->eval(); tfp->dump(sim_time); sim_time += 5;
+    tfp->flush();
+}
+
+// Nodes, then masks as 32-bit words (word 0 = buckets 0..31)
+static void load_mask_tree(Vdecision_tree_mask *dut, VerilatedVcdC *tfp, const MaskTree &t) {
+    for (int i = 0; i < (int)t.nodes.size(); i++) {
+        const MaskNode &n = t.nodes[i];
+        dut->sw_we             = 1;
+        dut->sw_addr           = i;
+        dut->sw_data_is_leaf   = n.is_leaf;
+        dut->sw_data_is_mask   = n.is_mask;
+        dut->sw_data_threshold = n.threshold;
+        dut->sw_data_less_than = n.less_than;
+        dut->sw_data_left_idx  = n.left_idx;
+        dut->sw_data_right_idx = n.right_idx;
+        dut->sw_data_action    = n.action;
+        tick(dut, tfp);
+    }
+    dut->sw_we = 0;
+
+    const int words = MASK_BITS_N / 32;
+    for (int m = 0; m < (int)t.masks.size(); m++) {
+        for (int w = 0; w < words; w++) {
+            uint32_t data = 0;
+            for (int b = 0; b < 32; b++)
+                if (t.masks[m][w * 32 + b]) data |= 1u << b;
+            dut->sw_mask_we   = 1;
+            dut->sw_mask_addr = m * words + w;
+            dut->sw_mask_data = data;
+            tick(dut, tfp);
+        }
+    }
+    dut->sw_mask_we = 0;
+    tick(dut, tfp);
+}
+
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    Verilated::traceEverOn(true);
+
+    const char *model = "models/test_tree.tree";
+    for (int a = 1; a < argc; a++)
+        if (argv[a][0] != '+') model = argv[a];
+
+    std::vector<Node> tree;
+    if (!read_tree_file(model, tree)) return 1;
+
+    MaskTree mt;
+    if (!convert_to_mask(tree, MASK_BITS_N, MASK_ENTRIES_N, mt)) {
+        fprintf(stderr, "error: %s does not convert (malformed or over 64 nodes)\n", model);
+        return 1;
+    }
+    int depth = mask_depth(mt);
+    if (depth < 0 || depth + 1 > MASK_MAX_DEPTH) {
+        fprintf(stderr, "error: converted %s has depth %d, needs MAX_DEPTH >= %d (have %d)\n",
+                model, depth, depth + 1, MASK_MAX_DEPTH);
+        return 1;
+    }
+    const int latency = MASK_MAX_DEPTH + 1;   // cycles after the start tick
+
+    auto *dut = new Vdecision_tree_mask;
+    auto *tfp = new VerilatedVcdC;
+    dut->trace(tfp, 99);
+    tfp->open("test_mask.vcd");
+
+    FILE *out = fopen("results_mask.txt", "w");
+
+    dut->rst        = 1;
+    dut->start      = 0;
+    dut->sw_we      = 0;
+    dut->sw_mask_we = 0;
+    tick(dut, tfp); tick(dut, tfp);
+    dut->rst = 0;
+    tick(dut, tfp);
+    load_mask_tree(dut, tfp, mt);
+
+    int mask_nodes = 0;
+    for (const MaskNode &n : mt.nodes) mask_nodes += n.is_mask;
+    fprintf(out, "================================================================\n");
+    fprintf(out, "  Decision Tree Test — MASK (%d-bit masks, MAX_DEPTH=%d)\n", MASK_BITS_N, MASK_MAX_DEPTH);
+    fprintf(out, "================================================================\n\n");
+    fprintf(out, "Model: %s (%d nodes, depth %d)\n", model, (int)tree.size(), tree_depth(tree));
+    fprintf(out, "Converted: %d nodes (%d mask nodes, %d / %d masks), depth %d\n",
+            (int)mt.nodes.size(), mask_nodes, (int)mt.masks.size(), MASK_ENTRIES_N, depth);
+    fprintf(out, "Latency: %d cycles after start\n\n", latency);
+
+    // =====================================================================
+    // 1. Conversion
+    // =====================================================================
+    int conv_pass = 0;
+    for (int inp = 0; inp < 256; inp++)
+        conv_pass += simulate_mask(mt, (uint8_t)inp).action == simulate_tree(tree, (uint8_t)inp).action;
+    fprintf(out, "  Mask tree vs simulate_tree: %d / 256\n", conv_pass);
+
+    // =====================================================================
+    // 2. One at a time
+    // =====================================================================
+    fprintf(out, "\n----------------------------------------------------------------\n");
+    fprintf(out, "  Exhaustive Verification  (all 256 inputs, one at a time)\n");
+    fprintf(out, "----------------------------------------------------------------\n\n");
+
+    int exhaust_pass = 0;
+    for (int inp = 0; inp < 256; inp++) {
+        SimResult sw = simulate_tree(tree, (uint8_t)inp);
+
+        dut->market_input = inp;
+        dut->start = 1;
+        tick(dut, tfp);
+        dut->start = 0;
+
+        int cycles = -1, hw_action = -1;
+        for (int c = 1; c <= latency + 4; c++) {
+            tick(dut, tfp);
+            if (dut->action_valid) {
+                cycles    = c;
+                hw_action = dut->action;
+                break;
+            }
+        }
+        if (cycles == latency && hw_action == sw.action) {
+            exhaust_pass++;
+        } else {
+            fprintf(out, "  MISMATCH input=%3d: SW=%s HW=%s after %d cycles\n",
+                    inp, action_name(sw.action),
+                    cycles > 0 ? action_name(hw_action) : "TIMEOUT", cycles);
+        }
+    }
+    fprintf(out, "  Passed: %d / 256\n", exhaust_pass);
+
+    // =====================================================================
+    // 3. Back to back
+    // =====================================================================
+    int received = 0, in_order = 0;
+    for (int t = 0; t < 256 + latency + 4; t++) {
+        dut->start        = t < 256;
+        dut->market_input = t < 256 ? t : 0;
+        tick(dut, tfp);
+        if (!dut->action_valid) continue;
+        int q = t - latency;
+        if (q == received && q < 256 && dut->action == simulate_tree(tree, (uint8_t)q).action)
+            in_order++;
+        received++;
+    }
+    dut->start = 0;
+    bool tp_ok = received == 256 && in_order == 256;
+    fprintf(out, "\n  Back to back: %d results, %d in order at the fixed latency  %s\n",
+            received, in_order, tp_ok ? "PASS" : "*** FAIL ***");
+
+    // =====================================================================
+    // Summary
+    // =====================================================================
+    bool pass = conv_pass == 256 && exhaust_pass == 256 && tp_ok;
+    fprintf(out, "\n================================================================\n");
+    fprintf(out, "  Summary\n");
+    fprintf(out, "================================================================\n");
+    fprintf(out, "  Conversion (0-255): %d / 256\n", conv_pass);
+    fprintf(out, "  Exhaustive (0-255): %d / 256\n", exhaust_pass);
+    fprintf(out, "  Back to back:       %s\n", tp_ok ? "PASS" : "*** FAIL ***");
+    fprintf(out, "  Design: pipelined, threshold and set-membership split nodes\n");
+    fprintf(out, "  Depth: %d -> %d (%d -> %d stages)\n",
+            tree_depth(tree), depth, tree_stages(tree), depth + 1);
+    fprintf(out, "  Latency formula: MAX_DEPTH + 2 cycles including start (fixed)\n");
+    fprintf(out, "  Throughput: 1 result per cycle\n");
+    fprintf(out, "  Verification: C++ golden model (simulate_tree)\n");
+    fprintf(out, "================================================================\n");
+
+    printf("Mask test %s — results written to results_mask.txt\n", pass ? "PASS" : "FAIL");
+
+    fclose(out);
+    tfp->close();
+    delete dut;
+    return pass ? 0 : 1;
+}
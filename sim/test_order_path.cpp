@@ -0,0 +1,309 @@
+#include "Vdecision_order_path.h"
+#include "verilated.h"
+#include "verilated_vcd_c.h"
+#include "tree_model.h"
+#include <cstdio>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+// =========================================================================
+// Decision-to-wire harness: pipelined engine + order message generator
+// Output: results_order_path.txt
+//
+// A decoder reassembles the 64-bit message stream (m_tvalid/m_tready/
+// m_tlast) into order messages and checks every field against the golden
+// model (simulate_tree + the leaf's order template + instrument context).
+// Latency is measured from the start cycle to action_valid (classifier),
+// to beat 0 on the wire and to the last beat (decision-to-wire).
+// =========================================================================
+
+static const int MAX_DEPTH     = 6;
+static const uint16_t INSTRUMENT = 0x1234;
+
+vluint64_t sim_time = 0;
+double sc_time_stamp() { return sim_time; }
+
+static void tick(Vdecision_order_path *dut, VerilatedVcdC *tfp) {
+    dut->clk = 0; dut->eval(); tfp->dump(sim_time); sim_time += 5;
+    dut->clk = 1; dut->eval(); tfp->dump(sim_time); sim_time += 5;
+    tfp->flush();
+}
+
+static void write_node(Vdecision_order_path *dut, VerilatedVcdC *tfp,
+                       int addr, const Node &n) {
+    dut->sw_we             = 1;
+    dut->sw_addr           = addr;
+    dut->sw_data_is_leaf   = n.is_leaf;
+    dut->sw_data_threshold = n.threshold;
+    dut->sw_data_less_than = n.less_than;
+    dut->sw_data_left_idx  = n.left_idx;
+    dut->sw_data_right_idx = n.right_idx;
+    dut->sw_data_action    = n.action;
+    tick(dut, tfp);
+    dut->sw_we = 0;
+}
+
+static void write_template(Vdecision_order_path *dut, VerilatedVcdC *tfp,
+                           int slot, const OrderTemplate &t) {
+    dut->sw_payload_we   = 1;
+    dut->sw_payload_addr = slot;
+    dut->sw_payload_data = pack_template(t);
+    tick(dut, tfp);
+    dut->sw_payload_we = 0;
+}
+
+// -------------------------------------------------------------------------
+// Wire format (see rtl/order_msg_gen.sv) and decoder
+// -------------------------------------------------------------------------
+struct OrderMsg {
+    uint8_t  msg_type;      // 'N' / 'X'
+    uint8_t  side;          // 'B' / 'S' / 0
+    uint16_t instrument_id;
+    uint32_t seq_num;
+    uint32_t price;
+    uint32_t qty;
+
+    bool same_order(const OrderMsg &o) const {   // everything but seq_num
+        return msg_type == o.msg_type && side == o.side && instrument_id == o.instrument_id
+            && price == o.price && qty == o.qty;
+    }
+};
+
+struct Decoder {
+    std::vector<uint64_t> beats;
+    int framing_errors = 0;
+
+    // Feed one accepted beat; returns true when a message completes.
+    bool push(uint64_t data, bool last, OrderMsg &msg) {
+        beats.push_back(data);
+        if (!last) {
+            if (beats.size() > 2) { framing_errors++; beats.clear(); }
+            return false;
+        }
+        bool ok = beats.size() == 2;
+        if (ok) {
+            msg.msg_type      = (uint8_t)(beats[0] >> 56);
+            msg.side          = (uint8_t)(beats[0] >> 48);
+            msg.instrument_id = (uint16_t)(beats[0] >> 32);
+            msg.seq_num       = (uint32_t)beats[0];
+            msg.price         = (uint32_t)(beats[1] >> 32);
+            msg.qty           = (uint32_t)beats[1];
+        } else {
+            framing_errors++;
+        }
+        beats.clear();
+        return ok;
+    }
+};
+
+// Golden model: what the generator must send for a query (false = NONE)
+static bool expected_msg(const std::vector<Node> &tree, const std::vector<OrderTemplate> &tmpl,
+                         uint8_t input, uint32_t ref_price, OrderMsg &m) {
+    SimResult r = simulate_tree(tree, input);
+    if (r.action == 0) return false;
+    const OrderTemplate &t = tmpl[r.slot];
+    m.msg_type      = r.action == 3 ? 'X' : 'N';
+    m.side          = t.side == 1 ? 'B' : t.side == 2 ? 'S' : 0;
+    m.instrument_id = INSTRUMENT;
+    m.seq_num       = 0;
+    m.price         = ref_price + (int32_t)t.price_offset;
+    m.qty           = t.qty;
+    return true;
+}
+
+// -------------------------------------------------------------------------
+// One traffic phase
+// -------------------------------------------------------------------------
+struct PhaseStats {
+    int queries, expected, received, matched, seq_errors;
+    uint32_t dropped;
+    int lat_valid_min, lat_valid_max;       // start → action_valid
+    int lat_first_min, lat_first_max;       // start → beat 0 accepted
+    int lat_last_min,  lat_last_max;        // start → last beat accepted
+    double lat_last_mean;
+    bool exact;                             // no drops → 1:1 latency mapping
+};
+
+static PhaseStats run_phase(Vdecision_order_path *dut, VerilatedVcdC *tfp,
+                            const std::vector<Node> &tree,
+                            const std::vector<OrderTemplate> &tmpl,
+                            const std::vector<uint8_t> &inputs,
+                            int gap, int ready_pct, uint32_t &lfsr) {
+    PhaseStats st = {};
+    st.lat_valid_min = st.lat_first_min = st.lat_last_min = 1 << 30;
+
+    struct Want { OrderMsg m; int start_cycle; };
+    std::deque<Want> want;
+    std::deque<int>  valid_starts;             // start cycle per query, for action_valid
+    Decoder dec;
+    uint32_t dropped0 = dut->dropped;
+    uint32_t seq_next = dut->msg_count;        // first seq_num this phase will use
+    int  first_beat_cycle = -1;
+    long lat_sum = 0;
+
+    int n = (int)inputs.size(), sent = 0, idle = 0;
+    for (int c = 0; idle < 4 * MAX_DEPTH + 64; c++) {
+        // ----- Drive -----
+        bool go = sent < n && c % gap == 0;
+        dut->start        = go;
+        dut->market_input = go ? inputs[sent] : 0;
+        dut->ref_price    = 100000 + c;        // context moves every cycle
+        if (go) {
+            OrderMsg m;
+            if (expected_msg(tree, tmpl, inputs[sent], 100000 + c + MAX_DEPTH + 2, m)) {
+                want.push_back({m, c});
+                st.expected++;
+            }
+            valid_starts.push_back(c);
+            sent++;
+            st.queries++;
+        }
+        lfsr = lfsr * 1103515245u + 12345u;
+        dut->m_tready = (int)((lfsr >> 16) % 100) < ready_pct;
+
+        // ----- Observe (outputs settled from the previous edge) -----
+        if (dut->action_valid && !valid_starts.empty()) {
+            int lat = c - valid_starts.front();
+            valid_starts.pop_front();
+            if (lat < st.lat_valid_min) st.lat_valid_min = lat;
+            if (lat > st.lat_valid_max) st.lat_valid_max = lat;
+        }
+        if (dut->m_tvalid && dut->m_tready) {
+            if (!dut->m_tlast) first_beat_cycle = c;
+            OrderMsg got;
+            if (dec.push(dut->m_tdata, dut->m_tlast, got)) {
+                st.received++;
+                if (got.seq_num != seq_next++) st.seq_errors++;
+                // Messages leave in query order; dropped ones are skipped
+                while (!want.empty() && !want.front().m.same_order(got))
+                    want.pop_front();
+                if (!want.empty()) {
+                    st.matched++;
+                    int lf = first_beat_cycle - want.front().start_cycle;
+                    int ll = c - want.front().start_cycle;
+                    if (lf < st.lat_first_min) st.lat_first_min = lf;
+                    if (lf > st.lat_first_max) st.lat_first_max = lf;
+                    if (ll < st.lat_last_min)  st.lat_last_min  = ll;
+                    if (ll > st.lat_last_max)  st.lat_last_max  = ll;
+                    lat_sum += ll;
+                    want.pop_front();
+                }
+            }
+        }
+
+        tick(dut, tfp);
+        idle = (sent >= n && !dut->m_tvalid) ? idle + 1 : 0;
+    }
+    dut->start = 0;
+
+    st.dropped       = dut->dropped - dropped0;
+    st.lat_last_mean = st.matched ? (double)lat_sum / st.matched : 0.0;
+    st.exact         = st.dropped == 0;
+    st.seq_errors   += dec.framing_errors;
+    return st;
+}
+
+static bool report(FILE *out, const char *name, const PhaseStats &st, int expect_first, int expect_last) {
+    bool counts_ok = st.received + (int)st.dropped == st.expected && st.matched == st.received
+                  && st.seq_errors == 0;
+    bool lat_ok = expect_last < 0 || (st.lat_first_min == expect_first && st.lat_first_max == expect_first
+                                   && st.lat_last_min == expect_last && st.lat_last_max == expect_last);
+    bool ok = counts_ok && lat_ok;
+
+    fprintf(out, "----------------------------------------------------------------\n");
+    fprintf(out, "  %s\n", name);
+    fprintf(out, "----------------------------------------------------------------\n\n");
+    fprintf(out, "  Queries %d, orders expected %d, received %d, dropped %u, matched %d, seq/framing errors %d\n",
+            st.queries, st.expected, st.received, st.dropped, st.matched, st.seq_errors);
+    fprintf(out, "  start → action_valid:   %d..%d cycles\n", st.lat_valid_min, st.lat_valid_max);
+    if (st.matched) {
+        fprintf(out, "  start → beat 0 on wire: %d..%d cycles\n", st.lat_first_min, st.lat_first_max);
+        fprintf(out, "  start → last beat:      %d..%d cycles (mean %.2f)%s\n",
+                st.lat_last_min, st.lat_last_max, st.lat_last_mean,
+                st.exact ? "" : "  [drops: latency of delivered orders only]");
+    }
+    fprintf(out, "  %s\n\n", ok ? "PASS" : "*** FAIL ***");
+    return ok;
+}
+
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    Verilated::traceEverOn(true);
+
+    std::vector<Node> tree;
+    if (!read_tree_file("models/test_tree.tree", tree)) return 1;
+
+    // Order templates: per leaf, side from the action, qty/offset per slot
+    std::vector<OrderTemplate> tmpl(64, OrderTemplate{0, 0, 0});
+    for (const Node &n : tree) {
+        if (!n.is_leaf) continue;
+        int slot = n.threshold & 63;
+        uint8_t side = n.action == 1 ? 1 : n.action == 2 ? 2 : 0;
+        tmpl[slot] = {side, (uint16_t)(n.action == 3 ? 0 : 100 + slot),
+                      (int16_t)(n.action == 1 ? -slot : slot)};
+    }
+
+    auto *dut = new Vdecision_order_path;
+    auto *tfp = new VerilatedVcdC;
+    dut->trace(tfp, 99);
+    tfp->open("test_order_path.vcd");
+
+    FILE *out = fopen("results_order_path.txt", "w");
+
+    // ----- Reset -----
+    dut->rst           = 1;
+    dut->start         = 0;
+    dut->sw_we         = 0;
+    dut->sw_payload_we = 0;
+    dut->m_tready      = 1;
+    dut->instrument_id = INSTRUMENT;
+    dut->ref_price     = 100000;
+    tick(dut, tfp); tick(dut, tfp);
+    dut->rst = 0;
+    tick(dut, tfp);
+
+    for (int i = 0; i < (int)tree.size(); i++) write_node(dut, tfp, i, tree[i]);
+    for (int k = 0; k < 64; k++)               write_template(dut, tfp, k, tmpl[k]);
+    tick(dut, tfp);
+
+    fprintf(out, "================================================================\n");
+    fprintf(out, "  Decision-to-Wire Test — pipelined engine + order_msg_gen\n");
+    fprintf(out, "================================================================\n\n");
+    fprintf(out, "MAX_DEPTH=%d: action_valid at +%d, beat 0 at +%d, last beat at +%d (idle wire)\n\n",
+            MAX_DEPTH, MAX_DEPTH + 2, MAX_DEPTH + 3, MAX_DEPTH + 4);
+
+    std::vector<uint8_t> all(256);
+    for (int i = 0; i < 256; i++) all[i] = (uint8_t)i;
+    uint32_t lfsr = 0xACE1u;
+    bool ok = true;
+
+    // Isolated queries: exact decision-to-wire latency
+    PhaseStats iso = run_phase(dut, tfp, tree, tmpl, all, 4 * MAX_DEPTH, 100, lfsr);
+    ok &= report(out, "Isolated queries (all 256 inputs, wire always ready)", iso,
+                 MAX_DEPTH + 3, MAX_DEPTH + 4);
+
+    // Sustained: one query every 2 cycles = one 2-beat order per 2 cycles max
+    PhaseStats sus = run_phase(dut, tfp, tree, tmpl, all, 2, 100, lfsr);
+    ok &= report(out, "Sustained (1 query / 2 cycles, wire always ready)", sus, -1, -1);
+    ok &= sus.dropped == 0;
+
+    // Back-pressure: wire ready 50% of cycles, FIFO absorbs the jitter
+    PhaseStats bp = run_phase(dut, tfp, tree, tmpl, all, 6, 50, lfsr);
+    ok &= report(out, "Back-pressure (1 query / 6 cycles, m_tready 50%)", bp, -1, -1);
+
+    // Overload: one query every cycle — FIFO overflows, drops are counted
+    PhaseStats ovl = run_phase(dut, tfp, tree, tmpl, all, 1, 100, lfsr);
+    ok &= report(out, "Overload (1 query / cycle, 2 beats per order)", ovl, -1, -1);
+
+    fprintf(out, "================================================================\n");
+    fprintf(out, "  Summary: %s\n", ok ? "PASS" : "*** FAIL ***");
+    fprintf(out, "================================================================\n");
+
+    printf("Order path test complete — results written to results_order_path.txt\n");
+
+    fclose(out);
+    tfp->close();
+    delete dut;
+    return ok ? 0 : 1;
+}
@@ -1,6 +1,7 @@
 #include "Vdecision_tree.h"
 #include "verilated.h"
 #include "verilated_vcd_c.h"
+#include "tree_model.h"
 #include <cstdio>
 #include <cstdint>
 #include <vector>
@@ -11,6 +12,11 @@
 // Output: results_original.txt
 // =========================================================================
 
+// Hop watchdog limit the engine was built with (MAX_DEPTH, default MAX_NODES)
+#ifndef WATCHDOG_DEPTH
+#define WATCHDOG_DEPTH 64
+#endif
+
 vluint64_t sim_time = 0;
 double sc_time_stamp() { return sim_time; }
 
@@ -20,15 +26,6 @@ static void tick(Vdecision_tree *dut, VerilatedVcdC *tfp) {
     tfp->flush();
 }
 
-struct Node {
-    uint8_t is_leaf;
-    uint8_t threshold;
-    uint8_t less_than;
-    uint8_t left_idx;
-    uint8_t right_idx;
-    uint8_t action;
-};
-
 struct TestCase {
     uint8_t input;
     int expected_action;   // 0=NONE 1=BUY 2=SELL 3=CANCEL
@@ -36,47 +33,6 @@ struct TestCase {
     const char *label;
 };
 
-static const char *action_name(int a) {
-    switch (a) {
-        case 0: return "NONE  ";
-        case 1: return "BUY   ";
-        case 2: return "SELL  ";
-        case 3: return "CANCEL";
-        default: return "???   ";
-    }
-}
-
-// =========================================================================
-// Software golden model — walks the tree in pure C++, no Verilog involved.
-// This is the reference: if HW disagrees with this, HW has a bug.
-// If this disagrees with our hand-traced expectations, WE had a bug.
-// =========================================================================
-struct SimResult {
-    int action;    // leaf action (0-3)
-    int depth;     // number of edges from root to leaf
-    bool valid;    // false if tree is malformed (loop, missing leaf, etc.)
-};
-
-static SimResult simulate_tree(const std::vector<Node> &tree, uint8_t input) {
-    SimResult r = {0, 0, false};
-    int idx = 0;  // start at root
-
-    for (int step = 0; step < 64; step++) {  // cap at 64 to detect infinite loops
-        if (idx < 0 || idx >= (int)tree.size()) return r;  // out of bounds
-        const Node &n = tree[idx];
-        if (n.is_leaf) {
-            r.action = n.action;
-            r.depth  = step;
-            r.valid  = true;
-            return r;
-        }
-        bool cond = n.less_than ? (input < n.threshold) : (input > n.threshold);
-        idx = cond ? n.left_idx : n.right_idx;
-    }
-
-    return r;  // valid=false — probable cycle in tree
-}
-
 static void write_node(Vdecision_tree *dut, VerilatedVcdC *tfp,
                         int addr, const Node &n) {
     dut->sw_we             = 1;
@@ -84,8 +40,8 @@ static void write_node(Vdecision_tree *dut, VerilatedVcdC *tfp,
     dut->sw_data_is_leaf   = n.is_leaf;
     dut->sw_data_threshold = n.threshold;
     dut->sw_data_less_than = n.less_than;
-    dut->sw_data_left_idx  = n.left_idx;
-    dut->sw_data_right_idx = n.right_idx;
+    dut->sw_data_left_idx  = engine_child(n.left_idx, 6);
+    dut->sw_data_right_idx = engine_child(n.right_idx, 6);
     dut->sw_data_action    = n.action;
     tick(dut, tfp);
     dut->sw_we = 0;
@@ -137,6 +93,12 @@ int main(int argc, char **argv) {
         /* 14*/ {1,   0, 0,  0,  0, 3},   // leaf CANCEL
     };
 
+#ifdef INLINE_LEAVES
+    // Engine built with INLINE_LEAVES=1: fold leaf nodes into child pointers
+    // (15 nodes → 7); leaf detection comes from the pointer, not tree_mem.
+    tree = inline_leaves(tree);
+#endif
+
     // Build test cases from the software golden model (no hand-tracing!)
     uint8_t spot_inputs[] = {4, 10, 20, 40, 80, 140, 170, 200, 0, 127, 128, 255};
     std::vector<TestCase> tests;
@@ -159,8 +121,12 @@ int main(int argc, char **argv) {
     tick(dut, tfp);
 
     // ----- Load tree -----
+    // With TREE_PRELOADED the same tree was baked in via TREE_INIT_FILE
+    // (models/test_tree.tree → tree2mem), so there is nothing to program.
+#ifndef TREE_PRELOADED
     for (int i = 0; i < (int)tree.size(); i++)
         write_node(dut, tfp, i, tree[i]);
+#endif
 
     // Allow one extra cycle for path[] to register after tree is loaded
     tick(dut, tfp);
@@ -342,6 +308,55 @@ int main(int argc, char **argv) {
         fprintf(out, "  All 256 inputs match the golden model.\n");
     fprintf(out, "  Passed: %d / 256    Failed: %d / 256\n", exhaust_pass, exhaust_fail);
 
+    // =====================================================================
+    // Watchdog — a cyclic image must still answer, flagged, in MAX_DEPTH
+    // =====================================================================
+    fprintf(out, "\n----------------------------------------------------------------\n");
+    fprintf(out, "  Hop Watchdog  (cyclic tree 0 → 1 → 0 ..., MAX_DEPTH = %d)\n", WATCHDOG_DEPTH);
+    fprintf(out, "----------------------------------------------------------------\n\n");
+
+    Node loop0 = {0, 128, 1, 1, 1, 0};       // both children → node 1
+    Node loop1 = {0, 128, 1, 0, 0, 0};       // both children → node 0
+    write_node(dut, tfp, 0, loop0);
+    write_node(dut, tfp, 1, loop1);
+    tick(dut, tfp);
+
+    dut->market_input = 42;
+    dut->start = 1;
+    tick(dut, tfp);
+    dut->start = 0;
+
+    int wd_lat = 0;
+    bool wd_got = false;
+    for (int c = 0; c < WATCHDOG_DEPTH + 20; c++) {
+        tick(dut, tfp);
+        wd_lat++;
+        if (dut->action_valid) { wd_got = true; break; }
+    }
+    bool wd_ok = wd_got && dut->action_error && dut->action == 0 &&
+                 wd_lat == WATCHDOG_DEPTH && dut->error_count == 1;
+    fprintf(out, "  Cyclic walk:  %s after %d cycles, action %s, action_error %d, error_count %d  %s\n",
+            wd_got ? "aborted" : "TIMEOUT", wd_lat, action_name(dut->action),
+            dut->action_error, dut->error_count, wd_ok ? "PASS" : "*** FAIL ***");
+
+    // Restore the real tree: the next walk must be normal again
+    write_node(dut, tfp, 0, tree[0]);
+    write_node(dut, tfp, 1, tree[1]);
+    dut->market_input = 200;
+    tick(dut, tfp);
+    dut->start = 1;
+    tick(dut, tfp);
+    dut->start = 0;
+    int rec_action = -1, rec_error = -1;
+    for (int c = 0; c < 20; c++) {
+        tick(dut, tfp);
+        if (dut->action_valid) { rec_action = dut->action; rec_error = dut->action_error; break; }
+    }
+    bool rec_ok = rec_action == simulate_tree(tree, 200).action && rec_error == 0 &&
+                  dut->error_count == 1;
+    fprintf(out, "  Recovery:     input 200 → %s, action_error %d, error_count %d  %s\n",
+            action_name(rec_action), rec_error, dut->error_count, rec_ok ? "PASS" : "*** FAIL ***");
+
     // =====================================================================
     // Summary
     // =====================================================================
@@ -350,8 +365,9 @@ int main(int argc, char **argv) {
     fprintf(out, "================================================================\n");
     fprintf(out, "  Spot tests:        %d / %d\n", pass_count, total);
     fprintf(out, "  Exhaustive (0-255): %d / 256\n", exhaust_pass);
+    fprintf(out, "  Hop watchdog:      %s\n", wd_ok && rec_ok ? "PASS" : "*** FAIL ***");
     fprintf(out, "  Design: FSM traversal (linked-list walk)\n");
-    fprintf(out, "  Latency formula: depth cycles\n");
+    fprintf(out, "  Latency formula: depth cycles (at most MAX_DEPTH = %d)\n", WATCHDOG_DEPTH);
     fprintf(out, "  Throughput: 1 result every (depth + 1) cycles (sequential)\n");
     fprintf(out, "  Verification: C++ golden model (simulate_tree)\n");
     fprintf(out, "================================================================\n");
@@ -1,6 +1,7 @@
 #include "Vdecision_tree_pipelined.h"
 #include "verilated.h"
 #include "verilated_vcd_c.h"
+#include "tree_model.h"
 #include <cstdio>
 #include <cstdint>
 #include <vector>
@@ -20,15 +21,6 @@ static void tick(Vdecision_tree_pipelined *dut, VerilatedVcdC *tfp) {
     tfp->flush();
 }
 
-struct Node {
-    uint8_t is_leaf;
-    uint8_t threshold;
-    uint8_t less_than;
-    uint8_t left_idx;
-    uint8_t right_idx;
-    uint8_t action;
-};
-
 struct TestCase {
     uint8_t input;
     int expected_action;   // 0=NONE 1=BUY 2=SELL 3=CANCEL
@@ -36,47 +28,6 @@ struct TestCase {
     const char *label;
 };
 
-static const char *action_name(int a) {
-    switch (a) {
-        case 0: return "NONE  ";
-        case 1: return "BUY   ";
-        case 2: return "SELL  ";
-        case 3: return "CANCEL";
-        default: return "???   ";
-    }
-}
-
-// =========================================================================
-// Software golden model — walks the tree in pure C++, no Verilog involved.
-// This is the reference: if HW disagrees with this, HW has a bug.
-// If this disagrees with our hand-traced expectations, WE had a bug.
-// =========================================================================
-struct SimResult {
-    int action;    // leaf action (0-3)
-    int depth;     // number of edges from root to leaf
-    bool valid;    // false if tree is malformed (loop, missing leaf, etc.)
-};
-
-static SimResult simulate_tree(const std::vector<Node> &tree, uint8_t input) {
-    SimResult r = {0, 0, false};
-    int idx = 0;  // start at root
-
-    for (int step = 0; step < 64; step++) {  // cap at 64 to detect infinite loops
-        if (idx < 0 || idx >= (int)tree.size()) return r;  // out of bounds
-        const Node &n = tree[idx];
-        if (n.is_leaf) {
-            r.action = n.action;
-            r.depth  = step;
-            r.valid  = true;
-            return r;
-        }
-        bool cond = n.less_than ? (input < n.threshold) : (input > n.threshold);
-        idx = cond ? n.left_idx : n.right_idx;
-    }
-
-    return r;  // valid=false — probable cycle in tree
-}
-
 static void write_node(Vdecision_tree_pipelined *dut, VerilatedVcdC *tfp,
                         int addr, const Node &n) {
     dut->sw_we             = 1;
@@ -84,13 +35,27 @@ static void write_node(Vdecision_tree_pipelined *dut, VerilatedVcdC *tfp,
     dut->sw_data_is_leaf   = n.is_leaf;
     dut->sw_data_threshold = n.threshold;
     dut->sw_data_less_than = n.less_than;
-    dut->sw_data_left_idx  = n.left_idx;
-    dut->sw_data_right_idx = n.right_idx;
+    dut->sw_data_left_idx  = engine_child(n.left_idx, 6);
+    dut->sw_data_right_idx = engine_child(n.right_idx, 6);
     dut->sw_data_action    = n.action;
     tick(dut, tfp);
     dut->sw_we = 0;
 }
 
+static void write_template(Vdecision_tree_pipelined *dut, VerilatedVcdC *tfp,
+                           int slot, const OrderTemplate &t) {
+    dut->sw_payload_we   = 1;
+    dut->sw_payload_addr = slot;
+    dut->sw_payload_data = pack_template(t);
+    tick(dut, tfp);
+    dut->sw_payload_we = 0;
+}
+
+// Distinct template per payload slot so a wrong slot can't go unnoticed
+static OrderTemplate slot_template(int slot) {
+    return {(uint8_t)(slot & 3), (uint16_t)(100 + 10 * slot), (int16_t)(slot - 32)};
+}
+
 int main(int argc, char **argv) {
     Verilated::commandArgs(argc, argv);
     Verilated::traceEverOn(true);
@@ -124,19 +89,25 @@ int main(int argc, char **argv) {
         /*  1*/ {0,  64, 1,  3,  4, 0},
         /*  2*/ {0, 192, 1,  5,  6, 0},
         /*  3*/ {0,  32, 1,  7,  8, 0},
-        /*  4*/ {1,   0, 0,  0,  0, 2},   // leaf SELL
+        /*  4*/ {1,   4, 0,  0,  0, 2},   // leaf SELL
         /*  5*/ {0, 160, 1,  9, 10, 0},
-        /*  6*/ {1,   0, 0,  0,  0, 0},   // leaf NONE
+        /*  6*/ {1,   6, 0,  0,  0, 0},   // leaf NONE
         /*  7*/ {0,  16, 1, 11, 12, 0},
-        /*  8*/ {1,   0, 0,  0,  0, 3},   // leaf CANCEL
-        /*  9*/ {1,   0, 0,  0,  0, 1},   // leaf BUY
-        /* 10*/ {1,   0, 0,  0,  0, 2},   // leaf SELL
+        /*  8*/ {1,   8, 0,  0,  0, 3},   // leaf CANCEL
+        /*  9*/ {1,   9, 0,  0,  0, 1},   // leaf BUY
+        /* 10*/ {1,  10, 0,  0,  0, 2},   // leaf SELL
         /* 11*/ {0,   8, 1, 13, 14, 0},
-        /* 12*/ {1,   0, 0,  0,  0, 2},   // leaf SELL
-        /* 13*/ {1,   0, 0,  0,  0, 1},   // leaf BUY
-        /* 14*/ {1,   0, 0,  0,  0, 3},   // leaf CANCEL
+        /* 12*/ {1,  12, 0,  0,  0, 2},   // leaf SELL
+        /* 13*/ {1,  13, 0,  0,  0, 1},   // leaf BUY
+        /* 14*/ {1,  14, 0,  0,  0, 3},   // leaf CANCEL
     };
 
+#ifdef INLINE_LEAVES
+    // Engine built with INLINE_LEAVES=1: fold leaf nodes into child pointers
+    // (15 nodes → 7); each query resolves one stage earlier.
+    tree = inline_leaves(tree);
+#endif
+
     // Build test cases from the software golden model (no hand-tracing!)
     uint8_t spot_inputs[] = {4, 10, 20, 40, 80, 140, 170, 200, 0, 127, 128, 255};
     std::vector<TestCase> tests;
@@ -154,13 +125,22 @@ int main(int argc, char **argv) {
     dut->rst   = 1;
     dut->start = 0;
     dut->sw_we = 0;
+    dut->sw_payload_we = 0;
     tick(dut, tfp); tick(dut, tfp);
     dut->rst = 0;
     tick(dut, tfp);
 
     // ----- Load tree -----
+    // With TREE_PRELOADED the same tree was baked in via TREE_INIT_FILE
+    // (models/test_tree.tree → tree2mem), so there is nothing to program.
+#ifndef TREE_PRELOADED
     for (int i = 0; i < (int)tree.size(); i++)
         write_node(dut, tfp, i, tree[i]);
+#endif
+
+    // ----- Load order templates (PAYLOAD_ENTRIES = 64) -----
+    for (int k = 0; k < 64; k++)
+        write_template(dut, tfp, k, slot_template(k));
 
     tick(dut, tfp);
 
@@ -324,6 +304,7 @@ int main(int argc, char **argv) {
 
     int exhaust_pass = 0;
     int exhaust_fail = 0;
+    int payload_pass = 0;
 
     for (int inp = 0; inp < 256; inp++) {
         SimResult sw = simulate_tree(tree, (uint8_t)inp);
@@ -334,11 +315,13 @@ int main(int argc, char **argv) {
         dut->start = 0;
 
         int hw_action = -1;
+        uint32_t hw_payload = 0;
         bool got = false;
         for (int c = 0; c < 20; c++) {
             tick(dut, tfp);
             if (dut->action_valid) {
-                hw_action = dut->action;
+                hw_action  = dut->action;
+                hw_payload = dut->payload;   // same cycle as action_valid
                 got = true;
                 break;
             }
@@ -347,6 +330,14 @@ int main(int argc, char **argv) {
         // Drain pipeline between tests
         tick(dut, tfp); tick(dut, tfp);
 
+        uint32_t sw_payload = pack_template(slot_template(sw.slot));
+        if (got && hw_payload == sw_payload) {
+            payload_pass++;
+        } else {
+            fprintf(out, "  PAYLOAD MISMATCH input=%3d: slot %d expected %08x got %08x\n",
+                    inp, sw.slot, sw_payload, hw_payload);
+        }
+
         if (got && hw_action == sw.action) {
             exhaust_pass++;
         } else {
@@ -360,6 +351,7 @@ int main(int argc, char **argv) {
     if (exhaust_fail == 0)
         fprintf(out, "  All 256 inputs match the golden model.\n");
     fprintf(out, "  Passed: %d / 256    Failed: %d / 256\n", exhaust_pass, exhaust_fail);
+    fprintf(out, "  Payload (order template with action_valid): %d / 256\n", payload_pass);
 
     // =====================================================================
     // Summary
@@ -369,6 +361,7 @@ int main(int argc, char **argv) {
     fprintf(out, "================================================================\n");
     fprintf(out, "  Spot tests:        %d / %d\n", pass_count, total);
     fprintf(out, "  Exhaustive (0-255): %d / 256\n", exhaust_pass);
+    fprintf(out, "  Payload (0-255):    %d / 256\n", payload_pass);
     fprintf(out, "  Design: Pipelined (MAX_DEPTH=6 stages)\n");
     fprintf(out, "  Latency formula: MAX_DEPTH + 2 cycles (fixed, all inputs)\n");
     fprintf(out, "  Throughput: 1 result per cycle (after pipeline fills)\n");
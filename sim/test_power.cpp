@@ -0,0 +1,216 @@
+#if defined(POWER_ORIG)
+#include "Vdecision_tree.h"
+typedef Vdecision_tree Dut;
+#elif defined(POWER_FARM)
+#include "Vdecision_tree_farm.h"
+typedef Vdecision_tree_farm Dut;
+#elif defined(POWER_CACHED)
+#include "Vdecision_tree_cached.h"
+typedef Vdecision_tree_cached Dut;
+#else
+#include "Vdecision_tree_pipelined.h"
+typedef Vdecision_tree_pipelined Dut;
+#endif
+#include "verilated.h"
+#include "verilated_saif_c.h"
+#include "tree_model.h"
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <string>
+#include <vector>
+
+// =========================================================================
+// Switching-activity capture for power estimation
+// Output: power_<tag>.saif, results_power_<tag>.txt, one row appended to
+//         power_runs.csv (read by vivado/scripts/power.tcl)
+//
+// Built once per engine: -DPOWER_ORIG / -DPOWER_FARM / -DPOWER_CACHED
+// (default: pipelined), with the parameter set given as -G generics.
+// --params repeats those generics ("NAME=VALUE ...") so power.tcl can
+// synthesise the same configuration; --tag names the run.  `make
+// test-power` does all of this.
+//
+// Usage: test_power [trace.txt] [--load P] [--ticks N] [--tag T] [--params "K=V ..."]
+//
+// Replays a market_input trace (one value per line, see read_trace_file)
+// or a synthetic random-walk feed.  Each cycle a new tick arrives with
+// probability P (default 0.25); ticks wait in a queue until the engine can
+// take them, so slower engines run longer for the same feed.  After reset
+// and tree programming the SAIF window opens: it covers only the replay,
+// which is what report_power averages over.  The clock is 10 ns, matching
+// timing.xdc, and the SAIF timescale is the RTL's 1 ps precision, so edges
+// are dumped at real times (5000 ps per half period).
+// =========================================================================
+
+#if defined(POWER_ORIG)
+static const char *ENGINE = "orig", *TOP = "decision_tree";
+#elif defined(POWER_FARM)
+static const char *ENGINE = "farm", *TOP = "decision_tree_farm";
+#elif defined(POWER_CACHED)
+static const char *ENGINE = "cached", *TOP = "decision_tree_cached";
+#else
+static const char *ENGINE = "pipe", *TOP = "decision_tree_pipelined";
+#endif
+
+static const int PERIOD_PS = 10000;
+
+vluint64_t sim_time = 0;
+double sc_time_stamp() { return sim_time; }
+
+static VerilatedSaifC *saif = nullptr;
+
+static void tick(Dut *dut) {
+    dut->clk = 0; dut->eval(); if (saif) saif->dump(sim_time); sim_time += PERIOD_PS / 2;
+    dut->clk = 1; dut->eval(); if (saif) saif->dump(sim_time); sim_time += PERIOD_PS / 2;
+}
+
+static void write_node(Dut *dut, int addr, const Node &n) {
+    dut->sw_we             = 1;
+    dut->sw_addr           = addr;
+    dut->sw_data_is_leaf   = n.is_leaf;
+    dut->sw_data_threshold = n.threshold;
+    dut->sw_data_less_than = n.less_than;
+    dut->sw_data_left_idx  = engine_child(n.left_idx, 6);
+    dut->sw_data_right_idx = engine_child(n.right_idx, 6);
+    dut->sw_data_action    = n.action;
+    tick(dut);
+    dut->sw_we = 0;
+}
+
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    Verilated::traceEverOn(true);
+
+    double      load  = 0.25;
+    long        ticks = 20000;
+    const char *trace_file = nullptr;
+    std::string tag = ENGINE, params;
+    for (int a = 1; a < argc; a++) {
+        std::string o = argv[a];
+        if (o[0] == '+') continue;                               // +verilator+ args
+        else if (o == "--load" && a + 1 < argc)  load  = atof(argv[++a]);
+        else if (o == "--ticks" && a + 1 < argc) ticks = atol(argv[++a]);
+        else if (o == "--tag" && a + 1 < argc)   tag   = argv[++a];
+        else if (o == "--params" && a + 1 < argc) params = argv[++a];
+        else                                     trace_file = argv[a];
+    }
+
+    std::vector<Node> tree;
+    if (!read_tree_file("models/test_tree.tree", tree)) return 1;
+
+    // ----- Feed: trace file or a random walk with repeats -----
+    std::vector<uint8_t> feed;
+    if (trace_file) {
+        if (!read_trace_file(trace_file, feed)) return 1;
+    } else {
+        uint32_t lfsr = 0xACE1u;
+        int x = 128;
+        for (long i = 0; i < ticks; i++) {
+            lfsr = lfsr * 1103515245u + 12345u;
+            int step = (int)((lfsr >> 16) % 7) - 3;
+            x = x + step < 0 ? 0 : x + step > 255 ? 255 : x + step;
+            feed.push_back((uint8_t)x);
+        }
+    }
+
+    auto *dut = new Dut;
+
+    // ----- Reset + program (outside the SAIF window) -----
+    dut->rst   = 1;
+    dut->start = 0;
+    dut->sw_we = 0;
+#ifdef POWER_CACHED
+    dut->cache_en = 1;
+#endif
+    tick(dut); tick(dut);
+    dut->rst = 0;
+    tick(dut);
+    for (int i = 0; i < (int)tree.size(); i++) write_node(dut, i, tree[i]);
+    tick(dut);
+
+    std::string saif_path = "power_" + tag + ".saif";
+    saif = new VerilatedSaifC;
+    dut->trace(saif, 99);
+    saif->open(saif_path.c_str());
+    vluint64_t window_start = sim_time;
+
+    // ----- Replay -----
+    std::deque<uint8_t> queue;
+    uint32_t lfsr = 0x1234567u;
+    size_t next = 0;
+    long   cycles = 0, inferences = 0, queue_max = 0;
+#ifdef POWER_ORIG
+    bool busy = false;                       // one walk at a time
+#endif
+
+    while (next < feed.size() || !queue.empty() || cycles < 16 ||
+           inferences < (long)feed.size()) {
+        lfsr = lfsr * 1103515245u + 12345u;
+        if (next < feed.size() && (lfsr >> 16) % 10000 < load * 10000)
+            queue.push_back(feed[next++]);
+        if ((long)queue.size() > queue_max) queue_max = (long)queue.size();
+
+        // Outputs from the previous edge
+        if (dut->action_valid) inferences++;
+
+        // Offer the head of the queue if the engine can take it this cycle
+#if defined(POWER_ORIG)
+        bool can = !busy || dut->action_valid;
+#elif defined(POWER_FARM)
+        bool can = dut->ready;
+#else
+        bool can = true;
+#endif
+        bool go = can && !queue.empty();
+        dut->start        = go;
+        dut->market_input = go ? queue.front() : 0;
+        if (go) queue.pop_front();
+#ifdef POWER_ORIG
+        if (go) busy = true;
+        else if (dut->action_valid) busy = false;
+#endif
+
+        tick(dut);
+        cycles++;
+        if (cycles > 64 * (long)feed.size() + 1000) break;       // engine hung
+    }
+    dut->start = 0;
+    saif->close();
+
+    double window_ns = (sim_time - window_start) / 1000.0;
+    bool ok = inferences == (long)feed.size();
+
+    FILE *out = fopen(("results_power_" + tag + ".txt").c_str(), "w");
+    fprintf(out, "================================================================\n");
+    fprintf(out, "  Switching Activity Capture — %s (%s %s)\n", tag.c_str(), TOP, params.c_str());
+    fprintf(out, "================================================================\n\n");
+    fprintf(out, "  Feed:           %s, %zu ticks, offered load %.2f / cycle\n",
+            trace_file ? trace_file : "synthetic random walk", feed.size(), load);
+    fprintf(out, "  SAIF window:    %ld cycles (%.0f ns at %d ns/cycle)\n",
+            cycles, window_ns, PERIOD_PS / 1000);
+    fprintf(out, "  Inferences:     %ld / %zu   (%.3f per cycle, max queue %ld)\n",
+            inferences, feed.size(), cycles ? (double)inferences / cycles : 0.0, queue_max);
+    fprintf(out, "  SAIF:           %s\n\n", saif_path.c_str());
+    fprintf(out, "  Energy per inference = report_power x window / inferences\n");
+    fprintf(out, "  (vivado/scripts/power.tcl, vivado/output/power/summary.csv)\n");
+    fprintf(out, "\n================================================================\n");
+    fprintf(out, "  Summary: %s\n", ok ? "PASS" : "*** FAIL *** (not every tick was answered)");
+    fprintf(out, "================================================================\n");
+    fclose(out);
+
+    FILE *csv = fopen("power_runs.csv", "a");
+    if (csv) {
+        fprintf(csv, "%s,%s,%s,%s,%s,%ld,%ld,%.1f\n", tag.c_str(), ENGINE, TOP, params.c_str(),
+                saif_path.c_str(), cycles, inferences, window_ns);
+        fclose(csv);
+    }
+
+    printf("Power capture %s %s — %ld inferences in %ld cycles → %s\n", tag.c_str(),
+           ok ? "PASS" : "FAIL", inferences, cycles, saif_path.c_str());
+
+    delete saif;
+    delete dut;
+    return ok ? 0 : 1;
+}
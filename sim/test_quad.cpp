@@ -0,0 +1,214 @@
+#include "Vdecision_tree_quad.h"
+#include "verilated.h"
+#include "verilated_vcd_c.h"
+#include "tree_quad.h"
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+
+// =========================================================================
+// Test harness for the 4-ary (quad) pipelined decision tree
+// Output: results_quad.txt
+//
+// Usage: test_quad [model.tree]   (binary model, default models/test_tree.tree)
+//
+// The binary model is converted with convert_to_quad(), loaded through the
+// quad sw_* interface and checked against the BINARY golden model, so the
+// converter and the engine are verified together.
+// =========================================================================
+
+static const int QUAD_ADDR_WIDTH = 6;   // MAX_NODES = 64
+static const int QUAD_MAX_DEPTH  = 4;
+
+vluint64_t sim_time = 0;
+double sc_time_stamp() { return sim_time; }
+
+static void tick(Vdecision_tree_quad *dut, VerilatedVcdC *tfp) {
+    dut->clk = 0; dut->eval(); tfp->dump(sim_time); sim_time += 5;
+    dut->clk = 1; dut->eval(); tfp->dump(sim_time); sim_time += 5;
+    tfp->flush();
+}
+
+static void write_quad_node(Vdecision_tree_quad *dut, VerilatedVcdC *tfp,
+                            int addr, const QuadNode &n) {
+    uint32_t thr = 0, child = 0;
+    for (int k = 2; k >= 0; k--) thr   = (thr << 8) | n.threshold[k];
+    for (int k = 3; k >= 0; k--) child = (child << QUAD_ADDR_WIDTH) | n.child[k];
+
+    dut->sw_we             = 1;
+    dut->sw_addr           = addr;
+    dut->sw_data_is_leaf   = n.is_leaf;
+    dut->sw_data_threshold = thr;      // packed [2:0][7:0], [0] in the LSBs
+    dut->sw_data_child_idx = child;    // packed [3:0][5:0], [0] in the LSBs
+    dut->sw_data_action    = n.action;
+    tick(dut, tfp);
+    dut->sw_we = 0;
+}
+
+// One query, returns latency in cycles after the start tick (-1 = timeout).
+static int run_query(Vdecision_tree_quad *dut, VerilatedVcdC *tfp,
+                     uint8_t input, int &action) {
+    dut->market_input = input;
+    dut->start = 1;
+    tick(dut, tfp);
+    dut->start = 0;
+
+    for (int c = 1; c <= 20; c++) {
+        tick(dut, tfp);
+        if (dut->action_valid) {
+            action = dut->action;
+            tick(dut, tfp); tick(dut, tfp);   // let pipeline drain
+            return c;
+        }
+    }
+    return -1;
+}
+
+int main(int argc, char **argv) {
+    Verilated::commandArgs(argc, argv);
+    Verilated::traceEverOn(true);
+
+    const char *model = "models/test_tree.tree";
+    for (int a = 1; a < argc; a++)
+        if (argv[a][0] != '+') model = argv[a];
+
+    std::vector<Node> tree;
+    std::vector<QuadNode> quad;
+    if (!read_tree_file(model, tree)) return 1;
+    if (!convert_to_quad(tree, quad) || (int)quad.size() > (1 << QUAD_ADDR_WIDTH)) {
+        fprintf(stderr, "error: %s does not convert to a %d-node quad tree\n",
+                model, 1 << QUAD_ADDR_WIDTH);
+        return 1;
+    }
+    if (quad_depth(quad) > QUAD_MAX_DEPTH - 1) {
+        fprintf(stderr, "error: quad depth %d needs MAX_DEPTH >= %d\n",
+                quad_depth(quad), quad_depth(quad) + 1);
+        return 1;
+    }
+
+    auto *dut = new Vdecision_tree_quad;
+    auto *tfp = new VerilatedVcdC;
+    dut->trace(tfp, 99);
+    tfp->open("test_quad.vcd");
+
+    FILE *out = fopen("results_quad.txt", "w");
+
+    // ----- Reset -----
+    dut->rst   = 1;
+    dut->start = 0;
+    dut->sw_we = 0;
+    tick(dut, tfp); tick(dut, tfp);
+    dut->rst = 0;
+    tick(dut, tfp);
+
+    // ----- Load converted tree -----
+    for (int i = 0; i < (int)quad.size(); i++)
+        write_quad_node(dut, tfp, i, quad[i]);
+    tick(dut, tfp);
+
+    fprintf(out, "================================================================\n");
+    fprintf(out, "  Decision Tree Test — QUAD (4-ary) Pipelined (MAX_DEPTH=%d)\n", QUAD_MAX_DEPTH);
+    fprintf(out, "================================================================\n\n");
+    fprintf(out, "Model: %s\n", model);
+    fprintf(out, "  binary: %2d nodes, depth %d  (needs MAX_DEPTH=%d, %d-cycle latency)\n",
+            (int)tree.size(), tree_depth(tree), tree_depth(tree) + 1, tree_depth(tree) + 3);
+    fprintf(out, "  quad:   %2d nodes, depth %d  (needs MAX_DEPTH=%d, %d-cycle latency)\n\n",
+            (int)quad.size(), quad_depth(quad), quad_depth(quad) + 1, quad_depth(quad) + 3);
+
+    // =====================================================================
+    // Individual query tests
+    // =====================================================================
+    fprintf(out, "----------------------------------------------------------------\n");
+    fprintf(out, "  Individual Query Tests  (latency = cycles from start to valid)\n");
+    fprintf(out, "----------------------------------------------------------------\n\n");
+    fprintf(out, "  Input | Bin depth | Quad depth | Expected | Got      | Cycles | Status\n");
+    fprintf(out, "  ------|-----------|------------|----------|----------|--------|------\n");
+
+    uint8_t spot_inputs[] = {4, 10, 20, 40, 80, 140, 170, 200, 0, 127, 128, 255};
+    int pass_count = 0;
+    int total      = (int)sizeof(spot_inputs);
+
+    for (uint8_t inp : spot_inputs) {
+        SimResult sw = simulate_tree(tree, inp);
+        SimResult qw = simulate_quad(quad, inp);
+        int got_action = -1;
+        int cycles = run_query(dut, tfp, inp, got_action);
+        bool ok = cycles > 0 && got_action == sw.action;
+        if (ok) pass_count++;
+
+        fprintf(out, "  %5d |     %d     |      %d     | %s | %s | %6d | %s\n",
+                inp, sw.depth, qw.depth,
+                action_name(sw.action),
+                cycles > 0 ? action_name(got_action) : "TIMEOUT",
+                cycles, ok ? "PASS" : "*** FAIL ***");
+    }
+
+    // =====================================================================
+    // Streaming — 256 inputs back to back, in-order results
+    // =====================================================================
+    fprintf(out, "\n----------------------------------------------------------------\n");
+    fprintf(out, "  Streaming Verification  (256 inputs on consecutive cycles)\n");
+    fprintf(out, "----------------------------------------------------------------\n\n");
+
+    int received    = 0;
+    int stream_pass = 0;
+    for (int c = 0; c < 256 + 30 && received < 256; c++) {
+        dut->start        = c < 256;
+        dut->market_input = c < 256 ? c : 0;
+        tick(dut, tfp);
+        if (dut->action_valid) {
+            if (dut->action == simulate_tree(tree, (uint8_t)received).action)
+                stream_pass++;
+            else
+                fprintf(out, "  MISMATCH input=%3d (stream)\n", received);
+            received++;
+        }
+    }
+    dut->start = 0;
+    fprintf(out, "  Received: %d / 256    Correct: %d / 256\n", received, stream_pass);
+
+    // =====================================================================
+    // Exhaustive verification — one query at a time
+    // =====================================================================
+    fprintf(out, "\n----------------------------------------------------------------\n");
+    fprintf(out, "  Exhaustive Verification  (all 256 inputs vs binary golden model)\n");
+    fprintf(out, "----------------------------------------------------------------\n\n");
+
+    int exhaust_pass = 0;
+    for (int inp = 0; inp < 256; inp++) {
+        SimResult sw = simulate_tree(tree, (uint8_t)inp);
+        int hw_action = -1;
+        int cycles = run_query(dut, tfp, (uint8_t)inp, hw_action);
+        if (cycles == QUAD_MAX_DEPTH + 1 && hw_action == sw.action) {
+            exhaust_pass++;
+        } else {
+            fprintf(out, "  MISMATCH input=%3d: SW=%s HW=%s (%d cycles)\n",
+                    inp, action_name(sw.action),
+                    cycles > 0 ? action_name(hw_action) : "TIMEOUT", cycles);
+        }
+    }
+    if (exhaust_pass == 256)
+        fprintf(out, "  All 256 inputs match the golden model with fixed latency.\n");
+    fprintf(out, "  Passed: %d / 256    Failed: %d / 256\n", exhaust_pass, 256 - exhaust_pass);
+
+    // =====================================================================
+    // Summary
+    // =====================================================================
+    bool pass = pass_count == total && received == 256 && stream_pass == 256 && exhaust_pass == 256;
+    fprintf(out, "\n================================================================\n");
+    fprintf(out, "  Summary\n");
+    fprintf(out, "================================================================\n");
+    fprintf(out, "  Spot tests:         %d / %d\n", pass_count, total);
+    fprintf(out, "  Streaming:          %d / 256\n", stream_pass);
+    fprintf(out, "  Exhaustive (0-255): %d / 256\n", exhaust_pass);
+    fprintf(out, "  Design: Quad pipelined (MAX_DEPTH=%d stages)\n", QUAD_MAX_DEPTH);
+    fprintf(out, "  Latency formula: MAX_DEPTH + 2 cycles (fixed, all inputs)\n");
+    fprintf(out, "================================================================\n");
+
+    printf("Quad test %s — results written to results_quad.txt\n", pass ? "PASS" : "FAIL");
+
+    fclose(out);
+    tfp->close();
+    delete dut;
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// =========================================================================
+// Query traffic generators for load sweeps
+// =========================================================================
+//
+// Produces an arrival schedule: the cycle each query becomes available and
+// its market_input.  Offered load is relative to line rate, one query per
+// cycle (what the pipelined engine accepts), so load = 0.25 means one query
+// every 4 cycles on average.  Queries arriving in the same cycle, or while
+// the engine cannot take them, are the harness's to queue.
+//
+//   constant  evenly spaced, 1 / load cycles apart
+//   poisson   exponential inter-arrival times, mean 1 / load
+//   bursty    on/off: back-to-back at line rate for a geometric burst
+//             (mean burst_len queries), then silent long enough that the
+//             mean rate is load
+//   replay    recorded arrival times (e.g. pcap timestamps), uniformly
+//             rescaled so the whole recording has mean rate load; the
+//             burst structure of the capture is kept
+//
+//   TrafficConfig cfg = {TrafficPattern::Poisson, 0.3};
+//   std::vector<Arrival> a = make_traffic(cfg, 20000);
+//
+// Synthetic patterns draw inputs from a bounded random walk with repeats
+// (the same shape as a quiet market); replay uses the recorded values.
+// Everything is seeded, so a sweep is reproducible.
+// =========================================================================
+
+enum class TrafficPattern { Constant, Poisson, Bursty, Replay };
+
+static inline const char *traffic_name(TrafficPattern p) {
+    switch (p) {
+    case TrafficPattern::Constant: return "constant";
+    case TrafficPattern::Poisson:  return "poisson";
+    case TrafficPattern::Bursty:   return "bursty";
+    default:                       return "replay";
+    }
+}
+
+static inline bool parse_traffic(const std::string &s, TrafficPattern &p) {
+    if      (s == "constant") p = TrafficPattern::Constant;
+    else if (s == "poisson")  p = TrafficPattern::Poisson;
+    else if (s == "bursty")   p = TrafficPattern::Bursty;
+    else if (s == "replay")   p = TrafficPattern::Replay;
+    else return false;
+    return true;
+}
+
+struct Arrival {
+    uint64_t cycle;
+    uint8_t  input;
+};
+
+struct TrafficConfig {
+    TrafficPattern pattern;
+    double   load;                     // offered queries per cycle, (0, 1]
+    double   burst_len = 32;           // bursty: mean queries per burst
+    uint64_t seed = 0x7a3f19c5u;
+
+    // replay: recorded arrival times (any unit, non-decreasing) and inputs
+    const std::vector<uint64_t> *replay_times  = nullptr;
+    const std::vector<uint8_t>  *replay_inputs = nullptr;
+};
+
+struct TrafficRng {
+    uint64_t s;
+    uint32_t next() { s = s * 6364136223846793005ull + 1442695040888963407ull; return (uint32_t)(s >> 33); }
+    double   uniform() { return (next() + 0.5) / 2147483648.0; }          // (0, 1)
+};
+
+// n arrivals, in non-decreasing cycle order, starting at cycle 0.  A
+// replay shorter than n wraps around, continuing after its last arrival.
+static inline std::vector<Arrival> make_traffic(const TrafficConfig &cfg, size_t n) {
+    std::vector<Arrival> out;
+    out.reserve(n);
+    TrafficRng rng = {cfg.seed};
+    double load = cfg.load > 1.0 ? 1.0 : cfg.load;
+
+    if (cfg.pattern == TrafficPattern::Replay) {
+        const std::vector<uint64_t> &t = *cfg.replay_times;
+        const std::vector<uint8_t>  &v = *cfg.replay_inputs;
+        size_t m = t.size();
+        if (m == 0 || load <= 0) return out;
+        // The recording spans [t0, t_last]; one pass of m arrivals occupies
+        // m / load cycles, so the mean rate over repeated passes is load.
+        double span  = (double)(t[m - 1] - t[0]);
+        double pass  = m / load;
+        double scale = span > 0 ? (pass - pass / m) / span : 0;
+        for (size_t k = 0; k < n; k++) {
+            size_t i = k % m;
+            double c = (k / m) * pass + (t[i] - t[0]) * scale;
+            out.push_back({(uint64_t)c, v[i]});
+        }
+        return out;
+    }
+
+    int x = 128;
+    auto input = [&]() {
+        int step = (int)(rng.next() % 7) - 3;
+        x = x + step < 0 ? 0 : x + step > 255 ? 255 : x + step;
+        return (uint8_t)x;
+    };
+
+    double t = 0;
+    for (size_t k = 0; k < n; k++) {
+        out.push_back({(uint64_t)t, input()});
+        switch (cfg.pattern) {
+        case TrafficPattern::Constant:
+            t += 1.0 / load;
+            break;
+        case TrafficPattern::Poisson:
+            t += -std::log(rng.uniform()) / load;
+            break;
+        case TrafficPattern::Bursty:
+            // Ends the burst with probability 1 / burst_len after each
+            // query; an off period averages burst_len * (1 - load) / load
+            // cycles, so the duty cycle is load.
+            t += 1.0;
+            if (load < 1.0 && rng.uniform() < 1.0 / cfg.burst_len)
+                t += -std::log(rng.uniform()) * cfg.burst_len * (1.0 - load) / load;
+            break;
+        default:
+            break;
+        }
+    }
+    return out;
+}
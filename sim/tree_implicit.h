@@ -0,0 +1,81 @@
+#pragma once
+
+#include "tree_model.h"
+
+// =========================================================================
+// Implicit-indexed complete tree — converter from node arrays + golden model
+// =========================================================================
+//
+// A complete binary tree of `depth` levels needs no child pointers: the
+// node at position p of level s has its children at positions 2p and
+// 2p + 1 of level s + 1 (BFS index i → 2i + 1, 2i + 2).  A split stores
+// only {threshold, less_than}; the leaves are all on level `depth` and
+// store only an action.  The branch taken is appended to the position:
+//
+//   p' = 2p + (cond ? 0 : 1)       cond true → left, as in the node format
+//
+// Mirrors the per-level memories of rtl/decision_tree_implicit.sv.
+//
+// Sparse trees are padded: a leaf above the last level becomes a split
+// that sends every input right (x < 0), with the same leaf in both
+// subtrees, so every input still reaches the same action.  The leaf's
+// payload slot is not kept (the implicit engine has no payload RAM).
+
+struct ImplicitTree {
+    int depth = 0;                     // split levels; leaves are on level `depth`
+    std::vector<uint8_t> threshold;    // BFS order, (1 << depth) - 1 splits
+    std::vector<uint8_t> less_than;
+    std::vector<uint8_t> action;       // 1 << depth leaves, left to right
+};
+
+// Bits of node storage: 9 per split, 2 per leaf
+static inline int implicit_bits(const ImplicitTree &t) {
+    return 9 * (int)t.threshold.size() + 2 * (int)t.action.size();
+}
+
+static inline int implicit_action(const ImplicitTree &t, uint8_t input) {
+    int pos = 0;
+    for (int s = 0; s < t.depth; s++) {
+        int i = (1 << s) - 1 + pos;
+        bool cond = t.less_than[i] ? input < t.threshold[i] : input > t.threshold[i];
+        pos = 2 * pos + (cond ? 0 : 1);
+    }
+    return t.action[pos];
+}
+
+// Fills the subtree at (level, pos) from node `child` (an index or an
+// inline leaf pointer).  False if a leaf lies deeper than t.depth.
+static inline bool fill_implicit(const std::vector<Node> &tree, ImplicitTree &t,
+                                 uint8_t child, int level, int pos) {
+    bool leaf   = is_inline_leaf(child) || (child < tree.size() && tree[child].is_leaf);
+    int  action = is_inline_leaf(child) ? (child & 3) : (child < tree.size() ? tree[child].action : 0);
+    if (!leaf && child >= tree.size()) return false;
+
+    if (level == t.depth) {
+        if (!leaf) return false;
+        t.action[pos] = action;
+        return true;
+    }
+    int i = (1 << level) - 1 + pos;
+    if (leaf) {
+        t.threshold[i] = 0;            // pad: x < 0 never holds, both sides agree
+        t.less_than[i] = 1;
+        return fill_implicit(tree, t, child, level + 1, 2 * pos) &&
+               fill_implicit(tree, t, child, level + 1, 2 * pos + 1);
+    }
+    const Node &n = tree[child];
+    t.threshold[i] = n.threshold;
+    t.less_than[i] = n.less_than;
+    return fill_implicit(tree, t, n.left_idx,  level + 1, 2 * pos) &&
+           fill_implicit(tree, t, n.right_idx, level + 1, 2 * pos + 1);
+}
+
+// Pads `tree` into a complete tree of `depth` split levels; false if a
+// leaf is deeper than `depth` or a child points outside the tree.
+static inline bool to_implicit(const std::vector<Node> &tree, int depth, ImplicitTree &t) {
+    t.depth = depth;
+    t.threshold.assign((1 << depth) - 1, 0);
+    t.less_than.assign((1 << depth) - 1, 0);
+    t.action.assign(1 << depth, 0);
+    return !tree.empty() && fill_implicit(tree, t, 0, 0, 0);
+}
@@ -0,0 +1,205 @@
+#pragma once
+
+#include "tree_model.h"
+#include <algorithm>
+#include <bitset>
+
+// =========================================================================
+// Bitmask (set-membership) split nodes — converter + golden model
+// =========================================================================
+//
+// A mask node branches on whether market_input is in a programmable set:
+//
+//   bucket = input >> (8 - log2(mask_bits))     (input itself at 256 bits)
+//   cond   = masks[threshold][bucket]           → left if set, else right
+//
+// mask_bits = 256 tests the exact input; mask_bits = 32 tests the coarse
+// bucket input / 8.  A node is a mask node when is_mask is set, and its
+// threshold field then selects the mask.  Mirrors node_t / mask_mem in
+// rtl/decision_tree_mask.sv.
+//
+// Leaves carry an action only: the mask engine has no payload RAM, so the
+// converter ignores payload slots, as the implicit converter does.
+
+struct MaskNode {
+    uint8_t is_leaf;
+    uint8_t is_mask;
+    uint8_t threshold;     // mask node: mask index
+    uint8_t less_than;
+    uint8_t left_idx;
+    uint8_t right_idx;
+    uint8_t action;
+};
+
+struct MaskTree {
+    int mask_bits = 256;
+    std::vector<MaskNode>         nodes;
+    std::vector<std::bitset<256>> masks;   // bit b = bucket b (low mask_bits used)
+};
+
+static inline int mask_bucket(int mask_bits, uint8_t input) {
+    int shift = 0;
+    while ((256 >> shift) > mask_bits) shift++;
+    return input >> shift;
+}
+
+static inline SimResult simulate_mask(const MaskTree &t, uint8_t input) {
+    SimResult r = {0, 0, false, false, 0};
+    int idx = 0;
+    for (int step = 0; step < 64; step++) {
+        if (idx >= (int)t.nodes.size()) return r;
+        const MaskNode &n = t.nodes[idx];
+        if (n.is_leaf) {
+            r.action = n.action;
+            r.slot   = n.action;
+            r.depth  = step;
+            r.valid  = true;
+            return r;
+        }
+        bool cond;
+        if (n.is_mask)
+            cond = n.threshold < t.masks.size() && t.masks[n.threshold][mask_bucket(t.mask_bits, input)];
+        else
+            cond = n.less_than ? input < n.threshold : input > n.threshold;
+        idx = cond ? n.left_idx : n.right_idx;
+    }
+    return r;
+}
+
+// Deepest leaf (edges from the root); -1 if some input never reaches one
+static inline int mask_depth(const MaskTree &t) {
+    int depth = 0;
+    for (int inp = 0; inp < 256; inp++) {
+        SimResult r = simulate_mask(t, (uint8_t)inp);
+        if (!r.valid) return -1;
+        if (r.depth > depth) depth = r.depth;
+    }
+    return depth;
+}
+
+// -------------------------------------------------------------------------
+// Threshold tree → mask tree
+// -------------------------------------------------------------------------
+// Top down, each threshold subtree is visited with the input range [lo, hi]
+// that reaches it.  If the range sees k >= 2 actions, the whole subtree can
+// be replaced by a balanced tree of k - 1 mask nodes on the action (depth 1
+// for k = 2, depth 2 for k = 3 or 4) — a chain of threshold splits
+// carving out bands becomes one node.  That happens when it is shallower
+// than the subtree over the range, the masks fit the budget, and (coarse
+// masks) the action is constant on every bucket's part of the range.
+// Otherwise the split is kept and its children visited with the narrowed
+// ranges; a split the range has already decided is skipped.  Leaves are
+// shared, one per action.  With 256-bit masks and a budget of 3 or more,
+// any model deeper than 2 becomes at most 3 mask nodes and depth 2.
+struct MaskConverter {
+    const std::vector<Node> &bin;
+    MaskTree                 out;
+    int                      max_masks;
+    int                      leaf_idx[4] = {-1, -1, -1, -1};
+    bool                     ok = true;
+
+    MaskConverter(const std::vector<Node> &b, int bits, int budget) : bin(b), max_masks(budget) {
+        out.mask_bits = bits;
+    }
+
+    // Walk the threshold subtree at `child` for one input: action and hops
+    bool walk(uint8_t child, uint8_t x, int &action, int &hops) const {
+        hops = 0;
+        for (int guard = 0; guard < 64; guard++) {
+            if (is_inline_leaf(child)) { action = child & 3; return true; }
+            if (child >= bin.size()) return false;
+            const Node &n = bin[child];
+            if (n.is_leaf) { action = n.action; return true; }
+            bool cond = n.less_than ? x < n.threshold : x > n.threshold;
+            child = cond ? n.left_idx : n.right_idx;
+            hops++;
+        }
+        return false;
+    }
+
+    int leaf(int action) {
+        if (leaf_idx[action] < 0) {
+            leaf_idx[action] = (int)out.nodes.size();
+            out.nodes.push_back({1, 0, 0, 0, 0, 0, (uint8_t)action});
+        }
+        return leaf_idx[action];
+    }
+
+    int add_mask(const std::bitset<256> &m) {
+        for (int i = 0; i < (int)out.masks.size(); i++)
+            if (out.masks[i] == m) return i;
+        out.masks.push_back(m);
+        return (int)out.masks.size() - 1;
+    }
+
+    // Mask nodes separating the actions in `acts` over the range; f[x] is
+    // the action of input x (-1 outside the range)
+    int build_masks(const std::vector<int> &acts, const int f[256]) {
+        if (acts.size() == 1) return leaf(acts[0]);
+        size_t half = acts.size() / 2;
+        std::vector<int> a(acts.begin(), acts.begin() + half), b(acts.begin() + half, acts.end());
+        std::bitset<256> m;
+        for (int x = 0; x < 256; x++)
+            for (int act : a)
+                if (f[x] == act) m.set(mask_bucket(out.mask_bits, (uint8_t)x));
+        int id = (int)out.nodes.size();
+        out.nodes.push_back({0, 1, (uint8_t)add_mask(m), 0, 0, 0, 0});
+        int l = build_masks(a, f);
+        int r = build_masks(b, f);
+        out.nodes[id].left_idx  = (uint8_t)l;
+        out.nodes[id].right_idx = (uint8_t)r;
+        return id;
+    }
+
+    int convert(uint8_t child, int lo, int hi) {
+        int f[256], bucket_act[256];
+        bool seen[4] = {false, false, false, false}, pure = true;
+        int depth = 0;
+        for (int b = 0; b < 256; b++) bucket_act[b] = -1;
+        for (int x = 0; x < 256; x++) {
+            f[x] = -1;
+            if (x < lo || x > hi) continue;
+            int hops;
+            if (!walk(child, (uint8_t)x, f[x], hops)) { ok = false; return 0; }
+            seen[f[x]] = true;
+            if (hops > depth) depth = hops;
+            int &ba = bucket_act[mask_bucket(out.mask_bits, (uint8_t)x)];
+            if (ba >= 0 && ba != f[x]) pure = false;
+            ba = f[x];
+        }
+        std::vector<int> acts;
+        for (int a = 0; a < 4; a++)
+            if (seen[a]) acts.push_back(a);
+        if (acts.size() == 1) return leaf(acts[0]);
+
+        int mask_levels = acts.size() == 2 ? 1 : 2;
+        if (pure && mask_levels < depth && (int)(out.masks.size() + acts.size() - 1) <= max_masks)
+            return build_masks(acts, f);
+
+        // Keep the split; skip it if the range has already decided it
+        const Node &n = bin[child];
+        int llo, lhi, rlo, rhi;
+        if (n.less_than) { llo = lo; lhi = std::min(hi, n.threshold - 1); rlo = std::max(lo, (int)n.threshold); rhi = hi; }
+        else             { llo = std::max(lo, n.threshold + 1); lhi = hi; rlo = lo; rhi = std::min(hi, (int)n.threshold); }
+        if (llo > lhi) return convert(n.right_idx, rlo, rhi);
+        if (rlo > rhi) return convert(n.left_idx, llo, lhi);
+
+        int id = (int)out.nodes.size();
+        out.nodes.push_back({0, 0, n.threshold, n.less_than, 0, 0, 0});
+        int l = convert(n.left_idx, llo, lhi);
+        int r = convert(n.right_idx, rlo, rhi);
+        out.nodes[id].left_idx  = (uint8_t)l;
+        out.nodes[id].right_idx = (uint8_t)r;
+        return id;
+    }
+};
+
+// mask_bits 256 or 32; max_masks is the engine's MASK_ENTRIES
+static inline bool convert_to_mask(const std::vector<Node> &tree, int mask_bits, int max_masks,
+                                   MaskTree &out) {
+    if (tree.empty() || tree_depth(tree) < 0) return false;
+    MaskConverter c(tree, mask_bits, max_masks);
+    c.convert(0, 0, 255);
+    out = c.out;
+    return c.ok && out.nodes.size() <= 64;
+}
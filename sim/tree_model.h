@@ -0,0 +1,419 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include <string>
+#include <array>
+#include <map>
+
+// =========================================================================
+// Shared tree model — node format, golden model and model-file I/O.
+//
+// Used by the Verilator harnesses in sim/ and the host tools in tools/.
+// Node mirrors node_t in rtl/decision_tree*.sv field for field.
+// =========================================================================
+
+struct Node {
+    uint8_t is_leaf;
+    uint8_t threshold;
+    uint8_t less_than;
+    uint8_t left_idx;
+    uint8_t right_idx;
+    uint8_t action;
+};
+
+// Inline-leaf child pointers (engines built with INLINE_LEAVES=1):
+// a child value with INLINE_LEAF set is not a node index but a leaf, with
+// the action in bits [1:0].  The parent resolves immediately — no leaf node
+// is stored or fetched.  In the engines the flag is bit ADDR_WIDTH of the
+// (ADDR_WIDTH+1)-bit pointer; engine_child() does the translation.
+// Node indices must therefore stay below 0x80.
+static const uint8_t INLINE_LEAF = 0x80;
+
+static inline bool is_inline_leaf(uint8_t child) { return child & INLINE_LEAF; }
+static inline uint8_t inline_leaf(int action)    { return INLINE_LEAF | (action & 3); }
+
+static inline uint32_t engine_child(uint8_t child, int addr_width) {
+    if (is_inline_leaf(child)) return (1u << addr_width) | (child & 3);
+    return child;
+}
+
+static inline const char *action_name(int a) {
+    switch (a) {
+        case 0: return "NONE  ";
+        case 1: return "BUY   ";
+        case 2: return "SELL  ";
+        case 3: return "CANCEL";
+        default: return "???   ";
+    }
+}
+
+// =========================================================================
+// Software golden model — walks the tree in pure C++, no Verilog involved.
+// This is the reference: if HW disagrees with this, HW has a bug.
+// If this disagrees with our hand-traced expectations, WE had a bug.
+// =========================================================================
+struct SimResult {
+    int action;    // leaf action (0-3)
+    int depth;     // number of edges from root to leaf
+    bool valid;    // false if tree is malformed (loop, missing leaf, etc.)
+    bool inline_leaf;  // leaf was an inline child pointer (no node fetched)
+    int slot;      // payload template index: leaf threshold, or action for inline leaves
+};
+
+static inline SimResult simulate_tree(const std::vector<Node> &tree, uint8_t input) {
+    SimResult r = {0, 0, false, false, 0};
+    int idx = 0;  // start at root
+
+    for (int step = 0; step < 64; step++) {  // cap at 64 to detect infinite loops
+        if (idx < 0 || idx >= (int)tree.size()) return r;  // out of bounds
+        const Node &n = tree[idx];
+        if (n.is_leaf) {
+            r.action = n.action;
+            r.depth  = step;
+            r.valid  = true;
+            r.slot   = n.threshold;
+            return r;
+        }
+        bool cond = n.less_than ? (input < n.threshold) : (input > n.threshold);
+        uint8_t child = cond ? n.left_idx : n.right_idx;
+        if (is_inline_leaf(child)) {
+            r.action      = child & 3;
+            r.depth       = step + 1;
+            r.valid       = true;
+            r.inline_leaf = true;
+            r.slot        = child & 3;
+            return r;
+        }
+        idx = child;
+    }
+
+    return r;  // valid=false — probable cycle in tree
+}
+
+// Deepest leaf reachable from the root over all 256 inputs (-1 if malformed).
+static inline int tree_depth(const std::vector<Node> &tree) {
+    int depth = 0;
+    for (int inp = 0; inp < 256; inp++) {
+        SimResult r = simulate_tree(tree, (uint8_t)inp);
+        if (!r.valid) return -1;
+        if (r.depth > depth) depth = r.depth;
+    }
+    return depth;
+}
+
+// Pipeline stages needed (MAX_DEPTH): a node leaf at depth d is read by
+// stage d+1, an inline leaf at depth d is resolved by its parent at stage d.
+static inline int tree_stages(const std::vector<Node> &tree) {
+    int stages = 0;
+    for (int inp = 0; inp < 256; inp++) {
+        SimResult r = simulate_tree(tree, (uint8_t)inp);
+        if (!r.valid) return -1;
+        int need = r.inline_leaf ? r.depth : r.depth + 1;
+        if (need > stages) stages = need;
+    }
+    return stages;
+}
+
+static inline bool has_inline_leaves(const std::vector<Node> &tree) {
+    for (const Node &n : tree)
+        if (!n.is_leaf && (is_inline_leaf(n.left_idx) || is_inline_leaf(n.right_idx)))
+            return true;
+    return false;
+}
+
+// =========================================================================
+// Inline-leaf conversion (loader side)
+// =========================================================================
+// Replaces every child pointer to a leaf node with an inline leaf pointer,
+// then drops the leaf nodes nothing points to any more and renumbers the
+// rest in their original order (root stays at 0).  A full tree keeps only
+// its internal nodes — 63 → 31 for depth 5 — and every path loses one hop.
+// A root that is itself a leaf is kept as a node.
+static inline std::vector<Node> inline_leaves(const std::vector<Node> &tree) {
+    std::vector<Node> t = tree;
+    for (Node &n : t) {
+        if (n.is_leaf) continue;
+        uint8_t *child[2] = {&n.left_idx, &n.right_idx};
+        for (uint8_t *c : child) {
+            if (!is_inline_leaf(*c) && *c < t.size() && tree[*c].is_leaf)
+                *c = inline_leaf(tree[*c].action);
+        }
+    }
+
+    std::vector<int> keep(t.size(), 0);
+    keep[0] = 1;
+    for (const Node &n : t) {
+        if (n.is_leaf) continue;
+        if (!is_inline_leaf(n.left_idx)  && n.left_idx  < t.size()) keep[n.left_idx]  = 1;
+        if (!is_inline_leaf(n.right_idx) && n.right_idx < t.size()) keep[n.right_idx] = 1;
+    }
+
+    std::vector<int> remap(t.size(), -1);
+    std::vector<Node> out;
+    for (int i = 0; i < (int)t.size(); i++) {
+        if (keep[i]) {
+            remap[i] = (int)out.size();
+            out.push_back(t[i]);
+        }
+    }
+    for (Node &n : out) {
+        if (n.is_leaf) continue;
+        if (!is_inline_leaf(n.left_idx)  && n.left_idx  < t.size()) n.left_idx  = (uint8_t)remap[n.left_idx];
+        if (!is_inline_leaf(n.right_idx) && n.right_idx < t.size()) n.right_idx = (uint8_t)remap[n.right_idx];
+    }
+    return out;
+}
+
+// =========================================================================
+// Subtree sharing (model compiler side)
+// =========================================================================
+// Hash-conses identical subtrees into one node each.  Two leaves are the
+// same if action and payload slot (threshold) agree — or action alone with
+// keep_slots = false, for engines without payload RAM; the shared leaf then
+// takes slot = action.  Two splits are the same if threshold, less_than and
+// both (already shared) children agree.  A split whose children are the
+// same node decides nothing and is replaced by that child.  The engines
+// follow child pointers wherever they point, so they walk the resulting
+// DAG like a tree: every input gets the same action (and slot, and inline
+// flag) and no path gets longer.  Inline leaf pointers are kept.  Nodes are
+// renumbered breadth-first (root stays at 0); unreachable ones are dropped.
+// Returns an empty vector on a cycle or an out-of-range child.
+struct TreeDedup {
+    const std::vector<Node> &in;
+    bool                     keep_slots;
+    std::vector<Node>        uniq;     // children are uniq ids or inline pointers
+    std::vector<int>         canon;    // in index → uniq id / inline pointer, -1 unseen, -2 visiting
+    std::map<std::array<int, 6>, int> seen;
+
+    TreeDedup(const std::vector<Node> &t, bool k) : in(t), keep_slots(k), canon(t.size(), -1) {}
+
+    int intern(const Node &n) {
+        std::array<int, 6> key = {n.is_leaf, n.threshold, n.less_than, n.left_idx, n.right_idx, n.action};
+        auto it = seen.find(key);
+        if (it != seen.end()) return it->second;
+        uniq.push_back(n);
+        return seen[key] = (int)uniq.size() - 1;
+    }
+
+    // Shared id of child c; -1 on a cycle or a bad index
+    int visit(uint8_t c) {
+        if (is_inline_leaf(c)) return c;
+        if (c >= in.size() || canon[c] == -2) return -1;
+        if (canon[c] >= 0) return canon[c];
+        canon[c] = -2;
+        const Node &n = in[c];
+        int id;
+        if (n.is_leaf) {
+            uint8_t slot = keep_slots ? n.threshold : n.action;
+            id = intern({1, slot, 0, 0, 0, n.action});
+        } else {
+            int l = visit(n.left_idx), r = visit(n.right_idx);
+            if (l < 0 || r < 0) return -1;
+            id = l == r ? l : intern({0, n.threshold, n.less_than, (uint8_t)l, (uint8_t)r, 0});
+        }
+        return canon[c] = id;
+    }
+};
+
+static inline std::vector<Node> dedup_tree(const std::vector<Node> &tree, bool keep_slots = true) {
+    if (tree.empty()) return {};
+    TreeDedup d(tree, keep_slots);
+    int root = d.visit(0);
+    if (root < 0 || d.uniq.size() > INLINE_LEAF) return {};
+    if (is_inline_leaf((uint8_t)root))         // every input ends on one inline leaf
+        root = d.intern({1, (uint8_t)(root & 3), 0, 0, 0, (uint8_t)(root & 3)});
+
+    // Breadth-first from the root
+    std::vector<int> order(1, root), index(d.uniq.size(), -1);
+    index[root] = 0;
+    for (size_t i = 0; i < order.size(); i++) {
+        const Node &n = d.uniq[order[i]];
+        if (n.is_leaf) continue;
+        for (uint8_t c : {n.left_idx, n.right_idx}) {
+            if (is_inline_leaf(c) || index[c] >= 0) continue;
+            index[c] = (int)order.size();
+            order.push_back(c);
+        }
+    }
+    std::vector<Node> out;
+    for (int id : order) {
+        Node n = d.uniq[id];
+        if (!n.is_leaf) {
+            if (!is_inline_leaf(n.left_idx))  n.left_idx  = (uint8_t)index[n.left_idx];
+            if (!is_inline_leaf(n.right_idx)) n.right_idx = (uint8_t)index[n.right_idx];
+        }
+        out.push_back(n);
+    }
+    return out;
+}
+
+// =========================================================================
+// Model file I/O
+// =========================================================================
+// Text format, one node per line in index order (line order = node index):
+//
+//   # is_leaf threshold less_than left_idx right_idx action
+//   0 128 1 1 2 0
+//   1   0 0 0 0 2
+//
+// Blank lines and '#' comments are ignored.  This is the same column order
+// as the C++ initialiser tables in the harnesses.  An inline leaf child is
+// written as 128 + action (INLINE_LEAF).
+
+static inline bool read_tree_file(const char *path, std::vector<Node> &tree) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "error: cannot open %s\n", path);
+        return false;
+    }
+
+    tree.clear();
+    char line[256];
+    int lineno = 0;
+    while (fgets(line, sizeof(line), f)) {
+        lineno++;
+        char *p = line;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '#' || *p == '\n' || *p == '\r' || *p == '\0') continue;
+
+        unsigned v[6];
+        if (sscanf(p, "%u %u %u %u %u %u", &v[0], &v[1], &v[2], &v[3], &v[4], &v[5]) != 6
+            || v[0] > 1 || v[1] > 255 || v[2] > 1 || v[3] > 255 || v[4] > 255 || v[5] > 3) {
+            fprintf(stderr, "error: %s:%d: malformed node line\n", path, lineno);
+            fclose(f);
+            return false;
+        }
+        tree.push_back({(uint8_t)v[0], (uint8_t)v[1], (uint8_t)v[2],
+                        (uint8_t)v[3], (uint8_t)v[4], (uint8_t)v[5]});
+    }
+
+    fclose(f);
+    return true;
+}
+
+static inline bool write_tree_file(const char *path, const std::vector<Node> &tree) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "error: cannot create %s\n", path);
+        return false;
+    }
+
+    fprintf(f, "# is_leaf threshold less_than left_idx right_idx action\n");
+    for (int i = 0; i < (int)tree.size(); i++) {
+        const Node &n = tree[i];
+        fprintf(f, "%u %3u %u %2u %2u %u   # %2d\n",
+                n.is_leaf, n.threshold, n.less_than,
+                n.left_idx, n.right_idx, n.action, i);
+    }
+
+    fclose(f);
+    return true;
+}
+
+// Replay traces: one market_input (0-255) per line, same comment rules.
+static inline bool read_trace_file(const char *path, std::vector<uint8_t> &trace) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "error: cannot open %s\n", path);
+        return false;
+    }
+
+    trace.clear();
+    char line[256];
+    int lineno = 0;
+    while (fgets(line, sizeof(line), f)) {
+        lineno++;
+        char *p = line;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '#' || *p == '\n' || *p == '\r' || *p == '\0') continue;
+
+        unsigned v;
+        if (sscanf(p, "%u", &v) != 1 || v > 255) {
+            fprintf(stderr, "error: %s:%d: malformed trace line\n", path, lineno);
+            fclose(f);
+            return false;
+        }
+        trace.push_back((uint8_t)v);
+    }
+
+    fclose(f);
+    return !trace.empty();
+}
+
+// =========================================================================
+// Leaf payload — order templates (decision_tree_pipelined payload RAM)
+// =========================================================================
+// A leaf node's threshold is unused by the walk; its low bits select one of
+// PAYLOAD_ENTRIES templates, emitted with action_valid.  Inline leaves
+// select template <action>.  Template layout (PAYLOAD_WIDTH = 32):
+//
+//   [31:30] side          0 = none, 1 = buy, 2 = sell, 3 = cancel
+//   [29:16] qty           shares / contracts, 0..16383
+//   [15:0]  price_offset  signed ticks relative to the reference price
+
+struct OrderTemplate {
+    uint8_t  side;
+    uint16_t qty;
+    int16_t  price_offset;
+};
+
+static inline uint32_t pack_template(const OrderTemplate &t) {
+    return ((uint32_t)(t.side & 3) << 30) | ((uint32_t)(t.qty & 0x3fff) << 16)
+         | (uint16_t)t.price_offset;
+}
+
+static inline OrderTemplate unpack_template(uint32_t w) {
+    return {(uint8_t)(w >> 30), (uint16_t)((w >> 16) & 0x3fff), (int16_t)(w & 0xffff)};
+}
+
+// =========================================================================
+// Memory-image packing (for $readmemh via TREE_INIT_FILE)
+// =========================================================================
+// Packs a node exactly like the node_t struct:
+//   {is_leaf, threshold[7:0], less_than, left_idx, right_idx, action[1:0]}
+// addr_width is the engine's ADDR_WIDTH ($clog2(MAX_NODES)); with
+// inline_leaves the child fields are CHILD_WIDTH = ADDR_WIDTH + 1 bits.
+
+static inline int node_bits(int addr_width, bool inline_leaves = false) {
+    int child_width = addr_width + (inline_leaves ? 1 : 0);
+    return 1 + 8 + 1 + child_width + child_width + 2;
+}
+
+static inline uint64_t pack_node(const Node &n, int addr_width, bool inline_leaves = false) {
+    int child_width = addr_width + (inline_leaves ? 1 : 0);
+    uint64_t mask = (1ull << child_width) - 1;
+    uint64_t w = n.is_leaf & 1;
+    w = (w << 8)           | n.threshold;
+    w = (w << 1)           | (n.less_than & 1);
+    w = (w << child_width) | (engine_child(n.left_idx, addr_width) & mask);
+    w = (w << child_width) | (engine_child(n.right_idx, addr_width) & mask);
+    w = (w << 2)           | (n.action & 3);
+    return w;
+}
+
+// Writes one hex word per line, padded with zero words up to max_nodes so
+// the image covers the whole of tree_mem.
+static inline bool write_mem_file(const char *path, const std::vector<Node> &tree,
+                                  int max_nodes, int addr_width,
+                                  bool inline_leaves = false) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "error: cannot create %s\n", path);
+        return false;
+    }
+
+    int bits   = node_bits(addr_width, inline_leaves);
+    int digits = (bits + 3) / 4;
+    fprintf(f, "// decision tree image: %d nodes, %d bits/node%s\n",
+            (int)tree.size(), bits, inline_leaves ? " (INLINE_LEAVES=1)" : "");
+    for (int i = 0; i < max_nodes; i++) {
+        uint64_t w = i < (int)tree.size() ? pack_node(tree[i], addr_width, inline_leaves) : 0;
+        fprintf(f, "%0*llx\n", digits, (unsigned long long)w);
+    }
+
+    fclose(f);
+    return true;
+}
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "tree_model.h"
+
+// =========================================================================
+// 4-ary (quad) node format — converter from binary trees + golden model
+// =========================================================================
+//
+// A quad node holds three sorted thresholds and four children.  The child
+// taken is the number of thresholds the input has reached:
+//
+//   bucket = (x >= t0) + (x >= t1) + (x >= t2)      → child[bucket]
+//
+// so  x < t0 → 0,  t0 <= x < t1 → 1,  t1 <= x < t2 → 2,  x >= t2 → 3.
+// Mirrors quad_node_t in rtl/decision_tree_quad.sv.
+
+struct QuadNode {
+    uint8_t is_leaf;
+    uint8_t threshold[3];
+    uint8_t child[4];
+    uint8_t action;
+};
+
+static inline SimResult simulate_quad(const std::vector<QuadNode> &tree, uint8_t input) {
+    SimResult r = {0, 0, false, false, 0};
+    int idx = 0;
+
+    for (int step = 0; step < 64; step++) {
+        if (idx < 0 || idx >= (int)tree.size()) return r;
+        const QuadNode &n = tree[idx];
+        if (n.is_leaf) {
+            r.action = n.action;
+            r.depth  = step;
+            r.valid  = true;
+            return r;
+        }
+        int bucket = (input >= n.threshold[0]) + (input >= n.threshold[1])
+                   + (input >= n.threshold[2]);
+        idx = n.child[bucket];
+    }
+
+    return r;
+}
+
+// -------------------------------------------------------------------------
+// Binary → quad conversion
+// -------------------------------------------------------------------------
+// Every binary split is first normalised to "x < u ? A : B" (u in 0..256):
+//   less_than=1:  u = t,     A = left,  B = right
+//   less_than=0:  u = t + 1, A = right, B = left     (x > t  ⇔  x >= t+1)
+// A node plus its two children then becomes one quad node with
+//   t0 = u_A, t1 = u, t2 = u_B   and children  AA, AB, BA, BB.
+// The converter tracks the input range [lo, hi) reaching each node, so a
+// split that is already decided by an ancestor (u <= lo or u >= hi) is
+// skipped rather than spending a level on it.  A leaf child fills both of
+// its buckets and its threshold collapses onto u (empty bucket).  Inline
+// leaf pointers in the binary tree become (shared) quad leaf nodes.
+
+struct QuadConverter {
+    const std::vector<Node> &bin;
+    std::vector<QuadNode>    quad;
+    int                      leaf_idx[4] = {-1, -1, -1, -1};  // one shared leaf per action
+    bool                     ok = true;
+
+    explicit QuadConverter(const std::vector<Node> &b) : bin(b) {}
+
+    static void normalise(const Node &n, int &u, int &a, int &b) {
+        if (n.less_than) { u = n.threshold;     a = n.left_idx;  b = n.right_idx; }
+        else             { u = n.threshold + 1; a = n.right_idx; b = n.left_idx;  }
+    }
+
+    // Follow splits that are constant over [lo, hi) until a leaf or a live split.
+    int skip_decided(int idx, int lo, int hi, int guard = 0) {
+        if (is_inline_leaf((uint8_t)idx)) return idx;
+        if (guard > 64 || idx >= (int)bin.size()) { ok = false; return 0; }
+        const Node &n = bin[idx];
+        if (n.is_leaf) return idx;
+        int u, a, b;
+        normalise(n, u, a, b);
+        if (u >= hi) return skip_decided(a, lo, hi, guard + 1);
+        if (u <= lo) return skip_decided(b, lo, hi, guard + 1);
+        return idx;
+    }
+
+    int leaf(int action) {
+        if (leaf_idx[action] < 0) {
+            leaf_idx[action] = (int)quad.size();
+            quad.push_back({1, {0, 0, 0}, {0, 0, 0, 0}, (uint8_t)action});
+        }
+        return leaf_idx[action];
+    }
+
+    int convert(int idx, int lo, int hi) {
+        idx = skip_decided(idx, lo, hi);
+        if (!ok) return 0;
+        if (is_inline_leaf((uint8_t)idx)) return leaf(idx & 3);
+        const Node &n = bin[idx];
+        if (n.is_leaf) return leaf(n.action);
+
+        int u, a, b;
+        normalise(n, u, a, b);
+
+        int self = (int)quad.size();
+        quad.push_back({0, {0, 0, 0}, {0, 0, 0, 0}, 0});
+
+        // Left half [lo, u): split again on A's threshold if A is live there.
+        int t0 = u, c0, c1;
+        a = skip_decided(a, lo, u);
+        if (!ok) return 0;
+        if (is_inline_leaf((uint8_t)a) || bin[a].is_leaf) {
+            c0 = c1 = convert(a, lo, u);
+        } else {
+            int ua, aa, ab;
+            normalise(bin[a], ua, aa, ab);
+            t0 = ua;
+            c0 = convert(aa, lo, ua);
+            c1 = convert(ab, ua, u);
+        }
+
+        // Right half [u, hi): same on B.
+        int t2 = u, c2, c3;
+        b = skip_decided(b, u, hi);
+        if (!ok) return 0;
+        if (is_inline_leaf((uint8_t)b) || bin[b].is_leaf) {
+            c2 = c3 = convert(b, u, hi);
+        } else {
+            int ub, ba, bb;
+            normalise(bin[b], ub, ba, bb);
+            t2 = ub;
+            c2 = convert(ba, u, ub);
+            c3 = convert(bb, ub, hi);
+        }
+
+        QuadNode &q = quad[self];
+        q.threshold[0] = (uint8_t)t0;
+        q.threshold[1] = (uint8_t)u;
+        q.threshold[2] = (uint8_t)t2;
+        q.child[0] = (uint8_t)c0;
+        q.child[1] = (uint8_t)c1;
+        q.child[2] = (uint8_t)c2;
+        q.child[3] = (uint8_t)c3;
+        return self;
+    }
+};
+
+// Converts a binary tree to quad nodes (root at index 0).  Returns false if
+// the binary tree is malformed.
+static inline bool convert_to_quad(const std::vector<Node> &bin, std::vector<QuadNode> &quad) {
+    QuadConverter cv(bin);
+    cv.convert(0, 0, 256);
+    if (!cv.ok) return false;
+    quad = cv.quad;
+    return true;
+}
+
+static inline int quad_depth(const std::vector<QuadNode> &tree) {
+    int depth = 0;
+    for (int inp = 0; inp < 256; inp++) {
+        SimResult r = simulate_quad(tree, (uint8_t)inp);
+        if (!r.valid) return -1;
+        if (r.depth > depth) depth = r.depth;
+    }
+    return depth;
+}
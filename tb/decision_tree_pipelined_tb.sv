@@ -22,6 +22,11 @@ module decision_tree_pipelined_tb;
   logic [ADDR_WIDTH-1:0] sw_data_right_idx;
   logic [1:0] sw_data_action;
 
+  logic [31:0] payload;
+  logic sw_payload_we;
+  logic [5:0] sw_payload_addr;
+  logic [31:0] sw_payload_data;
+
   // Clock: 10ns period
   initial clk = 0;
   always #5 clk = ~clk;
@@ -44,7 +49,11 @@ module decision_tree_pipelined_tb;
     .sw_data_less_than(sw_data_less_than),
     .sw_data_left_idx(sw_data_left_idx),
     .sw_data_right_idx(sw_data_right_idx),
-    .sw_data_action(sw_data_action)
+    .sw_data_action(sw_data_action),
+    .payload(payload),
+    .sw_payload_we(sw_payload_we),
+    .sw_payload_addr(sw_payload_addr),
+    .sw_payload_data(sw_payload_data)
   );
 
   // Task: write a node into tree memory
@@ -72,6 +81,21 @@ module decision_tree_pipelined_tb;
   end
   endtask
 
+  // Task: write an order template into the payload RAM
+  // {side[1:0], qty[13:0], price_offset[15:0]}
+  task write_payload(
+    input [5:0] slot,
+    input [31:0] data
+  );
+  begin
+    sw_payload_addr = slot;
+    sw_payload_data = data;
+    sw_payload_we   = 1;
+    @(posedge clk);
+    sw_payload_we = 0;
+  end
+  endtask
+
   // Task: send an input and wait for action_valid
   task run_input(
     input [7:0] inp,
@@ -87,7 +111,7 @@ module decision_tree_pipelined_tb;
     repeat (MAX_DEPTH + 4) begin
       @(posedge clk);
       if (action_valid) begin
-        $display("[%s] input=%0d  action=%0d", label, inp, action);
+        $display("[%s] input=%0d  action=%0d  payload=%08h", label, inp, action, payload);
         return;
       end
     end
@@ -103,6 +127,7 @@ module decision_tree_pipelined_tb;
     rst   = 1;
     start = 0;
     sw_we = 0;
+    sw_payload_we = 0;
     @(posedge clk); @(posedge clk);
     rst = 0;
 
@@ -119,13 +144,19 @@ module decision_tree_pipelined_tb;
     // [Node 3] [Node 4] [Node 5] [Node 6]
     //   BUY      SELL    CANCEL    NONE
     //
+    // Leaf threshold = payload slot (order template 3..6).
     write_node(0, 0, 8'd10, 1, 6'd1, 6'd2, 2'b00);  // root: < 10 ? L=1 R=2
     write_node(1, 0, 8'd20, 1, 6'd3, 6'd4, 2'b00);  // node1: < 20 ? L=3 R=4
     write_node(2, 0, 8'd5,  0, 6'd5, 6'd6, 2'b00);  // node2: > 5 ?  L=5 R=6
-    write_node(3, 1, 8'd0,  0, 6'd0, 6'd0, 2'b01);  // leaf BUY
-    write_node(4, 1, 8'd0,  0, 6'd0, 6'd0, 2'b10);  // leaf SELL
-    write_node(5, 1, 8'd0,  0, 6'd0, 6'd0, 2'b11);  // leaf CANCEL
-    write_node(6, 1, 8'd0,  0, 6'd0, 6'd0, 2'b00);  // leaf NONE
+    write_node(3, 1, 8'd3,  0, 6'd0, 6'd0, 2'b01);  // leaf BUY    → template 3
+    write_node(4, 1, 8'd4,  0, 6'd0, 6'd0, 2'b10);  // leaf SELL   → template 4
+    write_node(5, 1, 8'd5,  0, 6'd0, 6'd0, 2'b11);  // leaf CANCEL → template 5
+    write_node(6, 1, 8'd6,  0, 6'd0, 6'd0, 2'b00);  // leaf NONE   → template 6
+
+    write_payload(3, {2'd1, 14'd100, 16'hFFFF});    // buy  100 @ -1 tick
+    write_payload(4, {2'd2, 14'd100, 16'h0001});    // sell 100 @ +1 tick
+    write_payload(5, {2'd3, 14'd0,   16'h0000});    // cancel
+    write_payload(6, {2'd0, 14'd0,   16'h0000});    // none
 
     // ---- Test cases ----
 
@@ -152,7 +183,7 @@ module decision_tree_pipelined_tb;
     repeat (MAX_DEPTH + 6) begin
       @(posedge clk);
       if (action_valid)
-        $display("[PIPE] action=%0d at time %0t", action, $time);
+        $display("[PIPE] action=%0d payload=%08h at time %0t", action, payload, $time);
     end
 
     $display("--- Done ---");
@@ -13,6 +13,8 @@ module decision_tree_tb;
   logic start;
   logic [1:0] action;
   logic action_valid;
+  logic action_error;
+  logic [15:0] error_count;
 
   logic sw_we;
   logic [ADDR_WIDTH-1:0] sw_addr;
@@ -35,6 +37,8 @@ module decision_tree_tb;
     .start(start),
     .action(action),
     .action_valid(action_valid),
+    .action_error(action_error),
+    .error_count(error_count),
     .sw_we(sw_we),
     .sw_addr(sw_addr),
     .sw_data_is_leaf(sw_data_is_leaf),
@@ -45,6 +49,11 @@ module decision_tree_tb;
     .sw_data_action(sw_data_action)
   );
 
+  // The tree below is legal, so the hop watchdog must never fire
+  always @(posedge clk)
+    if (!rst && action_valid && action_error)
+      $error("action_error on a legal tree (input %0d)", market_input);
+
   // Task to write node
   task write_node(
     input [ADDR_WIDTH-1:0] addr,
@@ -107,6 +116,8 @@ module decision_tree_tb;
       $display("Action: %0d", action);
     else
       $display("No action received");
+    if (error_count != 0)
+      $error("error_count = %0d, expected 0", error_count);
 
     $finish;
   end
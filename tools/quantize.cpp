@@ -0,0 +1,467 @@
+// =========================================================================
+// quantize — float features → 8-bit engine inputs, float trees → node arrays
+// =========================================================================
+//
+// Usage:
+//   quantize fit [--uniform] [--label K] <samples.csv> <out.qmap>
+//   quantize apply [--label K] <map.qmap> <in.csv> <out.csv>
+//   quantize model [--feature K] [--label K] <map.qmap> <model.ftree>
+//                  <samples.csv> <out.tree>
+//
+// fit    learns one quantiser per feature column: 256 quantile bins (the
+//        default, equal sample mass per bin) or --uniform bins over the
+//        observed [min, max].  A quantiser is 255 ascending edges, and
+//        q(x) = number of edges <= x, so q is monotonic and 0..255.
+// apply  converts a float sample file to 8-bit features (labels are copied
+//        through), e.g. as input for train_tree.
+// model  maps a float tree's thresholds onto the engine's 8-bit compares
+//        and checks the result against the float tree on the samples.
+//
+// CSV: one sample per line, comma separated, label in the last column
+// unless --label says otherwise; a first line that does not parse is a
+// header (and is copied by apply).  Map file, one feature per line:
+//
+//   # column method [lo scale] edge[0] .. edge[254]
+//
+// Float trees (.ftree) use the models/*.tree columns with a float
+// threshold; leaf thresholds are still payload slots:
+//
+//   # is_leaf threshold less_than left_idx right_idx action
+//   0 0.0125 1 1 2 0
+//
+// Threshold mapping: with q monotonic, q(x) < T holds exactly when
+// x < edge[T-1], and q(x) > T exactly when x >= edge[T].  Each float
+// compare therefore becomes the T whose edge is nearest its threshold,
+// and is exact when the threshold sits on an edge.  The engines take one
+// input, so a model uses one feature column (--feature, default 0).  The
+// mapped tree is walked with simulate_tree() on every quantised sample and
+// the disagreement rate against the float walk is reported; a mapped
+// threshold only changes decisions for samples that fall between the
+// float threshold and its edge.
+//
+// Quantisation is done a column at a time over the whole batch rather
+// than sample by sample: quantize_batch() is straight-line loops (uniform:
+// scale and clamp; quantile: an eight-step branchless search of the edges,
+// one step at a time across a block of samples) that GCC vectorises at -O3.
+// The Makefile builds this tool with -O3; add -march=native for AVX2
+// gathers in the quantile search.
+// =========================================================================
+
+#include "../sim/tree_model.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+struct Quantizer {
+    int   column;
+    bool  uniform;
+    float lo, scale;           // uniform: q = clamp(floor((x - lo) * scale))
+    float edge[255];           // ascending; q(x) = #{i : edge[i] <= x}
+};
+
+static void quantize_batch(const Quantizer &qz, const float *__restrict x, size_t n,
+                           uint8_t *__restrict out) {
+    if (qz.uniform) {
+        float lo = qz.lo, scale = qz.scale;
+        for (size_t i = 0; i < n; i++) {
+            float v = (x[i] - lo) * scale;
+            v = v > 0.0f ? v : 0.0f;               // also NaN → 0
+            v = v < 255.0f ? v : 255.0f;
+            out[i] = (uint8_t)(int)v;
+        }
+        return;
+    }
+    // Search step by step across a block of samples, so each step is one
+    // gather + compare over the block
+    const float *e = qz.edge;
+    int32_t k[256];
+    for (size_t base = 0; base < n; base += 256) {
+        int m = (int)std::min<size_t>(256, n - base);
+        const float *xb = x + base;
+        for (int i = 0; i < m; i++) k[i] = 0;
+        for (int step = 128; step; step >>= 1)
+            for (int i = 0; i < m; i++)
+                k[i] += xb[i] >= e[k[i] + step - 1] ? step : 0;
+        for (int i = 0; i < m; i++) out[base + i] = (uint8_t)k[i];
+    }
+}
+
+// =========================================================================
+// Sample files
+// =========================================================================
+struct Samples {
+    std::string header;                    // empty if none
+    std::vector<std::vector<float>> col;   // feature columns
+    std::vector<std::string> label;
+};
+
+static bool split_csv(const char *line, std::vector<std::string> &f) {
+    f.clear();
+    std::string cur;
+    for (const char *p = line; ; p++) {
+        if (*p == ',' || *p == '\n' || *p == '\r' || *p == '\0') {
+            f.push_back(cur);
+            cur.clear();
+            if (*p != ',') break;
+        } else if (*p != ' ' && *p != '\t') {
+            cur += *p;
+        }
+    }
+    return !(f.size() == 1 && f[0].empty());
+}
+
+static bool read_samples(const char *path, int label_col, Samples &s) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "error: cannot open %s\n", path);
+        return false;
+    }
+
+    std::vector<std::string> fld;
+    char line[4096];
+    int lineno = 0;
+    size_t width = 0;
+    while (fgets(line, sizeof(line), f)) {
+        lineno++;
+        if (line[0] == '#' || !split_csv(line, fld)) continue;
+
+        int lc = label_col < 0 ? (int)fld.size() - 1 : label_col;
+        bool ok = lc < (int)fld.size() && fld.size() >= 2 && (!width || fld.size() == width);
+        std::vector<float> v;
+        for (int k = 0; ok && k < (int)fld.size(); k++) {
+            if (k == lc) continue;
+            char *end;
+            v.push_back(strtof(fld[k].c_str(), &end));
+            ok = !fld[k].empty() && *end == '\0';
+        }
+        if (!ok) {
+            if (lineno == 1) {
+                s.header = line;
+                continue;
+            }
+            fprintf(stderr, "error: %s:%d: malformed sample\n", path, lineno);
+            fclose(f);
+            return false;
+        }
+        if (!width) {
+            width = fld.size();
+            s.col.assign(v.size(), std::vector<float>());
+        }
+        for (size_t k = 0; k < v.size(); k++) s.col[k].push_back(v[k]);
+        s.label.push_back(fld[lc]);
+    }
+
+    fclose(f);
+    if (s.label.empty()) {
+        fprintf(stderr, "error: %s holds no samples\n", path);
+        return false;
+    }
+    return true;
+}
+
+// =========================================================================
+// Map files
+// =========================================================================
+static Quantizer fit_column(int column, const std::vector<float> &x, bool uniform) {
+    Quantizer qz = {column, uniform, 0.0f, 0.0f, {}};
+    std::vector<float> v(x);
+    std::sort(v.begin(), v.end());
+    size_t n = v.size();
+
+    if (uniform) {
+        float lo = v[0], hi = v[n - 1];
+        qz.lo    = lo;
+        qz.scale = hi > lo ? 256.0f / (hi - lo) : 0.0f;
+        for (int i = 0; i < 255; i++)
+            qz.edge[i] = hi > lo ? lo + (i + 1) / qz.scale : INFINITY;
+    } else {
+        // Edge i starts bin i + 1: the (i + 1) / 256 quantile
+        for (int i = 0; i < 255; i++) {
+            size_t k = (size_t)(i + 1) * n / 256;
+            qz.edge[i] = v[std::min(k, n - 1)];
+        }
+    }
+    return qz;
+}
+
+static bool write_map(const char *path, const std::vector<Quantizer> &map) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "error: cannot create %s\n", path);
+        return false;
+    }
+    fprintf(f, "# column method [lo scale] edge[0] .. edge[254]\n");
+    for (const Quantizer &qz : map) {
+        fprintf(f, "%d %s", qz.column, qz.uniform ? "uniform" : "quantile");
+        if (qz.uniform)
+            fprintf(f, " %.9g %.9g", qz.lo, qz.scale);
+        for (int i = 0; i < 255; i++) fprintf(f, " %.9g", qz.edge[i]);
+        fprintf(f, "\n");
+    }
+    fclose(f);
+    return true;
+}
+
+static bool read_map(const char *path, std::vector<Quantizer> &map) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "error: cannot open %s\n", path);
+        return false;
+    }
+
+    map.clear();
+    std::vector<char> line(16384);
+    int lineno = 0;
+    while (fgets(line.data(), (int)line.size(), f)) {
+        lineno++;
+        char *p = line.data();
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '#' || *p == '\n' || *p == '\r' || *p == '\0') continue;
+
+        Quantizer qz = {0, false, 0.0f, 0.0f, {}};
+        char method[16];
+        int used;
+        bool ok = sscanf(p, "%d %15s%n", &qz.column, method, &used) == 2;
+        qz.uniform = ok && !strcmp(method, "uniform");
+        ok = ok && (qz.uniform || !strcmp(method, "quantile"));
+        p += ok ? used : 0;
+        if (ok && qz.uniform) {
+            ok = sscanf(p, "%f %f%n", &qz.lo, &qz.scale, &used) == 2;
+            p += ok ? used : 0;
+        }
+        for (int i = 0; ok && i < 255; i++) {
+            ok = sscanf(p, "%f%n", &qz.edge[i], &used) == 1 && (i == 0 || qz.edge[i] >= qz.edge[i - 1]);
+            p += ok ? used : 0;
+        }
+        if (!ok) {
+            fprintf(stderr, "error: %s:%d: malformed quantiser\n", path, lineno);
+            fclose(f);
+            return false;
+        }
+        map.push_back(qz);
+    }
+
+    fclose(f);
+    return true;
+}
+
+// =========================================================================
+// Float trees
+// =========================================================================
+struct FloatNode {
+    bool  is_leaf;
+    float threshold;
+    bool  less_than;
+    int   left_idx, right_idx, action;
+};
+
+static bool read_float_tree(const char *path, std::vector<FloatNode> &tree) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "error: cannot open %s\n", path);
+        return false;
+    }
+
+    tree.clear();
+    char line[256];
+    int lineno = 0;
+    while (fgets(line, sizeof(line), f)) {
+        lineno++;
+        char *p = line;
+        while (*p == ' ' || *p == '\t') p++;
+        if (*p == '#' || *p == '\n' || *p == '\r' || *p == '\0') continue;
+
+        unsigned leaf, lt, l, r, a;
+        float t;
+        if (sscanf(p, "%u %f %u %u %u %u", &leaf, &t, &lt, &l, &r, &a) != 6
+            || leaf > 1 || lt > 1 || l > 63 || r > 63 || a > 3 || (leaf && (t < 0 || t > 255))) {
+            fprintf(stderr, "error: %s:%d: malformed node line\n", path, lineno);
+            fclose(f);
+            return false;
+        }
+        tree.push_back({leaf != 0, t, lt != 0, (int)l, (int)r, (int)a});
+    }
+
+    fclose(f);
+    return !tree.empty();
+}
+
+static int simulate_float(const std::vector<FloatNode> &tree, float x) {
+    int idx = 0;
+    for (int step = 0; step < 64; step++) {
+        if (idx >= (int)tree.size()) return -1;
+        const FloatNode &n = tree[idx];
+        if (n.is_leaf) return n.action;
+        bool cond = n.less_than ? (x < n.threshold) : (x > n.threshold);
+        idx = cond ? n.left_idx : n.right_idx;
+    }
+    return -1;
+}
+
+// x < t  →  q < T with edge[T-1] nearest t (T = 0: never, 255: below the top edge)
+// x > t  →  q > T with edge[T]   nearest t (T = 255: never)
+static uint8_t map_threshold(const Quantizer &qz, float t, bool less_than) {
+    int best = less_than ? 0 : 255;
+    float dist = INFINITY;
+    for (int T = 0; T < 256; T++) {
+        int e = less_than ? T - 1 : T;
+        if (e < 0 || e > 254) continue;
+        float d = std::fabs(qz.edge[e] - t);
+        if (d < dist) {
+            dist = d;
+            best = T;
+        }
+    }
+    return (uint8_t)best;
+}
+
+// =========================================================================
+static int usage(const char *prog) {
+    fprintf(stderr, "usage: %s fit [--uniform] [--label K] <samples.csv> <out.qmap>\n"
+                    "       %s apply [--label K] <map.qmap> <in.csv> <out.csv>\n"
+                    "       %s model [--feature K] [--label K] <map.qmap> <model.ftree>\n"
+                    "                <samples.csv> <out.tree>\n", prog, prog, prog);
+    return 2;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2) return usage(argv[0]);
+    std::string cmd = argv[1];
+    bool uniform = false;
+    int label_col = -1, feature = 0;
+    std::vector<const char *> pos;
+
+    for (int i = 2; i < argc; i++) {
+        std::string a = argv[i];
+        if      (a == "--uniform")                   uniform   = true;
+        else if (a == "--label"   && i + 1 < argc)   label_col = atoi(argv[++i]);
+        else if (a == "--feature" && i + 1 < argc)   feature   = atoi(argv[++i]);
+        else if (a[0] == '-' && a.size() > 1)        return usage(argv[0]);
+        else pos.push_back(argv[i]);
+    }
+
+    // ---- fit ----
+    if (cmd == "fit" && pos.size() == 2) {
+        Samples s;
+        if (!read_samples(pos[0], label_col, s)) return 1;
+        std::vector<Quantizer> map;
+        for (size_t k = 0; k < s.col.size(); k++)
+            map.push_back(fit_column((int)k, s.col[k], uniform));
+        if (!write_map(pos[1], map)) return 1;
+
+        printf("%s: %d samples, %d features, %s bins -> %s\n", pos[0], (int)s.label.size(),
+               (int)map.size(), uniform ? "uniform" : "quantile", pos[1]);
+        for (const Quantizer &qz : map) {
+            int distinct = 1;
+            for (int i = 1; i < 255; i++) distinct += qz.edge[i] != qz.edge[i - 1];
+            printf("  feature %d: [%g, %g], %d distinct edges\n",
+                   qz.column, qz.edge[0], qz.edge[254], distinct);
+        }
+        return 0;
+    }
+
+    // ---- apply ----
+    if (cmd == "apply" && pos.size() == 3) {
+        std::vector<Quantizer> map;
+        Samples s;
+        if (!read_map(pos[0], map) || !read_samples(pos[1], label_col, s)) return 1;
+        if (map.size() != s.col.size()) {
+            fprintf(stderr, "error: map has %d features, %s has %d\n",
+                    (int)map.size(), pos[1], (int)s.col.size());
+            return 1;
+        }
+
+        size_t n = s.label.size();
+        std::vector<std::vector<uint8_t>> q(map.size(), std::vector<uint8_t>(n));
+        for (size_t k = 0; k < map.size(); k++)
+            quantize_batch(map[k], s.col[k].data(), n, q[k].data());
+
+        FILE *f = fopen(pos[2], "w");
+        if (!f) {
+            fprintf(stderr, "error: cannot create %s\n", pos[2]);
+            return 1;
+        }
+        if (!s.header.empty()) fputs(s.header.c_str(), f);
+        int lc = label_col < 0 ? (int)map.size() : label_col;
+        for (size_t i = 0; i < n; i++) {
+            for (int k = 0, c = 0; k <= (int)map.size(); k++) {
+                if (k) fputc(',', f);
+                if (k == lc) fputs(s.label[i].c_str(), f);
+                else         fprintf(f, "%u", q[c++][i]);
+            }
+            fputc('\n', f);
+        }
+        fclose(f);
+        printf("%s: %d samples, %d features -> %s\n", pos[1], (int)n, (int)map.size(), pos[2]);
+        return 0;
+    }
+
+    // ---- model ----
+    if (cmd == "model" && pos.size() == 4) {
+        std::vector<Quantizer> map;
+        std::vector<FloatNode> ftree;
+        Samples s;
+        if (!read_map(pos[0], map) || !read_float_tree(pos[1], ftree)
+            || !read_samples(pos[2], label_col, s)) return 1;
+        if (feature < 0 || feature >= (int)map.size() || feature >= (int)s.col.size()) {
+            fprintf(stderr, "error: no feature %d in the map and samples\n", feature);
+            return 1;
+        }
+        const Quantizer &qz = map[feature];
+
+        std::vector<Node> tree;
+        printf("%s: feature %d, %s bins\n", pos[1], feature, qz.uniform ? "uniform" : "quantile");
+        for (int i = 0; i < (int)ftree.size(); i++) {
+            const FloatNode &n = ftree[i];
+            if (n.is_leaf) {
+                tree.push_back({1, (uint8_t)n.threshold, 0, 0, 0, (uint8_t)n.action});
+                continue;
+            }
+            uint8_t T = map_threshold(qz, n.threshold, n.less_than);
+            int e = n.less_than ? T - 1 : T;
+            printf("  node %2d: x %c %-12g -> input %c %3u  (edge %g)\n", i,
+                   n.less_than ? '<' : '>', n.threshold, n.less_than ? '<' : '>', T,
+                   e >= 0 && e <= 254 ? qz.edge[e] : NAN);
+            tree.push_back({0, T, (uint8_t)n.less_than, (uint8_t)n.left_idx,
+                            (uint8_t)n.right_idx, (uint8_t)n.action});
+        }
+        if (tree_depth(tree) < 0) {
+            fprintf(stderr, "error: %s: some input never reaches a leaf (cycle in tree?)\n", pos[1]);
+            return 1;
+        }
+
+        const std::vector<float> &x = s.col[feature];
+        size_t n = x.size();
+        std::vector<uint8_t> q(n);
+        quantize_batch(qz, x.data(), n, q.data());
+
+        size_t disagree = 0;
+        uint64_t confusion[4][4] = {};
+        for (size_t i = 0; i < n; i++) {
+            int fa = simulate_float(ftree, x[i]);
+            int qa = simulate_tree(tree, q[i]).action;
+            if (fa < 0) {
+                fprintf(stderr, "error: %s: some sample never reaches a leaf\n", pos[1]);
+                return 1;
+            }
+            confusion[fa][qa]++;
+            disagree += fa != qa;
+        }
+
+        if (!write_tree_file(pos[3], tree)) return 1;
+        printf("  %d nodes -> %s\n", (int)tree.size(), pos[3]);
+        printf("  disagreement vs float model: %.4f%% (%d / %d samples)\n",
+               100.0 * disagree / n, (int)disagree, (int)n);
+        if (disagree) {
+            printf("  float \\ 8-bit   NONE    BUY     SELL    CANCEL\n");
+            for (int a = 0; a < 4; a++)
+                printf("  %s        %-7llu %-7llu %-7llu %llu\n", action_name(a),
+                       (unsigned long long)confusion[a][0], (unsigned long long)confusion[a][1],
+                       (unsigned long long)confusion[a][2], (unsigned long long)confusion[a][3]);
+        }
+        return 0;
+    }
+
+    return usage(argv[0]);
+}
@@ -0,0 +1,451 @@
+// =========================================================================
+// train_tree — histogram CART trainer emitting engine-ready node arrays
+// =========================================================================
+//
+// Usage:
+//   train_tree [options] <samples> <model.tree>
+//
+//   -i              fold leaves into inline child pointers (INLINE_LEAVES=1)
+//   --dag           share identical leaves and subtrees (dedup_tree())
+//   --max-nodes N   node budget, MAX_NODES of the target engine (default 64)
+//   --max-depth D   pipeline stages, MAX_DEPTH of the target engine (default 6)
+//   --min-leaf N    fewest samples a leaf may cover (default 1)
+//   --feature K     feature column to train on (default 0)
+//   --label K       CSV label column (default: last column)
+//   --binary W      samples are fixed W+1 byte records, W feature bytes then
+//                   the label byte, instead of CSV
+//   --threads T     parse/bin threads (default: hardware concurrency)
+//
+// CSV samples are one per line, comma separated; features are 0-255 and
+// labels are 0-3 or NONE/BUY/SELL/CANCEL.  A first line that does not
+// parse is taken as a header.
+//
+// The engines compare a single 8-bit market_input, so a tree can only
+// split on one feature: --feature picks the column, the others are
+// ignored.  That makes the whole data set a 256-bin x 4-class histogram.
+// The sample file is split at line (record) boundaries and each thread
+// parses and bins its share into a private histogram; the merged histogram
+// is all training ever touches, so a day's samples cost one parallel pass
+// over the file and the tree itself is grown in microseconds.
+//
+// Growth is best-first on Gini impurity: every leaf holds its best split
+// (prefix sums over the leaf's bin range, O(256)), and the leaf with the
+// largest gain is split next, as long as the node budget and depth limit
+// allow.  The budget counts what the engine stores — every node, or only
+// internal nodes with -i — and the depth limit is in stages, as reported
+// by tree_stages(), so the result always loads into an engine built with
+// the given MAX_NODES / MAX_DEPTH.  Sibling leaves that ended up with the
+// same action are then merged back into their parent.  With --dag all
+// leaves with one action are a single shared node, so a split costs one
+// node plus any action no leaf had yet, and the emitted tree goes through
+// dedup_tree(): at depths the budget rather than MAX_DEPTH limits, about
+// twice as many splits fit.
+//
+// A split sits at the middle of the empty bin run between the classes it
+// separates.  Leaves take their majority action; a leaf's threshold (its
+// payload template slot) is set to the action, matching the per-action
+// slots inline leaves use.  Nodes are numbered breadth-first, root at 0.
+// The written tree is re-checked with simulate_tree() on all 256 inputs
+// and the reported accuracy comes from that walk.
+// =========================================================================
+
+#include "../sim/tree_model.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+struct Hist {
+    uint64_t n[256][4];
+};
+
+struct BinStats {
+    uint64_t samples;
+    uint64_t malformed;
+    uint64_t first_bad;      // byte offset of the first malformed line
+};
+
+static int parse_label(const char *s, const char *e) {
+    while (s < e && (*s == ' ' || *s == '\t')) s++;
+    while (e > s && (e[-1] == ' ' || e[-1] == '\t' || e[-1] == '\r')) e--;
+    static const char *names[4] = {"NONE", "BUY", "SELL", "CANCEL"};
+    if (e - s == 1 && *s >= '0' && *s <= '3') return *s - '0';
+    for (int a = 0; a < 4; a++)
+        if ((size_t)(e - s) == strlen(names[a]) && !strncmp(s, names[a], e - s))
+            return a;
+    return -1;
+}
+
+static int parse_feature(const char *s, const char *e) {
+    while (s < e && (*s == ' ' || *s == '\t')) s++;
+    int v = 0, digits = 0;
+    while (s < e && *s >= '0' && *s <= '9' && v <= 255) { v = v * 10 + (*s++ - '0'); digits++; }
+    while (s < e && (*s == ' ' || *s == '\t' || *s == '\r')) s++;
+    return digits && s == e && v <= 255 ? v : -1;
+}
+
+// Bins the CSV lines in [begin, end), which starts at a line boundary.
+static void bin_csv(const char *begin, const char *end, const char *file_start,
+                    int feature_col, int label_col, Hist &h, BinStats &st) {
+    const char *fields[256];
+    for (const char *p = begin; p < end; ) {
+        const char *eol = (const char *)memchr(p, '\n', end - p);
+        if (!eol) eol = end;
+
+        int n = 0;
+        fields[n++] = p;
+        for (const char *q = p; q < eol && n < 255; q++)
+            if (*q == ',') fields[n++] = q + 1;
+        fields[n] = eol + 1;                 // field k spans [fields[k], fields[k+1] - 1)
+
+        bool blank = true;
+        for (const char *q = p; q < eol; q++)
+            if (*q != ' ' && *q != '\t' && *q != '\r') { blank = false; break; }
+
+        if (!blank && *p != '#') {
+            int lc = label_col < 0 ? n - 1 : label_col;
+            int f = feature_col < n ? parse_feature(fields[feature_col], fields[feature_col + 1] - 1) : -1;
+            int l = lc < n ? parse_label(fields[lc], fields[lc + 1] - 1) : -1;
+            if (f >= 0 && l >= 0) {
+                h.n[f][l]++;
+                st.samples++;
+            } else if (p != file_start) {      // line 1 may be a header
+                if (!st.malformed) st.first_bad = p - file_start;
+                st.malformed++;
+            }
+        }
+        p = eol + 1;
+    }
+}
+
+static void bin_records(const uint8_t *begin, const uint8_t *end, int width,
+                        int feature_col, Hist &h, BinStats &st) {
+    for (const uint8_t *p = begin; p + width + 1 <= end; p += width + 1) {
+        uint8_t l = p[width];
+        if (l > 3) {
+            st.malformed++;
+            continue;
+        }
+        h.n[p[feature_col]][l]++;
+        st.samples++;
+    }
+}
+
+// =========================================================================
+// Best-first growth over the histogram
+// =========================================================================
+struct Leaf {
+    int      lo, hi;           // bin range [lo, hi] that reaches this node
+    int      depth;
+    uint64_t count[4];
+    // best split: left = [lo, split - 1], right = [split, hi]
+    int      split;
+    double   gain;
+};
+
+struct Grown {
+    bool is_leaf;
+    int  threshold, action;
+    int  left, right;          // indices into the grown vector
+    int  depth;
+};
+
+static double gini_mass(const uint64_t c[4]) {       // N * gini
+    double n = (double)(c[0] + c[1] + c[2] + c[3]);
+    if (n == 0) return 0;
+    double sq = 0;
+    for (int k = 0; k < 4; k++) sq += (double)c[k] * c[k];
+    return n - sq / n;
+}
+
+static int majority(const uint64_t c[4]) {
+    int best = 0;
+    for (int k = 1; k < 4; k++)
+        if (c[k] > c[best]) best = k;
+    return best;
+}
+
+static void best_split(const Hist &h, Leaf &leaf, uint64_t min_leaf) {
+    leaf.split = -1;
+    leaf.gain  = 0;
+    double parent = gini_mass(leaf.count);
+    if (parent == 0) return;
+
+    uint64_t left[4] = {0, 0, 0, 0};
+    for (int v = leaf.lo; v < leaf.hi; v++) {
+        const uint64_t *b = h.n[v];
+        for (int k = 0; k < 4; k++) left[k] += b[k];
+        if (!(b[0] | b[1] | b[2] | b[3])) continue;
+
+        // Left ends at non-empty bin v, right starts at the next non-empty
+        // bin; empty bins between them do not change the gain.
+        int next = v + 1;
+        while (next <= leaf.hi && !(h.n[next][0] | h.n[next][1] | h.n[next][2] | h.n[next][3])) next++;
+        if (next > leaf.hi) break;
+
+        uint64_t right[4], nl = 0, nr = 0;
+        for (int k = 0; k < 4; k++) {
+            right[k] = leaf.count[k] - left[k];
+            nl += left[k];
+            nr += right[k];
+        }
+        if (nl < min_leaf || nr < min_leaf) continue;
+
+        double gain = parent - gini_mass(left) - gini_mass(right);
+        if (gain > leaf.gain + 1e-9) {
+            leaf.gain  = gain;
+            leaf.split = (v + 1 + next) / 2 + ((v + 1 + next) & 1);   // mid-gap, in (v, next]
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    bool fold = false, dag = false;
+    int max_nodes = 64, max_depth = 6, feature_col = 0, label_col = -1, width = -1;
+    uint64_t min_leaf = 1;
+    unsigned threads = std::thread::hardware_concurrency();
+    std::vector<const char *> pos;
+
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_val = i + 1 < argc;
+        if      (a == "-i") fold = true;
+        else if (a == "--dag") dag = true;
+        else if (a == "--max-nodes" && has_val) max_nodes   = atoi(argv[++i]);
+        else if (a == "--max-depth" && has_val) max_depth   = atoi(argv[++i]);
+        else if (a == "--min-leaf"  && has_val) min_leaf    = strtoull(argv[++i], nullptr, 10);
+        else if (a == "--feature"   && has_val) feature_col = atoi(argv[++i]);
+        else if (a == "--label"     && has_val) label_col   = atoi(argv[++i]);
+        else if (a == "--binary"    && has_val) width       = atoi(argv[++i]);
+        else if (a == "--threads"   && has_val) threads     = (unsigned)atoi(argv[++i]);
+        else if (a[0] == '-' && a.size() > 1) {
+            fprintf(stderr, "error: unknown option %s\n", a.c_str());
+            return 2;
+        }
+        else pos.push_back(argv[i]);
+    }
+
+    if (pos.size() != 2) {
+        fprintf(stderr, "usage: %s [-i] [--dag] [--max-nodes N] [--max-depth D] [--min-leaf N]\n"
+                        "          [--feature K] [--label K] [--binary W] [--threads T]\n"
+                        "          <samples> <model.tree>\n", argv[0]);
+        return 2;
+    }
+    if (max_nodes < 1 || max_nodes > 64 || max_depth < 1 || min_leaf < 1
+        || feature_col < 0 || feature_col > 254 || label_col > 254
+        || (width >= 0 && (width < 1 || feature_col >= width))) {
+        fprintf(stderr, "error: option out of range\n");
+        return 2;
+    }
+    if (threads < 1) threads = 1;
+
+    auto t0 = std::chrono::steady_clock::now();
+
+    // ---- Read and bin ----
+    FILE *f = fopen(pos[0], "rb");
+    if (!f) {
+        fprintf(stderr, "error: cannot open %s\n", pos[0]);
+        return 1;
+    }
+    std::vector<char> buf;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    buf.resize(size > 0 ? size : 0);
+    if (size > 0 && fread(buf.data(), 1, size, f) != (size_t)size) {
+        fprintf(stderr, "error: short read on %s\n", pos[0]);
+        fclose(f);
+        return 1;
+    }
+    fclose(f);
+
+    // Chunk boundaries on line / record starts
+    std::vector<size_t> cut(threads + 1, buf.size());
+    cut[0] = 0;
+    for (unsigned t = 1; t < threads; t++) {
+        size_t c = buf.size() * t / threads;
+        if (width >= 0) {
+            c -= c % (width + 1);
+        } else {
+            while (c > 0 && c < buf.size() && buf[c - 1] != '\n') c++;
+        }
+        cut[t] = std::max(c, cut[t - 1]);
+    }
+
+    std::vector<Hist> part(threads, Hist());
+    std::vector<BinStats> stats(threads);
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; t++) {
+        stats[t] = {0, 0, 0};
+        pool.emplace_back([&, t]() {
+            if (width >= 0)
+                bin_records((const uint8_t *)buf.data() + cut[t], (const uint8_t *)buf.data() + cut[t + 1],
+                            width, feature_col, part[t], stats[t]);
+            else
+                bin_csv(buf.data() + cut[t], buf.data() + cut[t + 1], buf.data(),
+                        feature_col, label_col, part[t], stats[t]);
+        });
+    }
+    for (std::thread &th : pool) th.join();
+
+    Hist h = Hist();
+    uint64_t samples = 0, malformed = 0;
+    for (unsigned t = 0; t < threads; t++) {
+        for (int v = 0; v < 256; v++)
+            for (int k = 0; k < 4; k++) h.n[v][k] += part[t].n[v][k];
+        samples += stats[t].samples;
+        if (!malformed && stats[t].malformed) {
+            fprintf(stderr, "error: %s: malformed sample at byte %llu\n",
+                    pos[0], (unsigned long long)stats[t].first_bad);
+        }
+        malformed += stats[t].malformed;
+    }
+    if (width >= 0 && buf.size() % (width + 1)) {
+        fprintf(stderr, "error: %s: trailing partial record\n", pos[0]);
+        return 1;
+    }
+    if (malformed) {
+        fprintf(stderr, "error: %llu malformed samples\n", (unsigned long long)malformed);
+        return 1;
+    }
+    if (!samples) {
+        fprintf(stderr, "error: %s holds no samples\n", pos[0]);
+        return 1;
+    }
+
+    auto t1 = std::chrono::steady_clock::now();
+
+    // ---- Grow ----
+    // Non-inline: a leaf at depth d is a node and needs d + 1 stages, and
+    // each split adds two nodes.  Inline: leaves are free pointers, a leaf
+    // at depth d needs d stages, and each split adds one stored node.
+    // DAG: one node per split plus one per distinct leaf action.
+    int leaf_depth_max = fold ? max_depth : max_depth - 1;
+    int split_cost     = fold ? 1 : 2;
+    int stored         = 1;
+
+    std::vector<Grown> g;
+    std::vector<Leaf>  leaves;
+    std::vector<int>   leaf_node;          // leaves[i] is g[leaf_node[i]]
+    Leaf root = {0, 255, 0, {0, 0, 0, 0}, -1, 0};
+    for (int v = 0; v < 256; v++)
+        for (int k = 0; k < 4; k++) root.count[k] += h.n[v][k];
+    best_split(h, root, min_leaf);
+    g.push_back({true, 0, majority(root.count), -1, -1, 0});
+    leaves.push_back(root);
+    leaf_node.push_back(0);
+
+    for (;;) {
+        int pick = -1;
+        for (int i = 0; i < (int)leaves.size(); i++) {
+            if (leaves[i].split < 0 || leaves[i].depth + 1 > leaf_depth_max) continue;
+            if (pick < 0 || leaves[i].gain > leaves[pick].gain) pick = i;
+        }
+        if (pick < 0) break;
+
+        Leaf p = leaves[pick];
+        int id = leaf_node[pick];
+        Leaf l = {p.lo, p.split - 1, p.depth + 1, {0, 0, 0, 0}, -1, 0};
+        Leaf r = {p.split, p.hi, p.depth + 1, {0, 0, 0, 0}, -1, 0};
+        for (int v = l.lo; v <= l.hi; v++)
+            for (int k = 0; k < 4; k++) l.count[k] += h.n[v][k];
+        for (int k = 0; k < 4; k++) r.count[k] = p.count[k] - l.count[k];
+
+        // Inline: the first split turns the stored root into an internal
+        // node without adding one
+        int cost = fold && g.size() == 1 ? 0 : split_cost;
+        if (dag && !fold) {
+            bool had[4] = {false, false, false, false}, has[4];
+            for (int i = 0; i < (int)leaves.size(); i++)
+                had[g[leaf_node[i]].action] = true;
+            std::copy(had, had + 4, has);
+            has[majority(l.count)] = has[majority(r.count)] = true;
+            bool kept = false;                 // p's action still on another leaf?
+            for (int i = 0; i < (int)leaves.size(); i++)
+                kept |= i != pick && g[leaf_node[i]].action == g[id].action;
+            if (!kept && majority(l.count) != g[id].action && majority(r.count) != g[id].action)
+                has[g[id].action] = false;
+            cost = 1;
+            for (int k = 0; k < 4; k++) cost += has[k] - had[k];
+        }
+        if (stored + cost > max_nodes) break;
+        stored += cost;
+
+        best_split(h, l, min_leaf);
+        best_split(h, r, min_leaf);
+
+        g[id] = {false, p.split, 0, (int)g.size(), (int)g.size() + 1, p.depth};
+        g.push_back({true, 0, majority(l.count), -1, -1, l.depth});
+        g.push_back({true, 0, majority(r.count), -1, -1, r.depth});
+        leaves[pick] = l;
+        leaf_node[pick] = g[id].left;
+        leaves.push_back(r);
+        leaf_node.push_back(g[id].right);
+    }
+
+    // Merge sibling leaves with the same action (a Gini gain that does not
+    // change any decision), bottom-up until nothing changes
+    for (bool changed = true; changed; ) {
+        changed = false;
+        for (Grown &n : g) {
+            if (n.is_leaf) continue;
+            const Grown &a = g[n.left], &b = g[n.right];
+            if (a.is_leaf && b.is_leaf && a.action == b.action) {
+                n = {true, 0, a.action, -1, -1, n.depth};
+                changed = true;
+            }
+        }
+    }
+
+    // ---- Emit breadth-first ----
+    std::vector<int> order(1, 0), index(g.size(), -1);
+    index[0] = 0;
+    for (size_t i = 0; i < order.size(); i++) {
+        const Grown &n = g[order[i]];
+        if (n.is_leaf) continue;
+        for (int c : {n.left, n.right}) {
+            index[c] = (int)order.size();
+            order.push_back(c);
+        }
+    }
+    std::vector<Node> tree;
+    for (int id : order) {
+        const Grown &n = g[id];
+        if (n.is_leaf)
+            tree.push_back({1, (uint8_t)n.action, 0, 0, 0, (uint8_t)n.action});
+        else
+            tree.push_back({0, (uint8_t)n.threshold, 1, (uint8_t)index[n.left],
+                            (uint8_t)index[n.right], 0});
+    }
+    if (fold) tree = inline_leaves(tree);
+    if (dag)  tree = dedup_tree(tree);
+
+    auto t2 = std::chrono::steady_clock::now();
+
+    // ---- Check what the engine will see ----
+    int stages = tree_stages(tree);
+    if (stages < 0 || stages > max_depth || (int)tree.size() > max_nodes) {
+        fprintf(stderr, "error: internal: %d nodes, %d stages does not fit\n",
+                (int)tree.size(), stages);
+        return 1;
+    }
+    uint64_t correct = 0;
+    for (int v = 0; v < 256; v++)
+        correct += h.n[v][simulate_tree(tree, (uint8_t)v).action];
+
+    if (!write_tree_file(pos[1], tree)) return 1;
+
+    auto ms = [](std::chrono::steady_clock::duration d) {
+        return std::chrono::duration<double, std::milli>(d).count();
+    };
+    printf("%s: %llu samples (feature %d), %d threads, read+bin %.1f ms, grow %.3f ms\n",
+           pos[0], (unsigned long long)samples, feature_col, threads,
+           ms(t1 - t0), ms(t2 - t1));
+    printf("  %d nodes, depth %d, %d stages%s -> %s\n",
+           (int)tree.size(), tree_depth(tree), stages,
+           fold ? " (INLINE_LEAVES=1)" : dag ? " (shared DAG)" : "", pos[1]);
+    printf("  training accuracy %.4f (%llu / %llu)\n",
+           (double)correct / samples, (unsigned long long)correct, (unsigned long long)samples);
+    return 0;
+}
@@ -0,0 +1,144 @@
+// =========================================================================
+// tree2mask — replace threshold chains with bitmask (set-membership) nodes
+// =========================================================================
+//
+// Usage:
+//   tree2mask [--coarse] [--masks N] [--trace FILE] <model.tree> [out.mtree]
+//
+//   --coarse      32-bucket masks (input / 8) instead of 256-bit masks
+//   --masks N     mask table entries, MASK_ENTRIES of the engine (default 8)
+//   --trace FILE  weight the threshold tree's mean FSM latency by a replay
+//                 trace (one market_input per line) instead of all 256
+//                 inputs equally
+//
+// Converts with convert_to_mask() (sim/tree_mask.h), checks the actions
+// against the threshold model on all 256 inputs, and reports what the
+// conversion buys:
+//
+//   depth            deepest leaf
+//   stages           MAX_DEPTH a pipelined engine needs (depth + 1);
+//                    latency is MAX_DEPTH + 2 cycles
+//   FSM mean/worst   the threshold tree on the FSM engine (decision_tree):
+//                    depth + 1 cycles per query, over the inputs or trace.
+//                    Threshold row only — no FSM engine takes mask nodes,
+//                    decision_tree_mask is pipelined
+//
+// With out.mtree, writes the nodes and masks as text:
+//
+//   # is_leaf is_mask threshold less_than left_idx right_idx action
+//   mask <index> <64 hex digits, bucket 255 first>
+//
+// The Verilator harness (sim/test_mask.cpp) runs the same conversion
+// in-process before loading decision_tree_mask.
+// =========================================================================
+
+#include "../sim/tree_mask.h"
+
+struct Latency {
+    double mean;
+    int    worst;
+};
+
+static Latency fsm_latency(const std::vector<Node> &tree, const std::vector<uint8_t> &inputs) {
+    double sum = 0;
+    int worst = 0;
+    for (uint8_t x : inputs) {
+        int c = simulate_tree(tree, x).depth + 1;
+        sum += c;
+        if (c > worst) worst = c;
+    }
+    return {sum / inputs.size(), worst};
+}
+
+int main(int argc, char **argv) {
+    int bits = 256, masks = 8;
+    const char *trace = nullptr;
+    std::vector<const char *> pos;
+    for (int i = 1; i < argc; i++) {
+        std::string a = argv[i];
+        bool has_val = i + 1 < argc;
+        if      (a == "--coarse") bits = 32;
+        else if (a == "--masks" && has_val) masks = atoi(argv[++i]);
+        else if (a == "--trace" && has_val) trace = argv[++i];
+        else if (a[0] == '-' && a.size() > 1) {
+            fprintf(stderr, "error: unknown option %s\n", a.c_str());
+            return 2;
+        }
+        else pos.push_back(argv[i]);
+    }
+    if (pos.size() < 1 || pos.size() > 2 || masks < 0 || masks > 256) {
+        fprintf(stderr, "usage: %s [--coarse] [--masks N] [--trace FILE] <model.tree> [out.mtree]\n",
+                argv[0]);
+        return 2;
+    }
+
+    std::vector<Node> tree;
+    if (!read_tree_file(pos[0], tree)) return 1;
+    std::vector<uint8_t> inputs;
+    if (trace) {
+        if (!read_trace_file(trace, inputs)) return 1;
+        if (inputs.empty()) {
+            fprintf(stderr, "error: %s has no inputs\n", trace);
+            return 1;
+        }
+    } else {
+        for (int x = 0; x < 256; x++) inputs.push_back((uint8_t)x);
+    }
+
+    MaskTree mt;
+    if (!convert_to_mask(tree, bits, masks, mt)) {
+        fprintf(stderr, "error: malformed tree (cycle or out-of-range child) or over 64 nodes\n");
+        return 1;
+    }
+
+    int mismatches = 0;
+    for (int inp = 0; inp < 256; inp++) {
+        if (simulate_mask(mt, (uint8_t)inp).action != simulate_tree(tree, (uint8_t)inp).action)
+            mismatches++;
+    }
+    if (mismatches) {
+        fprintf(stderr, "error: %d / 256 inputs disagree after conversion\n", mismatches);
+        return 1;
+    }
+
+    int depth  = tree_depth(tree);
+    int mdepth = mask_depth(mt);
+    int mask_nodes = 0;
+    for (const MaskNode &n : mt.nodes) mask_nodes += n.is_mask;
+    Latency fsm = fsm_latency(tree, inputs);
+
+    printf("%d-bit masks, %d entries, FSM latency over %s\n",
+           bits, masks, trace ? trace : "all 256 inputs");
+    printf("            nodes  masks  depth  stages  pipelined  FSM mean  FSM worst\n");
+    printf("threshold:  %5d  %5d  %5d  %6d  %9d  %8.2f  %9d\n",
+           (int)tree.size(), 0, depth, tree_stages(tree), tree_stages(tree) + 2, fsm.mean, fsm.worst);
+    printf("mask:       %5d  %5d  %5d  %6d  %9d  %8s  %9s\n",
+           (int)mt.nodes.size(), (int)mt.masks.size(), mdepth, mdepth + 1, mdepth + 3, "-", "-");
+    printf("%d mask nodes; all 256 inputs match the threshold model\n", mask_nodes);
+
+    if (pos.size() == 2) {
+        FILE *f = fopen(pos[1], "w");
+        if (!f) {
+            fprintf(stderr, "error: cannot create %s\n", pos[1]);
+            return 1;
+        }
+        fprintf(f, "# %d-bit masks\n", bits);
+        fprintf(f, "# is_leaf is_mask threshold less_than left_idx right_idx action\n");
+        for (int i = 0; i < (int)mt.nodes.size(); i++) {
+            const MaskNode &n = mt.nodes[i];
+            fprintf(f, "%u %u %3u %u %2u %2u %u   # %2d\n", n.is_leaf, n.is_mask, n.threshold,
+                    n.less_than, n.left_idx, n.right_idx, n.action, i);
+        }
+        for (int m = 0; m < (int)mt.masks.size(); m++) {
+            fprintf(f, "mask %d ", m);
+            for (int nib = 63; nib >= 0; nib--) {
+                int v = 0;
+                for (int k = 3; k >= 0; k--) v = v * 2 + mt.masks[m][nib * 4 + k];
+                fprintf(f, "%x", v);
+            }
+            fprintf(f, "\n");
+        }
+        fclose(f);
+    }
+    return 0;
+}
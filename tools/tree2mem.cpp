@@ -0,0 +1,71 @@
+// =========================================================================
+// tree2mem — emit a $readmemh image for TREE_INIT_FILE from a node array
+// =========================================================================
+//
+// Usage:
+//   tree2mem [-i] <model.tree> <image.mem> [max_nodes]
+//
+// Reads a text model (see sim/tree_model.h), checks that it fits the engine
+// and that every input reaches a leaf, then writes one packed node_t word
+// per line, zero-padded to max_nodes (default 64).  Pass the result to
+// either engine as TREE_INIT_FILE and the tree is live straight out of
+// reset — no sw_we programming sequence needed.
+//
+// -i folds leaf nodes into inline child pointers first (inline_leaves()).
+// Any model with inline pointers is packed with CHILD_WIDTH = ADDR_WIDTH+1
+// and must be loaded into an engine built with INLINE_LEAVES=1.
+// =========================================================================
+
+#include "../sim/tree_model.h"
+
+static int clog2(int n) {
+    int b = 0;
+    while ((1 << b) < n) b++;
+    return b;
+}
+
+int main(int argc, char **argv) {
+    bool fold = argc > 1 && std::string(argv[1]) == "-i";
+    if (fold) { argc--; argv++; }
+
+    if (argc < 3 || argc > 4) {
+        fprintf(stderr, "usage: %s [-i] <model.tree> <image.mem> [max_nodes]\n", argv[0]);
+        return 2;
+    }
+
+    int max_nodes  = argc == 4 ? atoi(argv[3]) : 64;
+    int addr_width = clog2(max_nodes);
+
+    std::vector<Node> tree;
+    if (!read_tree_file(argv[1], tree)) return 1;
+    if (fold) tree = inline_leaves(tree);
+    bool inl = has_inline_leaves(tree);
+
+    if (tree.empty() || (int)tree.size() > max_nodes) {
+        fprintf(stderr, "error: %d nodes does not fit MAX_NODES=%d\n",
+                (int)tree.size(), max_nodes);
+        return 1;
+    }
+    for (int i = 0; i < (int)tree.size(); i++) {
+        const Node &n = tree[i];
+        bool left_ok  = is_inline_leaf(n.left_idx)  || n.left_idx  < tree.size();
+        bool right_ok = is_inline_leaf(n.right_idx) || n.right_idx < tree.size();
+        if (!n.is_leaf && (!left_ok || !right_ok)) {
+            fprintf(stderr, "error: node %d points outside the tree\n", i);
+            return 1;
+        }
+    }
+
+    int depth = tree_depth(tree);
+    if (depth < 0) {
+        fprintf(stderr, "error: some input never reaches a leaf (cycle in tree?)\n");
+        return 1;
+    }
+
+    if (!write_mem_file(argv[2], tree, max_nodes, addr_width, inl)) return 1;
+
+    printf("%s: %d nodes, depth %d, %d bits/node%s -> %s\n",
+           argv[1], (int)tree.size(), depth, node_bits(addr_width, inl),
+           inl ? " (INLINE_LEAVES=1)" : "", argv[2]);
+    return 0;
+}
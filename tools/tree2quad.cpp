@@ -0,0 +1,73 @@
+// =========================================================================
+// tree2quad — convert a binary model to 4-ary (quad) split nodes
+// =========================================================================
+//
+// Usage:
+//   tree2quad <model.tree> [out.qtree]
+//
+// Converts with convert_to_quad() (sim/tree_quad.h), checks the result
+// against the binary golden model on all 256 inputs and reports node count
+// and depth before/after, warning if the quad tree does not fit the
+// engine's default MAX_NODES = 64.  With out.qtree, writes the quad nodes
+// as text, one per line:
+//
+//   # is_leaf t0 t1 t2 c0 c1 c2 c3 action
+//
+// The Verilator harness (sim/test_quad.cpp) runs the same conversion
+// in-process before loading decision_tree_quad.
+// =========================================================================
+
+#include "../sim/tree_quad.h"
+
+int main(int argc, char **argv) {
+    if (argc < 2 || argc > 3) {
+        fprintf(stderr, "usage: %s <model.tree> [out.qtree]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<Node> tree;
+    if (!read_tree_file(argv[1], tree)) return 1;
+
+    int depth = tree_depth(tree);
+    std::vector<QuadNode> quad;
+    if (depth < 0 || !convert_to_quad(tree, quad)) {
+        fprintf(stderr, "error: malformed tree (cycle or out-of-range child)\n");
+        return 1;
+    }
+
+    int mismatches = 0;
+    for (int inp = 0; inp < 256; inp++) {
+        if (simulate_quad(quad, (uint8_t)inp).action != simulate_tree(tree, (uint8_t)inp).action)
+            mismatches++;
+    }
+    if (mismatches) {
+        fprintf(stderr, "error: %d / 256 inputs disagree after conversion\n", mismatches);
+        return 1;
+    }
+
+    int qdepth = quad_depth(quad);
+    printf("binary: %3d nodes, depth %d  ->  %d pipeline stages (MAX_DEPTH)\n",
+           (int)tree.size(), depth, depth + 1);
+    printf("quad:   %3d nodes, depth %d  ->  %d pipeline stages (MAX_DEPTH)\n",
+           (int)quad.size(), qdepth, qdepth + 1);
+    printf("all 256 inputs match the binary golden model\n");
+    if ((int)quad.size() > 64)
+        printf("warning: %d nodes do not fit MAX_NODES = 64 (ADDR_WIDTH = 6)\n", (int)quad.size());
+
+    if (argc == 3) {
+        FILE *f = fopen(argv[2], "w");
+        if (!f) {
+            fprintf(stderr, "error: cannot create %s\n", argv[2]);
+            return 1;
+        }
+        fprintf(f, "# is_leaf t0 t1 t2 c0 c1 c2 c3 action\n");
+        for (int i = 0; i < (int)quad.size(); i++) {
+            const QuadNode &q = quad[i];
+            fprintf(f, "%u %3u %3u %3u %2u %2u %2u %2u %u   # %2d\n",
+                    q.is_leaf, q.threshold[0], q.threshold[1], q.threshold[2],
+                    q.child[0], q.child[1], q.child[2], q.child[3], q.action, i);
+        }
+        fclose(f);
+    }
+    return 0;
+}
@@ -0,0 +1,274 @@
+// =========================================================================
+// tree2sv — generate a fixed-model engine with the tree hard-wired
+// =========================================================================
+//
+// Usage:
+//   tree2sv <model.tree> <out.sv> [module_name] [max_depth]
+//
+// Emits a SystemVerilog module with the same parameters, ports, pipeline
+// structure and latency (MAX_DEPTH + 2 cycles, 1 result/cycle) as
+// rtl/decision_tree_pipelined.sv, but with no tree_mem: every stage is a
+// case statement over the nodes reachable at that level, comparing against
+// constant thresholds.  Synthesis folds each comparator into a handful of
+// LUTs on pipe_input.  The sw_* ports are kept for drop-in compatibility
+// and ignored — reloading the model means regenerating and rebuilding.
+//
+// Inline leaf children (128 + action, see sim/tree_model.h) resolve in the
+// parent's stage, exactly as in the engine built with INLINE_LEAVES=1.
+//
+// The leaf payload RAM stays programmable (order templates change more often
+// than the model); each leaf's template slot is a constant taken from its
+// threshold column (inline leaves: the action), as in the engine.
+//
+// Default module_name is decision_tree_fixed, default max_depth is 6.
+// =========================================================================
+
+#include "../sim/tree_model.h"
+#include <set>
+
+static int clog2(int n) {
+    int b = 0;
+    while ((1 << b) < n) b++;
+    return b;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3 || argc > 5) {
+        fprintf(stderr, "usage: %s <model.tree> <out.sv> [module_name] [max_depth]\n", argv[0]);
+        return 2;
+    }
+
+    const char *module = argc >= 4 ? argv[3] : "decision_tree_fixed";
+    int max_depth      = argc >= 5 ? atoi(argv[4]) : 6;
+
+    std::vector<Node> tree;
+    if (!read_tree_file(argv[1], tree)) return 1;
+    // tree_depth() only follows branches some input takes; the level sets
+    // below follow every child, so check them all up front.
+    for (int i = 0; i < (int)tree.size(); i++) {
+        const Node &n = tree[i];
+        bool left_ok  = is_inline_leaf(n.left_idx)  || n.left_idx  < tree.size();
+        bool right_ok = is_inline_leaf(n.right_idx) || n.right_idx < tree.size();
+        if (!n.is_leaf && (!left_ok || !right_ok)) {
+            fprintf(stderr, "error: node %d points outside the tree\n", i);
+            return 1;
+        }
+    }
+
+    int depth  = tree_depth(tree);
+    int stages = tree_stages(tree);
+    if (tree.empty() || depth < 0) {
+        fprintf(stderr, "error: some input never reaches a leaf (cycle in tree?)\n");
+        return 1;
+    }
+    // Stage s evaluates the node at level s-1, so node leaves must sit at
+    // level MAX_DEPTH-1 or above (inline leaves at MAX_DEPTH) — same limit
+    // as the programmable pipeline.
+    if (stages > max_depth) {
+        fprintf(stderr, "error: tree depth %d needs MAX_DEPTH >= %d\n", depth, stages);
+        return 1;
+    }
+
+    // Nodes reachable at each level (a DAG node may appear at several).
+    std::vector<std::set<int>> level(max_depth);
+    level[0].insert(0);
+    for (int l = 0; l + 1 < max_depth; l++) {
+        for (int idx : level[l]) {
+            const Node &n = tree[idx];
+            if (n.is_leaf) continue;
+            if (!is_inline_leaf(n.left_idx))  level[l + 1].insert(n.left_idx);
+            if (!is_inline_leaf(n.right_idx)) level[l + 1].insert(n.right_idx);
+        }
+    }
+
+    int max_nodes  = 64;
+    while (max_nodes < (int)tree.size()) max_nodes *= 2;
+    int addr_width = clog2(max_nodes);
+
+    FILE *f = fopen(argv[2], "w");
+    if (!f) {
+        fprintf(stderr, "error: cannot create %s\n", argv[2]);
+        return 1;
+    }
+
+    fprintf(f, "`timescale 1ns / 1ps\n\n");
+    fprintf(f, "// =============================================================================\n");
+    fprintf(f, "// %s — GENERATED by tools/tree2sv from %s. Do not edit.\n", module, argv[1]);
+    fprintf(f, "// =============================================================================\n");
+    fprintf(f, "//\n");
+    fprintf(f, "// Fixed-model engine: %d nodes, depth %d, hard-wired thresholds/topology.\n",
+            (int)tree.size(), depth);
+    fprintf(f, "// Same ports and timing as decision_tree_pipelined (MAX_DEPTH + 2 cycles,\n");
+    fprintf(f, "// 1 result/cycle).  No tree_mem; sw_* tree inputs are ignored, the payload\n");
+    fprintf(f, "// (order template) RAM is programmable as usual.\n");
+    fprintf(f, "// =============================================================================\n\n");
+
+    fprintf(f, "module %s #(\n", module);
+    fprintf(f, "    parameter MAX_NODES  = %d,\n", max_nodes);
+    fprintf(f, "    parameter MAX_DEPTH  = %d,\n", max_depth);
+    fprintf(f, "    parameter ADDR_WIDTH = $clog2(MAX_NODES),\n");
+    fprintf(f, "    parameter PAYLOAD_ENTRIES = 64,\n");
+    fprintf(f, "    parameter PAYLOAD_ADDR_WIDTH = $clog2(PAYLOAD_ENTRIES),\n");
+    fprintf(f, "    parameter PAYLOAD_WIDTH = 32,\n");
+    fprintf(f, "    parameter PAYLOAD_INIT_FILE = \"\"\n");
+    fprintf(f, ")(\n");
+    fprintf(f, "    input  logic         clk,\n");
+    fprintf(f, "    input  logic         rst,\n");
+    fprintf(f, "    input  logic  [7:0]  market_input,\n");
+    fprintf(f, "    input  logic         start,\n");
+    fprintf(f, "    output logic  [1:0]  action,\n");
+    fprintf(f, "    output logic         action_valid,\n");
+    fprintf(f, "    output logic  [PAYLOAD_WIDTH-1:0] payload,\n\n");
+    fprintf(f, "    // Software write interface — unused, kept for drop-in compatibility\n");
+    fprintf(f, "    input  logic                  sw_we,\n");
+    fprintf(f, "    input  logic [ADDR_WIDTH-1:0] sw_addr,\n");
+    fprintf(f, "    input  logic                  sw_data_is_leaf,\n");
+    fprintf(f, "    input  logic [7:0]            sw_data_threshold,\n");
+    fprintf(f, "    input  logic                  sw_data_less_than,\n");
+    fprintf(f, "    input  logic [ADDR_WIDTH-1:0] sw_data_left_idx,\n");
+    fprintf(f, "    input  logic [ADDR_WIDTH-1:0] sw_data_right_idx,\n");
+    fprintf(f, "    input  logic [1:0]            sw_data_action,\n\n");
+    fprintf(f, "    // Payload (order template) write interface\n");
+    fprintf(f, "    input  logic                          sw_payload_we,\n");
+    fprintf(f, "    input  logic [PAYLOAD_ADDR_WIDTH-1:0] sw_payload_addr,\n");
+    fprintf(f, "    input  logic [PAYLOAD_WIDTH-1:0]      sw_payload_data\n");
+    fprintf(f, ");\n\n");
+
+    fprintf(f, "// Leaf payload RAM (order templates)\n");
+    fprintf(f, "logic [PAYLOAD_WIDTH-1:0] payload_mem [0:PAYLOAD_ENTRIES-1];\n\n");
+    fprintf(f, "integer i;\n");
+    fprintf(f, "initial begin\n");
+    fprintf(f, "    for (i = 0; i < PAYLOAD_ENTRIES; i++)\n");
+    fprintf(f, "        payload_mem[i] = '0;\n");
+    fprintf(f, "    if (PAYLOAD_INIT_FILE != \"\")\n");
+    fprintf(f, "        $readmemh(PAYLOAD_INIT_FILE, payload_mem);\n");
+    fprintf(f, "end\n\n");
+    fprintf(f, "always_ff @(posedge clk) begin\n");
+    fprintf(f, "    if (sw_payload_we)\n");
+    fprintf(f, "        payload_mem[sw_payload_addr] <= sw_payload_data;\n");
+    fprintf(f, "end\n\n");
+
+    fprintf(f, "logic                  pipe_valid    [0:MAX_DEPTH];\n");
+    fprintf(f, "logic                  pipe_resolved [0:MAX_DEPTH];\n");
+    fprintf(f, "logic [ADDR_WIDTH-1:0] pipe_node_idx [0:MAX_DEPTH];\n");
+    fprintf(f, "logic [7:0]            pipe_input    [0:MAX_DEPTH];\n");
+    fprintf(f, "logic [1:0]            pipe_result   [0:MAX_DEPTH];\n");
+    fprintf(f, "logic [PAYLOAD_ADDR_WIDTH-1:0] pipe_slot [0:MAX_DEPTH];\n\n");
+
+    fprintf(f, "// Stage 0: capture input, start at root\n");
+    fprintf(f, "always_ff @(posedge clk or posedge rst) begin\n");
+    fprintf(f, "    if (rst) begin\n");
+    fprintf(f, "        pipe_valid[0]    <= 1'b0;\n");
+    fprintf(f, "        pipe_resolved[0] <= 1'b0;\n");
+    fprintf(f, "        pipe_node_idx[0] <= '0;\n");
+    fprintf(f, "        pipe_input[0]    <= '0;\n");
+    fprintf(f, "        pipe_result[0]   <= '0;\n");
+    fprintf(f, "        pipe_slot[0]     <= '0;\n");
+    fprintf(f, "    end else begin\n");
+    fprintf(f, "        pipe_valid[0]    <= start;\n");
+    fprintf(f, "        pipe_resolved[0] <= 1'b0;\n");
+    fprintf(f, "        pipe_node_idx[0] <= '0;\n");
+    fprintf(f, "        pipe_input[0]    <= market_input;\n");
+    fprintf(f, "        pipe_result[0]   <= '0;\n");
+    fprintf(f, "        pipe_slot[0]     <= '0;\n");
+    fprintf(f, "    end\n");
+    fprintf(f, "end\n\n");
+
+    for (int s = 1; s <= max_depth; s++) {
+        fprintf(f, "// Stage %d: level %d (%d reachable nodes)\n", s, s - 1, (int)level[s - 1].size());
+        fprintf(f, "logic                  s%d_leaf;\n", s);
+        fprintf(f, "logic [1:0]            s%d_action;\n", s);
+        fprintf(f, "logic [ADDR_WIDTH-1:0] s%d_next;\n", s);
+        fprintf(f, "logic [PAYLOAD_ADDR_WIDTH-1:0] s%d_slot;\n\n", s);
+        fprintf(f, "always_comb begin\n");
+        fprintf(f, "    s%d_leaf   = 1'b0;\n", s);
+        fprintf(f, "    s%d_action = 2'd0;\n", s);
+        fprintf(f, "    s%d_next   = '0;\n", s);
+        fprintf(f, "    s%d_slot   = '0;\n", s);
+        fprintf(f, "    case (pipe_node_idx[%d])\n", s - 1);
+        for (int idx : level[s - 1]) {
+            const Node &n = tree[idx];
+            if (n.is_leaf) {
+                fprintf(f, "        %d'd%d: begin s%d_leaf = 1'b1; s%d_action = 2'd%d; s%d_slot = PAYLOAD_ADDR_WIDTH'(%d); end\n",
+                        addr_width, idx, s, s, n.action, s, n.threshold);
+            } else if (!is_inline_leaf(n.left_idx) && !is_inline_leaf(n.right_idx)) {
+                fprintf(f, "        %d'd%d: s%d_next = (pipe_input[%d] %c 8'd%d) ? %d'd%d : %d'd%d;\n",
+                        addr_width, idx, s, s - 1, n.less_than ? '<' : '>', n.threshold,
+                        addr_width, n.left_idx, addr_width, n.right_idx);
+            } else {
+                // Inline leaf child(ren): the branch resolves in this stage.
+                uint8_t child[2] = {n.left_idx, n.right_idx};
+                char arm[2][128];
+                for (int k = 0; k < 2; k++) {
+                    if (is_inline_leaf(child[k]))
+                        snprintf(arm[k], sizeof(arm[k]),
+                                 "begin s%d_leaf = 1'b1; s%d_action = 2'd%d; s%d_slot = PAYLOAD_ADDR_WIDTH'(%d); end",
+                                 s, s, child[k] & 3, s, child[k] & 3);
+                    else
+                        snprintf(arm[k], sizeof(arm[k]), "s%d_next = %d'd%d;", s, addr_width, child[k]);
+                }
+                fprintf(f, "        %d'd%d: if (pipe_input[%d] %c 8'd%d) %s\n",
+                        addr_width, idx, s - 1, n.less_than ? '<' : '>', n.threshold, arm[0]);
+                fprintf(f, "               else %s\n", arm[1]);
+            }
+        }
+        fprintf(f, "        default: ;\n");
+        fprintf(f, "    endcase\n");
+        fprintf(f, "end\n\n");
+
+        fprintf(f, "always_ff @(posedge clk or posedge rst) begin\n");
+        fprintf(f, "    if (rst) begin\n");
+        fprintf(f, "        pipe_valid[%d]    <= 1'b0;\n", s);
+        fprintf(f, "        pipe_resolved[%d] <= 1'b0;\n", s);
+        fprintf(f, "        pipe_node_idx[%d] <= '0;\n", s);
+        fprintf(f, "        pipe_input[%d]    <= '0;\n", s);
+        fprintf(f, "        pipe_result[%d]   <= '0;\n", s);
+        fprintf(f, "        pipe_slot[%d]     <= '0;\n", s);
+        fprintf(f, "    end else begin\n");
+        fprintf(f, "        pipe_valid[%d]    <= pipe_valid[%d];\n", s, s - 1);
+        fprintf(f, "        pipe_input[%d]    <= pipe_input[%d];\n", s, s - 1);
+        fprintf(f, "        if (!pipe_valid[%d]) begin\n", s - 1);
+        fprintf(f, "            pipe_resolved[%d] <= 1'b0;\n", s);
+        fprintf(f, "            pipe_node_idx[%d] <= '0;\n", s);
+        fprintf(f, "            pipe_result[%d]   <= '0;\n", s);
+        fprintf(f, "            pipe_slot[%d]     <= '0;\n", s);
+        fprintf(f, "        end else if (pipe_resolved[%d]) begin\n", s - 1);
+        fprintf(f, "            pipe_resolved[%d] <= 1'b1;\n", s);
+        fprintf(f, "            pipe_node_idx[%d] <= pipe_node_idx[%d];\n", s, s - 1);
+        fprintf(f, "            pipe_result[%d]   <= pipe_result[%d];\n", s, s - 1);
+        fprintf(f, "            pipe_slot[%d]     <= pipe_slot[%d];\n", s, s - 1);
+        fprintf(f, "        end else if (s%d_leaf) begin\n", s);
+        fprintf(f, "            pipe_resolved[%d] <= 1'b1;\n", s);
+        fprintf(f, "            pipe_node_idx[%d] <= pipe_node_idx[%d];\n", s, s - 1);
+        fprintf(f, "            pipe_result[%d]   <= s%d_action;\n", s, s);
+        fprintf(f, "            pipe_slot[%d]     <= s%d_slot;\n", s, s);
+        fprintf(f, "        end else begin\n");
+        fprintf(f, "            pipe_resolved[%d] <= 1'b0;\n", s);
+        fprintf(f, "            pipe_node_idx[%d] <= s%d_next;\n", s, s);
+        fprintf(f, "            pipe_result[%d]   <= '0;\n", s);
+        fprintf(f, "            pipe_slot[%d]     <= '0;\n", s);
+        fprintf(f, "        end\n");
+        fprintf(f, "    end\n");
+        fprintf(f, "end\n\n");
+    }
+
+    fprintf(f, "// Output register\n");
+    fprintf(f, "always_ff @(posedge clk or posedge rst) begin\n");
+    fprintf(f, "    if (rst) begin\n");
+    fprintf(f, "        action       <= '0;\n");
+    fprintf(f, "        action_valid <= 1'b0;\n");
+    fprintf(f, "        payload      <= '0;\n");
+    fprintf(f, "    end else begin\n");
+    fprintf(f, "        action_valid <= pipe_valid[MAX_DEPTH] & pipe_resolved[MAX_DEPTH];\n");
+    fprintf(f, "        action       <= pipe_result[MAX_DEPTH];\n");
+    fprintf(f, "        payload      <= payload_mem[pipe_slot[MAX_DEPTH]];\n");
+    fprintf(f, "    end\n");
+    fprintf(f, "end\n\n");
+    fprintf(f, "endmodule\n");
+
+    fclose(f);
+
+    printf("%s: %d nodes, depth %d -> %s (module %s, MAX_DEPTH=%d)\n",
+           argv[1], (int)tree.size(), depth, argv[2], module, max_depth);
+    return 0;
+}
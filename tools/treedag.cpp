@@ -0,0 +1,84 @@
+// =========================================================================
+// treedag — share identical subtrees, compiling a model into a node DAG
+// =========================================================================
+//
+// Usage:
+//   treedag [-a] <model.tree> [out.tree]
+//
+//   -a   actions only: leaves with the same action are shared whatever
+//        their payload slot (for engines without payload RAM)
+//
+// Runs dedup_tree() (sim/tree_model.h): identical leaves and subtrees are
+// stored once and pointed to from every place they occur, and splits whose
+// two sides are identical are dropped.  Every engine follows child
+// pointers as written, so the output loads like any other model, into
+// fewer nodes and fewer sw_we write cycles.
+//
+// The result is checked against the input on all 256 inputs: same action,
+// same payload slot (unless -a) and same inline-leaf flag, and no path
+// longer than before.  Any difference is an error and nothing is written.
+// =========================================================================
+
+#include "../sim/tree_model.h"
+
+int main(int argc, char **argv) {
+    bool keep_slots = true;
+    std::vector<const char *> pos;
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "-a") keep_slots = false;
+        else pos.push_back(argv[i]);
+    }
+    if (pos.size() < 1 || pos.size() > 2) {
+        fprintf(stderr, "usage: %s [-a] <model.tree> [out.tree]\n", argv[0]);
+        return 2;
+    }
+
+    std::vector<Node> tree;
+    if (!read_tree_file(pos[0], tree)) return 1;
+
+    int depth = tree_depth(tree);
+    std::vector<Node> dag = dedup_tree(tree, keep_slots);
+    if (depth < 0 || dag.empty()) {
+        fprintf(stderr, "error: malformed tree (cycle or out-of-range child)\n");
+        return 1;
+    }
+
+    int mismatches = 0;
+    for (int inp = 0; inp < 256; inp++) {
+        SimResult a = simulate_tree(tree, (uint8_t)inp);
+        SimResult b = simulate_tree(dag, (uint8_t)inp);
+        if (!b.valid || a.action != b.action || a.inline_leaf != b.inline_leaf
+            || b.depth > a.depth || (keep_slots && a.slot != b.slot)) {
+            if (mismatches++ < 8)
+                fprintf(stderr, "  input %3d: %s slot %d depth %d  ->  %s slot %d depth %d\n",
+                        inp, action_name(a.action), a.slot, a.depth,
+                        action_name(b.action), b.slot, b.depth);
+        }
+    }
+    if (mismatches) {
+        fprintf(stderr, "error: %d / 256 inputs disagree after sharing\n", mismatches);
+        return 1;
+    }
+
+    int leaves = 0, shared = 0;
+    std::vector<int> refs(dag.size(), 0);
+    for (const Node &n : dag) {
+        if (n.is_leaf) { leaves++; continue; }
+        for (uint8_t c : {n.left_idx, n.right_idx})
+            if (!is_inline_leaf(c) && c < dag.size()) refs[c]++;
+    }
+    for (int r : refs) shared += r > 1;
+
+    printf("tree: %3d nodes, depth %d, %d stages  ->  %d write cycles\n",
+           (int)tree.size(), depth, tree_stages(tree), (int)tree.size());
+    printf("dag:  %3d nodes, depth %d, %d stages  ->  %d write cycles"
+           " (%d leaves, %d nodes shared)\n",
+           (int)dag.size(), tree_depth(dag), tree_stages(dag), (int)dag.size(), leaves, shared);
+    printf("all 256 inputs match (action%s, inline flag, no longer path)\n",
+           keep_slots ? ", payload slot" : "");
+    if ((int)dag.size() > 64)
+        printf("warning: %d nodes do not fit MAX_NODES = 64\n", (int)dag.size());
+
+    if (pos.size() == 2 && !write_tree_file(pos[1], dag)) return 1;
+    return 0;
+}
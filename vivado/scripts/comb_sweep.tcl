@@ -0,0 +1,79 @@
+# =============================================================================
+# Vivado Register-Cut Sweep Script (Non-Project Mode)
+# =============================================================================
+# Usage:
+#   make comb-sweep
+#   vivado -mode batch -source vivado/scripts/comb_sweep.tcl
+#
+# Places and routes decision_tree_comb out of context for each CUT_EVERY
+# setting (MAX_DEPTH = 6) and turns the routed Fmax into latency in ns.
+# A query is captured on one edge and its result registered CUTS + 1 edges
+# later, so:
+#
+#   latency (ns) = (CUTS + 1) * 1000 / Fmax,   CUTS = MAX_DEPTH / CUT_EVERY
+#
+# Routed rather than post-synthesis timing: with several LUTRAM reads per
+# segment most of the path is routing, which synthesis only estimates.
+# The setting with the lowest latency is printed at the end.
+#
+# Results: vivado/output/comb/summary.csv (+ per-setting timing reports)
+# =============================================================================
+
+# ---- Configuration ----
+set PART        "xc7a35ticsg324-1L"
+set RTL_DIR     "rtl"
+set XDC_DIR     "vivado/constraints"
+set OUT_DIR     "vivado/output/comb"
+set PERIOD_NS   10.0
+set MAX_DEPTH   6
+set CUT_EVERY   {0 1 2 3 4}
+
+# ---- Setup output directory ----
+file mkdir $OUT_DIR
+set csv [open $OUT_DIR/summary.csv w]
+puts $csv "cut_every,cuts,cycles,wns_ns,fmax_mhz,latency_ns,luts,ffs"
+
+set best_k  ""
+set best_ns 0
+
+foreach k $CUT_EVERY {
+    set cuts [expr {$k > 0 ? $MAX_DEPTH / $k : 0}]
+
+    puts "=== Implementing decision_tree_comb CUT_EVERY=$k ($cuts cuts) ==="
+    close_project -quiet
+    create_project -in_memory -part $PART
+    read_verilog -sv $RTL_DIR/decision_tree_comb.sv
+    read_xdc -mode out_of_context $XDC_DIR/timing.xdc
+    synth_design -top decision_tree_comb -part $PART -mode out_of_context \
+        -flatten_hierarchy rebuilt -generic MAX_DEPTH=$MAX_DEPTH -generic CUT_EVERY=$k
+    opt_design
+    place_design
+    route_design
+
+    set rpt [report_utilization -return_string]
+    report_timing_summary -file $OUT_DIR/cut${k}_timing_summary.rpt
+
+    set wns  [get_property SLACK [get_timing_paths -max_paths 1 -nworst 1 -setup]]
+    set fmax [format %.1f [expr {1000.0 / ($PERIOD_NS - $wns)}]]
+    set ns   [format %.2f [expr {($cuts + 1) * ($PERIOD_NS - $wns)}]]
+    set luts 0
+    set ffs  0
+    regexp {\|\s*Slice LUTs\*?\s*\|\s*(\d+)} $rpt -> luts
+    regexp {\|\s*Slice Registers\s*\|\s*(\d+)} $rpt -> ffs
+
+    if {$best_k eq "" || $ns < $best_ns} {
+        set best_k  $k
+        set best_ns $ns
+    }
+
+    puts $csv "$k,$cuts,[expr {$cuts + 2}],$wns,$fmax,$ns,$luts,$ffs"
+    puts [format "  CUT_EVERY=%d  cuts %d  Fmax %7s MHz  latency %7s ns  LUTs %5s  FFs %5s" \
+              $k $cuts $fmax $ns $luts $ffs]
+}
+
+close $csv
+
+puts ""
+puts "=== Register-cut sweep complete ==="
+puts "  Lowest latency: CUT_EVERY=$best_k ($best_ns ns)"
+puts "  Summary: $OUT_DIR/summary.csv"
@@ -0,0 +1,79 @@
+# =============================================================================
+# Vivado Farm Sweep Script (Non-Project Mode)
+# =============================================================================
+# Usage:
+#   make bench-farm     (simulated results/cycle → results_farm.csv)
+#   vivado -mode batch -source vivado/scripts/farm_sweep.tcl
+#
+# Synthesises decision_tree_farm for NUM_CORES = 1..8 against timing.xdc and
+# joins the LUT counts with the simulated throughput in results_farm.csv to
+# give LUTs per (result/cycle) — the area cost of each unit of throughput.
+#
+# Results: vivado/output/farm/summary.csv
+# =============================================================================
+
+# ---- Configuration ----
+set PART        "xc7a35ticsg324-1L"
+set RTL_DIR     "rtl"
+set XDC_DIR     "vivado/constraints"
+set OUT_DIR     "vivado/output/farm"
+set PERIOD_NS   10.0
+set CORES       {1 2 3 4 5 6 7 8}
+
+# ---- Simulated throughput (optional) ----
+array set rpc {}
+if {[file exists results_farm.csv]} {
+    set fh [open results_farm.csv r]
+    foreach line [split [read $fh] "\n"] {
+        set f [split $line ","]
+        if {[llength $f] >= 2 && [string is integer -strict [lindex $f 0]]} {
+            set rpc([lindex $f 0]) [lindex $f 1]
+        }
+    }
+    close $fh
+} else {
+    puts "=== results_farm.csv not found — run make bench-farm for LUTs/result ==="
+}
+
+# ---- Setup output directory ----
+file mkdir $OUT_DIR
+set csv [open $OUT_DIR/summary.csv w]
+puts $csv "cores,wns_ns,fmax_mhz,luts,ffs,results_per_cycle,luts_per_result"
+
+foreach m $CORES {
+    puts "=== Synthesising decision_tree_farm NUM_CORES=$m ==="
+    close_project -quiet
+    create_project -in_memory -part $PART
+    read_verilog -sv $RTL_DIR/decision_tree.sv
+    read_verilog -sv $RTL_DIR/decision_tree_farm.sv
+    read_xdc $XDC_DIR/timing.xdc
+    synth_design -top decision_tree_farm -part $PART -flatten_hierarchy rebuilt \
+        -generic NUM_CORES=$m
+
+    set rpt  [report_utilization -return_string]
+    report_utilization -file $OUT_DIR/farm${m}_utilization.rpt
+
+    set wns  [get_property SLACK [get_timing_paths -max_paths 1 -nworst 1 -setup]]
+    set fmax [format %.1f [expr {1000.0 / ($PERIOD_NS - $wns)}]]
+    set luts 0
+    set ffs  0
+    regexp {\|\s*Slice LUTs\*?\s*\|\s*(\d+)} $rpt -> luts
+    regexp {\|\s*Slice Registers\s*\|\s*(\d+)} $rpt -> ffs
+
+    set r   ""
+    set lpr ""
+    if {[info exists rpc($m)] && $rpc($m) > 0} {
+        set r   $rpc($m)
+        set lpr [format %.1f [expr {$luts / $rpc($m)}]]
+    }
+
+    puts $csv "$m,$wns,$fmax,$luts,$ffs,$r,$lpr"
+    puts [format "  M=%d  Fmax %7s MHz  LUTs %5s  FFs %5s  results/cycle %6s  LUTs/result %7s" \
+              $m $fmax $luts $ffs $r $lpr]
+}
+
+close $csv
+
+puts ""
+puts "=== Farm sweep complete ==="
+puts "  Summary: $OUT_DIR/summary.csv"
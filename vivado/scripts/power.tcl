@@ -0,0 +1,113 @@
+# =============================================================================
+# Vivado Activity-Based Power Script (Non-Project Mode)
+# =============================================================================
+# Usage:
+#   make bench-power    (replays a feed per engine → power_*.saif, power_runs.csv)
+#   vivado -mode batch -source vivado/scripts/power.tcl
+#
+# For every run in power_runs.csv (written by sim/test_power.cpp): synthesise
+# and place & route the same engine with the same generics out of context
+# (no IO buffers, so pad power does not swamp the engine), annotate the
+# switching activity from the run's SAIF, and report_power.  Energy per
+# inference is the average power times the SAIF window over the number of
+# inferences in it:
+#
+#   nJ / inference = P (W) * window (ns) / inferences
+#
+# reported for total on-chip power and for the dynamic part alone (static
+# power is the same for every engine on a given part and temperature).
+#
+# Results: vivado/output/power/summary.csv (+ per-run power reports)
+# =============================================================================
+
+# ---- Configuration ----
+set PART        "xc7a35ticsg324-1L"
+set RTL_DIR     "rtl"
+set XDC_DIR     "vivado/constraints"
+set OUT_DIR     "vivado/output/power"
+set RUNS_CSV    "power_runs.csv"
+
+# Sources per engine (tag in power_runs.csv column 2)
+array set SOURCES [list \
+    orig   [list $RTL_DIR/decision_tree.sv] \
+    pipe   [list $RTL_DIR/decision_tree_pipelined.sv] \
+    farm   [list $RTL_DIR/decision_tree.sv $RTL_DIR/decision_tree_farm.sv] \
+    cached [list $RTL_DIR/decision_tree_pipelined.sv $RTL_DIR/result_cache.sv \
+                 $RTL_DIR/decision_tree_cached.sv] \
+]
+
+if {![file exists $RUNS_CSV]} {
+    puts "=== $RUNS_CSV not found — run make bench-power first ==="
+    exit 1
+}
+
+proc power_value {rpt label} {
+    if {[regexp "\\|\\s*$label\\s*\\|\\s*(\[0-9.\]+)" $rpt -> w]} {
+        return $w
+    }
+    return 0
+}
+
+# ---- Setup output directory ----
+file mkdir $OUT_DIR
+set csv [open $OUT_DIR/summary.csv w]
+puts $csv "tag,engine,params,cycles,inferences,total_w,dynamic_w,static_w,nj_per_inference,dynamic_nj_per_inference"
+
+set fh [open $RUNS_CSV r]
+set lines [split [read $fh] "\n"]
+close $fh
+
+foreach line $lines {
+    set f [split $line ","]
+    if {[llength $f] < 8 || [lindex $f 0] eq "tag"} { continue }
+    lassign $f tag engine top params saif cycles inferences window_ns
+
+    if {![info exists SOURCES($engine)] || ![file exists $saif]} {
+        puts "=== Skipping $tag: unknown engine or $saif missing ==="
+        continue
+    }
+
+    puts "=== $tag: synthesising $top ($params) ==="
+    close_project -quiet
+    create_project -in_memory -part $PART
+    foreach src $SOURCES($engine) {
+        read_verilog -sv $src
+    }
+    read_xdc -mode out_of_context $XDC_DIR/timing.xdc
+
+    set gen_args {}
+    foreach g $params {
+        lappend gen_args -generic $g
+    }
+    synth_design -top $top -part $PART -mode out_of_context -flatten_hierarchy rebuilt {*}$gen_args
+    opt_design
+    place_design
+    route_design
+
+    # Verilator names the top scope TOP.<module>
+    read_saif -strip_path TOP/$top $saif
+    set rpt [report_power -return_string]
+    report_power -file $OUT_DIR/${tag}_power.rpt
+
+    set total   [power_value $rpt {Total On-Chip Power \(W\)}]
+    set dynamic [power_value $rpt {Dynamic \(W\)}]
+    set static  [power_value $rpt {Device Static \(W\)}]
+
+    set nj  ""
+    set dnj ""
+    if {$inferences > 0} {
+        set nj  [format %.4f [expr {$total   * $window_ns / $inferences}]]
+        set dnj [format %.4f [expr {$dynamic * $window_ns / $inferences}]]
+    }
+
+    puts $csv "$tag,$engine,$params,$cycles,$inferences,$total,$dynamic,$static,$nj,$dnj"
+    puts [format "  %-16s total %6s W  dynamic %6s W  %8s nJ/inference  (%s dynamic)" \
+              $tag $total $dynamic $nj $dnj]
+}
+
+close $csv
+
+puts ""
+puts "=== Power estimation complete ==="
+puts "  Summary: $OUT_DIR/summary.csv"
+puts "  Reports: $OUT_DIR/*_power.rpt"
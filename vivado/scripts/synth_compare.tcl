@@ -0,0 +1,96 @@
+# =============================================================================
+# Vivado Synthesis Comparison Script (Non-Project Mode)
+# =============================================================================
+# Usage:
+#   make fixed-sv        (generates build/fixed/decision_tree_fixed.sv)
+#   vivado -mode batch -source vivado/scripts/synth_compare.tcl
+#
+# Synthesises each engine standalone against timing.xdc (10 ns) and
+# tabulates estimated Fmax and resource usage.  Fmax is derived from the
+# worst setup slack: Fmax = 1000 / (period - WNS).
+#
+# Results: vivado/output/compare/summary.csv (+ per-design reports)
+# =============================================================================
+
+# ---- Configuration ----
+set PART        "xc7a35ticsg324-1L"
+set RTL_DIR     "rtl"
+set XDC_DIR     "vivado/constraints"
+set OUT_DIR     "vivado/output/compare"
+set PERIOD_NS   10.0
+
+# ---- Designs to compare ----
+# Each entry: { label  top_module  {source files}  {generic list} }
+set DESIGNS [list \
+    [list fsm        decision_tree           [list $RTL_DIR/decision_tree.sv]           {}] \
+    [list pipelined  decision_tree_pipelined [list $RTL_DIR/decision_tree_pipelined.sv] {}] \
+    [list pipe_nogate decision_tree_pipelined [list $RTL_DIR/decision_tree_pipelined.sv] {ACTIVITY_GATING=0}] \
+    [list fixed      decision_tree_fixed     [list build/fixed/decision_tree_fixed.sv]  {}] \
+    [list quad       decision_tree_quad      [list $RTL_DIR/decision_tree_quad.sv]      {}] \
+    [list implicit   decision_tree_implicit  [list $RTL_DIR/decision_tree_implicit.sv]  {}] \
+    [list mask       decision_tree_mask      [list $RTL_DIR/decision_tree_mask.sv]      {MAX_DEPTH=3}] \
+    [list mask_c32   decision_tree_mask      [list $RTL_DIR/decision_tree_mask.sv]      {MAX_DEPTH=3 MASK_BITS=32}] \
+    [list jump       decision_tree_jump      [list $RTL_DIR/decision_tree_jump.sv]      {}] \
+    [list jump_d64   decision_tree_jump      [list $RTL_DIR/decision_tree_jump.sv]      {MAX_DEPTH=64}] \
+    [list jump_n32   decision_tree_jump      [list $RTL_DIR/decision_tree_jump.sv]      {MAX_NODES=32}] \
+]
+
+# ---- Setup output directory ----
+file mkdir $OUT_DIR
+set csv [open $OUT_DIR/summary.csv w]
+puts $csv "design,wns_ns,fmax_mhz,luts,lutram,ffs"
+
+proc util_count {rpt pattern} {
+    if {[regexp "\\|\\s*$pattern\\s*\\|\\s*(\\d+)" $rpt -> n]} {
+        return $n
+    }
+    return 0
+}
+
+foreach d $DESIGNS {
+    lassign $d label top files generics
+
+    set missing 0
+    foreach src $files {
+        if {![file exists $src]} {
+            puts "=== Skipping $label: $src not found ==="
+            set missing 1
+        }
+    }
+    if {$missing} { continue }
+
+    puts "=== Synthesising $label ($top) ==="
+    close_project -quiet
+    create_project -in_memory -part $PART
+    foreach src $files {
+        read_verilog -sv $src
+    }
+    read_xdc $XDC_DIR/timing.xdc
+
+    set gen_args {}
+    foreach g $generics {
+        lappend gen_args -generic $g
+    }
+    synth_design -top $top -part $PART -flatten_hierarchy rebuilt {*}$gen_args
+
+    set rpt [report_utilization -return_string]
+    report_utilization     -file $OUT_DIR/${label}_utilization.rpt
+    report_timing_summary  -file $OUT_DIR/${label}_timing_summary.rpt
+
+    set wns    [get_property SLACK [get_timing_paths -max_paths 1 -nworst 1 -setup]]
+    set fmax   [format %.1f [expr {1000.0 / ($PERIOD_NS - $wns)}]]
+    set luts   [util_count $rpt {Slice LUTs\*?}]
+    set lutram [util_count $rpt {LUT as Memory}]
+    set ffs    [util_count $rpt {Slice Registers}]
+
+    puts $csv "$label,$wns,$fmax,$luts,$lutram,$ffs"
+    puts [format "  %-12s WNS %7s ns  Fmax %7s MHz  LUTs %5s  LUTRAM %5s  FFs %5s" \
+              $label $wns $fmax $luts $lutram $ffs]
+}
+
+close $csv
+
+puts ""
+puts "=== Comparison complete ==="
+puts "  Summary: $OUT_DIR/summary.csv"
+puts "  Reports: $OUT_DIR/*.rpt"
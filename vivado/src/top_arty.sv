@@ -110,6 +110,8 @@ module top_arty (
         .start            (start),
         .action           (action),
         .action_valid     (action_valid),
+        .action_error     (),
+        .error_count      (),
         .sw_we            (sw_we),
         .sw_addr          (sw_addr),
         .sw_data_is_leaf  (sw_data_is_leaf),